@@ -484,6 +484,34 @@ void ColumnString::getPermutationWithCollationImpl(
     }
 }
 
+MutableColumnPtr ColumnString::materializeSortKeys(const TiDB::ITiDBCollator & collator) const
+{
+    auto res = ColumnString::create();
+    const size_t rows = size();
+    auto & res_offsets = res->getOffsets();
+    auto & res_chars = res->getChars();
+    res_offsets.resize(rows);
+    // Most of the sort keys are no longer than the original strings multiplied by the reserved multiplier,
+    // ASCII strings under general_ci take exactly 2 bytes per char.
+    res_chars.reserve(chars.size() * std::min<size_t>(collator.sortKeyReservedSpaceMultipler(), 2));
+
+    std::string sort_key_container;
+    size_t res_offset = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        auto sort_key = collator.sortKeyFastPath(
+            reinterpret_cast<const char *>(&chars[offsetAt(i)]),
+            sizeAt(i) - 1, // Skip last zero byte.
+            sort_key_container);
+        res_chars.resize(res_offset + sort_key.size + 1);
+        inline_memcpy(&res_chars[res_offset], sort_key.data, sort_key.size);
+        res_offset += sort_key.size;
+        res_chars[res_offset++] = 0;
+        res_offsets[i] = res_offset;
+    }
+    return res;
+}
+
 void ColumnString::countSerializeByteSize(PaddedPODArray<size_t> & byte_size) const
 {
     countSerializeByteSizeImpl</*need_decode_collator=*/false, /*has_nullmap=*/false>(byte_size, nullptr, nullptr);
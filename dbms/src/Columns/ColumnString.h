@@ -430,6 +430,12 @@ public:
         size_t limit,
         Permutation & res) const;
 
+    /// Materialize the sort keys of all the strings under `collator` into a new ColumnString.
+    /// Comparing the sort keys in binary is equivalent to comparing the original strings with `collator`,
+    /// so the sort keys can be computed once and then used by sorting or hashing within one stage instead
+    /// of re-computing the weights of each row for every comparison.
+    MutableColumnPtr materializeSortKeys(const TiDB::ITiDBCollator & collator) const;
+
     ColumnPtr replicateRange(size_t start_row, size_t end_row, const IColumn::Offsets & replicate_offsets)
         const override;
 
@@ -27,14 +27,18 @@
 #include <Common/Logger.h>
 #include <Common/setThreadName.h>
 #include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
 #include <Poco/Util/LayeredConfiguration.h>
 #include <boost_wrapper/string.h>
 #include <common/logger_useful.h>
 #include <errno.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <map>
 namespace DB
 {
 namespace ErrorCodes
@@ -62,6 +66,10 @@ CPUAffinityConfig CPUAffinityManager::readConfig(Poco::Util::LayeredConfiguratio
         {
             cpu_config.query_cpu_percent = *query_cpu_pct;
         }
+        if (auto numa_aware = table->get_qualified_as<bool>("numa_aware"); numa_aware)
+        {
+            cpu_config.numa_aware = *numa_aware;
+        }
     }
     return cpu_config;
 }
@@ -75,6 +83,7 @@ CPUAffinityManager & CPUAffinityManager::getInstance()
 CPUAffinityManager::CPUAffinityManager()
     : query_cpu_percent(0)
     , cpu_cores(0)
+    , numa_aware(false)
     , log(Logger::get())
 {}
 
@@ -84,12 +93,115 @@ void CPUAffinityManager::init(const CPUAffinityConfig & config)
     query_cpu_percent = config.query_cpu_percent;
     cpu_cores = config.cpu_cores;
     query_threads = config.query_threads;
+    numa_aware = config.numa_aware;
     CPU_ZERO(&query_cpu_set);
     CPU_ZERO(&other_cpu_set);
     if (enable())
     {
         initCPUSet();
     }
+    initNUMANodes();
+}
+
+void CPUAffinityManager::initNUMANodes()
+{
+    numa_nodes.clear();
+    const std::string node_dir = "/sys/devices/system/node";
+    if (!numa_aware || !Poco::File(node_dir).exists())
+        return;
+
+    std::map<int, cpu_set_t> nodes;
+    Poco::DirectoryIterator end;
+    for (Poco::DirectoryIterator iter(node_dir); iter != end; ++iter)
+    {
+        // node0, node1, ...
+        const auto & name = iter.name();
+        if (!boost::algorithm::starts_with(name, "node") || name.size() == 4
+            || !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+            continue;
+
+        std::string cpu_list;
+        std::ifstream ifs(iter->path() + "/cpulist");
+        std::getline(ifs, cpu_list);
+        cpu_set_t cpu_set;
+        if (ifs.fail() || !parseCPUList(cpu_list, cpu_set))
+        {
+            LOG_WARNING(log, "Failed to read the cpu list of NUMA {}, ignore it", name);
+            continue;
+        }
+        // Only the query cpus are used by the query threads.
+        if (enable())
+            CPU_AND(&cpu_set, &cpu_set, &query_cpu_set);
+        // Nodes without cpus only have memory.
+        if (CPU_COUNT(&cpu_set) > 0)
+            nodes.emplace(std::stoi(name.substr(4)), cpu_set);
+    }
+
+    if (nodes.size() <= 1)
+    {
+        LOG_INFO(log, "NUMA awareness is not enabled because there are only {} NUMA nodes", nodes.size());
+        return;
+    }
+    for (const auto & [id, cpu_set] : nodes)
+    {
+        LOG_INFO(log, "NUMA node {} query cpus: {}", id, cpuSetToString(cpu_set));
+        numa_nodes.push_back(NUMANode{id, cpu_set});
+    }
+}
+
+bool CPUAffinityManager::parseCPUList(const std::string & cpu_list, cpu_set_t & cpu_set)
+{
+    CPU_ZERO(&cpu_set);
+    std::vector<std::string> ranges;
+    boost::split(ranges, cpu_list, boost::is_any_of(","));
+    for (auto & range : ranges)
+    {
+        boost::trim(range);
+        if (range.empty())
+            continue;
+        int first = 0;
+        int last = 0;
+        try
+        {
+            auto pos = range.find('-');
+            first = std::stoi(range.substr(0, pos));
+            last = pos == std::string::npos ? first : std::stoi(range.substr(pos + 1));
+        }
+        catch (std::exception &)
+        {
+            return false;
+        }
+        if (first < 0 || last < first || last >= CPU_SETSIZE)
+            return false;
+        for (int cpu = first; cpu <= last; ++cpu)
+            CPU_SET(cpu, &cpu_set);
+    }
+    return true;
+}
+
+size_t CPUAffinityManager::getNUMANodeCount() const
+{
+    return std::max<size_t>(numa_nodes.size(), 1);
+}
+
+void CPUAffinityManager::bindSelfQueryThreadToNUMANode(size_t node)
+{
+    if (node >= numa_nodes.size())
+    {
+        bindSelfQueryThread();
+        return;
+    }
+    LOG_INFO(log, "Thread: {} bind to NUMA node {}.", ::getThreadName(), numa_nodes[node].id);
+    // If tid is zero, then the calling thread is used.
+    setAffinity(0, numa_nodes[node].cpu_set);
+    std::lock_guard lock(numa_bound_threads_mu);
+    numa_bound_threads.insert(static_cast<pid_t>(syscall(SYS_gettid)));
+}
+
+bool CPUAffinityManager::isNUMABoundThread(pid_t tid) const
+{
+    std::lock_guard lock(numa_bound_threads_mu);
+    return numa_bound_threads.contains(tid);
 }
 
 bool CPUAffinityManager::isQueryThread(const std::string & name) const
@@ -155,7 +267,7 @@ std::string CPUAffinityManager::toString() const
     // clang-format off
     return "enable " + std::to_string(enable()) + " query_cpu_percent " + std::to_string(query_cpu_percent) +
         " cpu_cores " + std::to_string(cpu_cores) + " query_cpu_set " + cpuSetToString(query_cpu_set) +
-        " other_cpu_set " + cpuSetToString(other_cpu_set);
+        " other_cpu_set " + cpuSetToString(other_cpu_set) + " numa_nodes " + std::to_string(numa_nodes.size());
     // clang-format on
 }
 
@@ -298,6 +410,10 @@ void CPUAffinityManager::bindThreadCPUAffinity() const
     auto threads = getThreads(getpid());
     for (const auto & t : threads)
     {
+        if (isNUMABoundThread(t.first))
+        {
+            continue;
+        }
         if (isQueryThread(t.second))
         {
             LOG_INFO(log, "Thread: {} {} bindQueryThread.", t.first, t.second);
@@ -327,6 +443,10 @@ void CPUAffinityManager::checkThreadCPUAffinity() const
             continue;
         }
         LOG_INFO(log, "Thread: {} {} bind on CPU: {}", t.first, t.second, cpuSetToString(cpu_set));
+        if (isNUMABoundThread(t.first))
+        {
+            continue;
+        }
         if (isQueryThread(t.second) && !CPU_EQUAL(&cpu_set, &query_cpu_set))
         {
             LOG_ERROR(log, "Thread: {} {} is query thread and bind CPU info is error.", t.first, t.second);
@@ -18,9 +18,11 @@
 #include <common/defines.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Poco
@@ -38,6 +40,7 @@ using LoggerPtr = std::shared_ptr<Logger>;
 namespace tests
 {
 class CPUAffinityManagerTest_CPUAffinityManager_Test;
+class CPUAffinityManagerTest_parseCPUList_Test;
 } // namespace tests
 
 struct CPUAffinityConfig
@@ -53,6 +56,11 @@ struct CPUAffinityConfig
     // grpcpp_sync_ser is the thread name of grpc sync request thread-pool. However, this thread-pool is resize dynamically and we set these threads' cpu affinity in FlashService for simplicity.
     // Query threads of MPP tasks are created dynamiccally and we set these threads' cpu affinity when they are created.
     std::vector<std::string> query_threads = {"grpcpp_sync_ser"};
+    // Split the query cpu set by NUMA nodes, so that the pipeline task thread pool can bind its threads to
+    // the nodes and keep the tasks of a query on one node.
+    // It requires the setting `pipeline_cpu_task_thread_pool_queue_type` to be MLFQ or FAIR, otherwise the
+    // task scheduler fails to start on a machine with multiple NUMA nodes.
+    bool numa_aware = false;
 };
 
 // CPUAffinityManager is a singleton.
@@ -78,6 +86,12 @@ public:
     void bindSelfOtherThread() const;
     void bindSelfGrpcThread() const;
 
+    // The number of NUMA nodes that query threads can be bound to, returns 1 if NUMA awareness is disabled
+    // or the machine only has one node.
+    size_t getNUMANodeCount() const;
+    // Bind the calling thread to the query cpus of the `node`-th NUMA node.
+    void bindSelfQueryThreadToNUMANode(size_t node);
+
     std::string toString() const;
 
     void bindThreadCPUAffinity() const;
@@ -91,6 +105,9 @@ public:
     void bindSelfOtherThread() const {}
     void bindSelfGrpcThread() const {}
 
+    static size_t getNUMANodeCount() { return 1; }
+    void bindSelfQueryThreadToNUMANode(size_t) {}
+
     static std::string toString() { return "Not Support"; }
 
     void bindThreadCPUAffinity() const {}
@@ -100,8 +117,13 @@ private:
 #ifdef __linux__
     // for unittest
     friend class DB::tests::CPUAffinityManagerTest_CPUAffinityManager_Test;
+    friend class DB::tests::CPUAffinityManagerTest_parseCPUList_Test;
 
     void initCPUSet();
+    void initNUMANodes();
+    // Parse the cpu list format of sysfs, such as "0-3,8-11".
+    static bool parseCPUList(const std::string & cpu_list, cpu_set_t & cpu_set);
+    bool isNUMABoundThread(pid_t tid) const;
     int getCPUCores() const;
     int getQueryCPUCores() const;
     int getOtherCPUCores() const;
@@ -123,11 +145,23 @@ private:
 
     cpu_set_t query_cpu_set{};
     cpu_set_t other_cpu_set{};
+
+    struct NUMANode
+    {
+        int id;
+        cpu_set_t cpu_set;
+    };
+    std::vector<NUMANode> numa_nodes;
+
+    // The threads bound to NUMA nodes are skipped by `bindThreadCPUAffinity`.
+    mutable std::mutex numa_bound_threads_mu;
+    std::unordered_set<pid_t> numa_bound_threads;
 #endif
 
     // unused except Linux
     MAYBE_UNUSED_MEMBER int query_cpu_percent;
     MAYBE_UNUSED_MEMBER int cpu_cores;
+    MAYBE_UNUSED_MEMBER bool numa_aware;
 
     std::vector<std::string> query_threads;
     LoggerPtr log;
@@ -58,6 +58,8 @@ namespace DB
     M(force_legacy_or_checkpoint_page_file_exists)                \
     M(exception_in_creating_set_input_stream)                     \
     M(exception_when_read_from_log)                               \
+    M(exception_when_decode_wal_edit)                             \
+    M(exception_when_apply_wal_edit)                              \
     M(exception_mpp_hash_build)                                   \
     M(exception_mpp_hash_probe)                                   \
     M(exception_before_drop_segment)                              \
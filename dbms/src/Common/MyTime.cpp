@@ -1557,6 +1557,32 @@ void convertTimeZoneByOffset(UInt64 from_time, UInt64 & to_time, bool from_utc,
     convertTimeZoneImpl(from_time, to_time, time_zone_utc, time_zone_utc, from_utc, offset, throw_exception);
 }
 
+bool tryConvertTimeZoneByOffsetWithinDay(UInt64 from_time, UInt64 & to_time, bool from_utc, Int64 offset)
+{
+    const auto year = MyTimePacked::year(from_time);
+    const auto month = MyTimePacked::month(from_time);
+    const auto day = MyTimePacked::day(from_time);
+    const auto hour = MyTimePacked::hour(from_time);
+    // Dates close to the epoch need the bound check of the slow path, and invalid dates are normalized by the
+    // DateLUT there, so only handle the normal dates which are in range of the DateLUT here.
+    if (year <= 1970 || year >= DATE_LUT_MAX_YEAR || month == 0 || month > 12 || day == 0
+        || day > getLastDay(year, month) || hour >= 24)
+        return false;
+
+    const Int64 second_of_day = hour * MyTimeBase::SECOND_IN_ONE_HOUR
+        + MyTimePacked::minute(from_time) * MyTimeBase::SECOND_IN_ONE_MINUTE + MyTimePacked::second(from_time)
+        + (from_utc ? offset : -offset);
+    if (second_of_day < 0 || second_of_day >= MyTimeBase::SECOND_IN_ONE_DAY)
+        return false;
+
+    to_time = (from_time & ~MyTimePacked::HMS_MASK)
+        | MyTimePacked::packHMS(
+                  second_of_day / MyTimeBase::SECOND_IN_ONE_HOUR,
+                  second_of_day % MyTimeBase::SECOND_IN_ONE_HOUR / MyTimeBase::SECOND_IN_ONE_MINUTE,
+                  second_of_day % MyTimeBase::SECOND_IN_ONE_MINUTE);
+    return true;
+}
+
 MyDateTime convertUTC2TimeZone(time_t utc_ts, UInt32 micro_second, const DateLUTImpl & time_zone_to)
 {
     return MyDateTime(
@@ -2129,6 +2155,134 @@ MyDateTimeFormatter::MyDateTimeFormatter(const String & layout)
     }
 }
 
+std::optional<MyDateTimePackedFormatter> MyDateTimePackedFormatter::tryCreate(const String & layout)
+{
+    static constexpr UInt64 year_month_mask = ~((1ull << (MyTimePacked::YMD_OFFSET + MyTimePacked::DAY_BITS)) - 1);
+    static constexpr UInt64 day_mask = ((1ull << MyTimePacked::DAY_BITS) - 1) << MyTimePacked::YMD_OFFSET;
+    static constexpr UInt64 hour_mask = 31ull << (MyTimePacked::MICRO_SECOND_BITS + 12);
+    static constexpr UInt64 minute_mask = 63ull << (MyTimePacked::MICRO_SECOND_BITS + 6);
+    static constexpr UInt64 second_mask = 63ull << MyTimePacked::MICRO_SECOND_BITS;
+
+    MyDateTimePackedFormatter formatter;
+    auto add_part = [&](Part part, size_t width, UInt64 mask, char literal = 0) {
+        formatter.parts.emplace_back(part, literal);
+        formatter.result_length += width;
+        formatter.used_fields_mask |= mask;
+    };
+
+    bool in_pattern_match = false;
+    for (char x : layout)
+    {
+        if (!in_pattern_match)
+        {
+            if (x == '%')
+                in_pattern_match = true;
+            else
+                add_part(Part::Literal, 1, 0, x);
+            continue;
+        }
+
+        in_pattern_match = false;
+        switch (x)
+        {
+        case 'Y':
+            add_part(Part::Year4, 4, year_month_mask);
+            break;
+        case 'y':
+            add_part(Part::Year2, 2, year_month_mask);
+            break;
+        case 'm':
+            add_part(Part::Month, 2, year_month_mask);
+            break;
+        case 'd':
+            add_part(Part::Day, 2, day_mask);
+            break;
+        case 'H':
+            add_part(Part::Hour24, 2, hour_mask);
+            break;
+        case 'i':
+            add_part(Part::Minute, 2, minute_mask);
+            break;
+        case 'S':
+        case 's':
+            add_part(Part::Second, 2, second_mask);
+            break;
+        case 'f':
+            add_part(Part::MicroSecond, 6, MyTimePacked::MICRO_SECOND_MASK);
+            break;
+        case 'T':
+            add_part(Part::Hour24, 2, hour_mask);
+            add_part(Part::Literal, 1, 0, ':');
+            add_part(Part::Minute, 2, minute_mask);
+            add_part(Part::Literal, 1, 0, ':');
+            add_part(Part::Second, 2, second_mask);
+            break;
+        case '%':
+            add_part(Part::Literal, 1, 0, x);
+            break;
+        default:
+            // Variable-width or calendar-dependent specifiers, the 12-hour clock ones (%h %I %l %r) and the
+            // unknown ones that `MyDateTimeFormatter` prints as they are.
+            return std::nullopt;
+        }
+    }
+
+    formatter.last_result.resize(formatter.result_length);
+    return formatter;
+}
+
+void MyDateTimePackedFormatter::formatImpl(UInt64 packed, char * out) const
+{
+    auto write_2_digits = [&out](UInt32 v) {
+        out[0] = static_cast<char>('0' + v / 10 % 10);
+        out[1] = static_cast<char>('0' + v % 10);
+        out += 2;
+    };
+
+    for (const auto & [part, literal] : parts)
+    {
+        switch (part)
+        {
+        case Part::Literal:
+            *out++ = literal;
+            break;
+        case Part::Year4:
+        {
+            const auto year = MyTimePacked::year(packed);
+            write_2_digits(year / 100);
+            write_2_digits(year % 100);
+            break;
+        }
+        case Part::Year2:
+            write_2_digits(MyTimePacked::year(packed) % 100);
+            break;
+        case Part::Month:
+            write_2_digits(MyTimePacked::month(packed));
+            break;
+        case Part::Day:
+            write_2_digits(MyTimePacked::day(packed));
+            break;
+        case Part::Hour24:
+            write_2_digits(MyTimePacked::hour(packed));
+            break;
+        case Part::Minute:
+            write_2_digits(MyTimePacked::minute(packed));
+            break;
+        case Part::Second:
+            write_2_digits(MyTimePacked::second(packed));
+            break;
+        case Part::MicroSecond:
+        {
+            const auto micro_second = MyTimePacked::microSecond(packed);
+            write_2_digits(micro_second / 10000);
+            write_2_digits(micro_second % 10000 / 100);
+            write_2_digits(micro_second % 100);
+            break;
+        }
+        }
+    }
+}
+
 struct MyDateTimeParser::Context
 {
     // Some state for `mysqlTimeFix`
@@ -19,6 +19,9 @@
 #include <Interpreters/TimezoneInfo.h>
 #include <common/DateLUTImpl.h>
 
+#include <cstring>
+#include <optional>
+
 struct StringRef;
 namespace DB
 {
@@ -163,6 +166,109 @@ struct MyDate : public MyTimeBase
 
 bool numberToDateTime(Int64 number, MyDateTime & result, bool allowZeroDate = true);
 
+/// Accessors of the fields of a packed MyDate/MyDateTime (the layout produced by `MyTimeBase::toPackedUInt`).
+/// Unlike `MyTimeBase(UInt64 packed)` they only decode the required field and are branchless, so that the
+/// loops over a column of packed values can be vectorized by the compiler.
+struct MyTimePacked
+{
+    static constexpr UInt64 MICRO_SECOND_BITS = 24;
+    static constexpr UInt64 HMS_BITS = 17;
+    static constexpr UInt64 DAY_BITS = 5;
+
+    static constexpr UInt64 MICRO_SECOND_MASK = (1ull << MICRO_SECOND_BITS) - 1;
+    static constexpr UInt64 HMS_MASK = ((1ull << HMS_BITS) - 1) << MICRO_SECOND_BITS;
+    static constexpr UInt64 YMD_OFFSET = MICRO_SECOND_BITS + HMS_BITS;
+
+    ALWAYS_INLINE static inline UInt16 year(UInt64 packed)
+    {
+        return static_cast<UInt16>((packed >> (YMD_OFFSET + DAY_BITS)) / 13);
+    }
+    ALWAYS_INLINE static inline UInt8 month(UInt64 packed)
+    {
+        return static_cast<UInt8>((packed >> (YMD_OFFSET + DAY_BITS)) % 13);
+    }
+    ALWAYS_INLINE static inline UInt8 day(UInt64 packed)
+    {
+        return static_cast<UInt8>((packed >> YMD_OFFSET) & ((1 << DAY_BITS) - 1));
+    }
+    ALWAYS_INLINE static inline UInt8 hour(UInt64 packed)
+    {
+        return static_cast<UInt8>((packed >> (MICRO_SECOND_BITS + 12)) & 31);
+    }
+    ALWAYS_INLINE static inline UInt8 minute(UInt64 packed)
+    {
+        return static_cast<UInt8>((packed >> (MICRO_SECOND_BITS + 6)) & 63);
+    }
+    ALWAYS_INLINE static inline UInt8 second(UInt64 packed)
+    {
+        return static_cast<UInt8>((packed >> MICRO_SECOND_BITS) & 63);
+    }
+    ALWAYS_INLINE static inline UInt32 microSecond(UInt64 packed)
+    {
+        return static_cast<UInt32>(packed & MICRO_SECOND_MASK);
+    }
+
+    ALWAYS_INLINE static inline UInt64 packHMS(UInt64 hour, UInt64 minute, UInt64 second)
+    {
+        return ((hour << 12) | (minute << 6) | second) << MICRO_SECOND_BITS;
+    }
+};
+
+/// A formatter for `date_format` with a constant format that only contains fixed-width numeric specifiers
+/// (%Y %y %m %d %H %i %s %S %f %T) and literal characters. It writes the fields of the packed value
+/// directly into the output buffer, and remembers the last formatted value so that adjacent rows in the same
+/// time bucket (e.g. `DATE_FORMAT(ts, '%Y-%m-%d %H')` on time-ordered data) are copied instead of re-formatted.
+class MyDateTimePackedFormatter
+{
+public:
+    /// Returns nullopt if the layout is not supported, the caller should fall back to `MyDateTimeFormatter`.
+    static std::optional<MyDateTimePackedFormatter> tryCreate(const String & layout);
+
+    /// The length of every formatted result.
+    size_t length() const { return result_length; }
+
+    /// Write exactly `length()` bytes into `out`.
+    ALWAYS_INLINE inline void format(UInt64 packed, char * out)
+    {
+        const UInt64 masked = packed & used_fields_mask;
+        if (likely(has_last && masked == last_masked))
+        {
+            memcpy(out, last_result.data(), result_length);
+            return;
+        }
+        formatImpl(packed, out);
+        memcpy(last_result.data(), out, result_length);
+        last_masked = masked;
+        has_last = true;
+    }
+
+private:
+    enum class Part : UInt8
+    {
+        Literal,
+        Year4,
+        Year2,
+        Month,
+        Day,
+        Hour24,
+        Minute,
+        Second,
+        MicroSecond,
+    };
+
+    MyDateTimePackedFormatter() = default;
+
+    void formatImpl(UInt64 packed, char * out) const;
+
+    std::vector<std::pair<Part, char>> parts;
+    size_t result_length = 0;
+    UInt64 used_fields_mask = 0;
+
+    bool has_last = false;
+    UInt64 last_masked = 0;
+    String last_result;
+};
+
 struct MyDateTimeFormatter
 {
     std::vector<std::function<void(const MyTimeBase & datetime, String & result)>> formatters;
@@ -231,6 +337,11 @@ void convertTimeZoneByOffset(
     Int64 offset,
     bool throw_exception = false);
 
+/// Fast path of `convertTimeZoneByOffset` for the common case that the shifted time stays in the same day,
+/// which only rewrites the hour/minute/second bits of the packed value.
+/// Returns false if the result crosses the day boundary or the date needs the checks of the slow path.
+bool tryConvertTimeZoneByOffsetWithinDay(UInt64 from_time, UInt64 & to_time, bool from_utc, Int64 offset);
+
 MyDateTime convertUTC2TimeZone(time_t utc_ts, UInt32 micro_second, const DateLUTImpl & time_zone_to);
 
 MyDateTime convertUTC2TimeZoneByOffset(time_t utc_ts, UInt32 micro_second, Int64 offset);
@@ -0,0 +1,400 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/ShmRingBuffer.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ext/scope_guard.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <random>
+#include <thread>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int BAD_ARGUMENTS;
+extern const int CANNOT_ALLOCATE_MEMORY;
+extern const int CANNOT_OPEN_FILE;
+extern const int CANNOT_READ_ALL_DATA;
+extern const int CANNOT_TRUNCATE_FILE;
+extern const int QUERY_WAS_CANCELLED;
+extern const int TIMEOUT_EXCEEDED;
+} // namespace ErrorCodes
+
+namespace
+{
+constexpr UInt64 MAGIC = 0x544653484d524e47; // "TFSHMRNG"
+constexpr auto NAME_PREFIX = "/tiflash.";
+// The token is 128 random bits in hex.
+constexpr size_t TOKEN_SIZE = 32;
+// The data area starts at this offset of the segment.
+constexpr size_t DATA_OFFSET = 256;
+// Check the condition for several rounds before waiting on the futex, the peer is usually fast.
+constexpr size_t SPIN_ROUNDS = 64;
+// Check whether the peer process is alive at this interval when waiting.
+constexpr Int64 WAIT_TIMEOUT_NS = 100 * 1000 * 1000;
+
+void waitOnFutex(std::atomic<UInt32> & seq, UInt32 expected)
+{
+#ifdef __linux__
+    timespec timeout{0, WAIT_TIMEOUT_NS};
+    // Not FUTEX_WAIT_PRIVATE because the futex is shared between processes.
+    ::syscall(SYS_futex, reinterpret_cast<UInt32 *>(&seq), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+    if (seq.load() == expected)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+#endif
+}
+
+void wakeFutex([[maybe_unused]] std::atomic<UInt32> & seq)
+{
+#ifdef __linux__
+    ::syscall(SYS_futex, reinterpret_cast<UInt32 *>(&seq), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+bool isProcessAlive(Int32 pid)
+{
+    return pid == 0 || ::kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+String genToken()
+{
+    std::random_device rd;
+    return fmt::format("{:08x}{:08x}{:08x}{:08x}", rd(), rd(), rd(), rd());
+}
+} // namespace
+
+struct ShmRingBuffer::Header
+{
+    UInt64 magic = MAGIC;
+    UInt64 capacity = 0;
+    // Only the peer that gets the token from the consumer can open the segment.
+    char token[TOKEN_SIZE]{};
+
+    // Written by the producer.
+    alignas(64) std::atomic<UInt64> write_pos{0};
+    // Bumped after `write_pos` or the state of the producer changes, the consumer waits on it.
+    std::atomic<UInt32> write_seq{0};
+    std::atomic<Int32> producer_pid{0};
+    std::atomic<bool> write_finished{false};
+    std::atomic<bool> write_aborted{false};
+    std::atomic<bool> consumer_waiting{false};
+
+    // Written by the consumer.
+    alignas(64) std::atomic<UInt64> read_pos{0};
+    // Bumped after `read_pos` or the state of the consumer changes, the producer waits on it.
+    std::atomic<UInt32> read_seq{0};
+    std::atomic<Int32> consumer_pid{0};
+    std::atomic<bool> read_cancelled{false};
+    std::atomic<bool> producer_waiting{false};
+};
+
+ShmRingBufferPtr ShmRingBuffer::create(size_t capacity)
+{
+    static_assert(sizeof(Header) <= DATA_OFFSET);
+    // The atomics are shared between processes, so they must be lock free.
+    static_assert(std::atomic<UInt64>::is_always_lock_free && std::atomic<UInt32>::is_always_lock_free);
+    static_assert(sizeof(std::atomic<UInt32>) == sizeof(UInt32), "The futex word must be 32 bits");
+    RUNTIME_CHECK(capacity > 0);
+    static std::atomic<UInt64> next_id{0};
+    String name = fmt::format("{}{}.{}", NAME_PREFIX, ::getpid(), next_id.fetch_add(1));
+
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throwFromErrno(fmt::format("Cannot create shared memory {}", name), ErrorCodes::CANNOT_OPEN_FILE);
+    SCOPE_EXIT({ ::close(fd); });
+
+    const size_t mapped_size = DATA_OFFSET + capacity;
+    if (::ftruncate(fd, mapped_size) != 0)
+    {
+        auto saved_errno = errno;
+        ::shm_unlink(name.c_str());
+        throwFromErrno(
+            fmt::format("Cannot truncate shared memory {} to {} bytes", name, mapped_size),
+            ErrorCodes::CANNOT_TRUNCATE_FILE,
+            saved_errno);
+    }
+    void * addr = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        auto saved_errno = errno;
+        ::shm_unlink(name.c_str());
+        throwFromErrno(
+            fmt::format("Cannot mmap shared memory {}", name),
+            ErrorCodes::CANNOT_ALLOCATE_MEMORY,
+            saved_errno);
+    }
+
+    const String token = genToken();
+    auto * header = new (addr) Header();
+    header->capacity = capacity;
+    std::memcpy(header->token, token.data(), TOKEN_SIZE);
+    header->consumer_pid = ::getpid();
+    return ShmRingBufferPtr(new ShmRingBuffer(name, token, addr, mapped_size, false));
+}
+
+ShmRingBufferPtr ShmRingBuffer::open(const String & name, const String & token)
+{
+    // Only open the segments created by `create`.
+    if (!name.starts_with(NAME_PREFIX) || name.find('/', 1) != String::npos)
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Invalid shared memory name {}", name);
+    if (token.size() != TOKEN_SIZE)
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Invalid token of shared memory {}", name);
+
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+        throwFromErrno(fmt::format("Cannot open shared memory {}", name), ErrorCodes::CANNOT_OPEN_FILE);
+    SCOPE_EXIT({ ::close(fd); });
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+        throwFromErrno(fmt::format("Cannot stat shared memory {}", name), ErrorCodes::CANNOT_OPEN_FILE);
+    // `create` makes the segment with mode 0600 under the same user, reject anything else that takes the name.
+    if (st.st_uid != ::geteuid() || (st.st_mode & 077) != 0)
+        throw Exception(
+            ErrorCodes::CANNOT_OPEN_FILE,
+            "Shared memory {} is owned by uid {} with mode {:o}, expect uid {} and no access for others",
+            name,
+            st.st_uid,
+            st.st_mode & 0777,
+            ::geteuid());
+    const auto mapped_size = static_cast<size_t>(st.st_size);
+    if (mapped_size <= DATA_OFFSET)
+        throw Exception(ErrorCodes::CANNOT_OPEN_FILE, "Invalid size {} of shared memory {}", mapped_size, name);
+    void * addr = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+        throwFromErrno(fmt::format("Cannot mmap shared memory {}", name), ErrorCodes::CANNOT_ALLOCATE_MEMORY);
+
+    auto * header = static_cast<Header *>(addr);
+    Int32 expected_pid = 0;
+    if (header->magic != MAGIC || header->capacity + DATA_OFFSET != mapped_size
+        || std::memcmp(header->token, token.data(), TOKEN_SIZE) != 0
+        || !header->producer_pid.compare_exchange_strong(expected_pid, ::getpid()))
+    {
+        ::munmap(addr, mapped_size);
+        throw Exception(ErrorCodes::CANNOT_OPEN_FILE, "Shared memory {} is not a free ring buffer", name);
+    }
+    // Both sides have mapped the segment after this, the name is not needed any more. Unlink it after the token
+    // is checked, otherwise anyone who guesses the name could make the real producer fail to open it.
+    ::shm_unlink(name.c_str());
+    return ShmRingBufferPtr(new ShmRingBuffer(name, token, addr, mapped_size, true));
+}
+
+ShmRingBuffer::ShmRingBuffer(
+    const String & name_,
+    const String & token_,
+    void * addr,
+    size_t mapped_size_,
+    bool is_producer_)
+    : name(name_)
+    , token(token_)
+    , header(static_cast<Header *>(addr))
+    , data_area(static_cast<char *>(addr) + DATA_OFFSET)
+    , mapped_size(mapped_size_)
+    , capacity(header->capacity)
+    , is_producer(is_producer_)
+{}
+
+ShmRingBuffer::~ShmRingBuffer()
+{
+    if (is_producer)
+    {
+        // The consumer should not wait for the data that will never come.
+        if (!header->write_finished.load())
+        {
+            header->write_aborted = true;
+            header->write_seq.fetch_add(1);
+            wakeFutex(header->write_seq);
+        }
+    }
+    else
+    {
+        cancelRead();
+        // The producer may never open the segment, it is fine if the name has been unlinked.
+        ::shm_unlink(name.c_str());
+    }
+    ::munmap(static_cast<void *>(header), mapped_size);
+}
+
+template <typename Pred>
+bool ShmRingBuffer::waitFor(
+    std::atomic<UInt32> & seq,
+    std::atomic<bool> & waiting,
+    const std::atomic<Int32> & peer_pid,
+    Pred && ready)
+{
+    for (size_t i = 0; i < SPIN_ROUNDS; ++i)
+    {
+        if (ready())
+            return true;
+        std::this_thread::yield();
+    }
+    while (true)
+    {
+        // Load `seq` before checking the condition, so that the wait returns immediately if the peer changes
+        // the state after the check.
+        UInt32 cur_seq = seq.load();
+        waiting.store(true);
+        if (ready())
+        {
+            waiting.store(false);
+            return true;
+        }
+        waitOnFutex(seq, cur_seq);
+        waiting.store(false);
+        if (ready())
+            return true;
+        if (deadline && std::chrono::steady_clock::now() > *deadline)
+            throw Exception(ErrorCodes::TIMEOUT_EXCEEDED, "Wait for the peer of shared memory {} timeout", name);
+        if (!isProcessAlive(peer_pid.load()))
+            return false;
+    }
+}
+
+void ShmRingBuffer::copyIn(UInt64 pos, const char * from, size_t size)
+{
+    const size_t offset = pos % capacity;
+    const size_t first = std::min(size, capacity - offset);
+    std::memcpy(data_area + offset, from, first);
+    std::memcpy(data_area, from + first, size - first);
+}
+
+void ShmRingBuffer::copyOut(UInt64 pos, char * to, size_t size) const
+{
+    const size_t offset = pos % capacity;
+    const size_t first = std::min(size, capacity - offset);
+    std::memcpy(to, data_area + offset, first);
+    std::memcpy(to + first, data_area, size - first);
+}
+
+bool ShmRingBuffer::write(const char * data, size_t size)
+{
+    assert(is_producer);
+    UInt64 write_pos = header->write_pos.load(std::memory_order_relaxed);
+    while (size > 0)
+    {
+        UInt64 read_pos = 0;
+        auto has_space = [&] {
+            if (header->read_cancelled.load())
+                return true;
+            read_pos = header->read_pos.load(std::memory_order_acquire);
+            return write_pos - read_pos < capacity;
+        };
+        if (!waitFor(header->read_seq, header->producer_waiting, header->consumer_pid, has_space)
+            || header->read_cancelled.load())
+            return false;
+
+        const size_t n = std::min(size, capacity - (write_pos - read_pos));
+        copyIn(write_pos, data, n);
+        write_pos += n;
+        data += n;
+        size -= n;
+        header->write_pos.store(write_pos, std::memory_order_release);
+        header->write_seq.fetch_add(1);
+        if (header->consumer_waiting.load())
+            wakeFutex(header->write_seq);
+    }
+    return true;
+}
+
+void ShmRingBuffer::finishWrite()
+{
+    assert(is_producer);
+    header->write_finished = true;
+    header->write_seq.fetch_add(1);
+    wakeFutex(header->write_seq);
+}
+
+bool ShmRingBuffer::read(char * to, size_t size)
+{
+    assert(!is_producer);
+    UInt64 read_pos = header->read_pos.load(std::memory_order_relaxed);
+    bool is_first = true;
+    while (size > 0)
+    {
+        UInt64 write_pos = 0;
+        bool finished = false;
+        bool cancelled = false;
+        auto has_data = [&] {
+            // `cancelRead` may be called by another thread when this thread is waiting.
+            cancelled = header->read_cancelled.load();
+            // Load the state before `write_pos`, so that `write_pos` is the final one if the producer has finished.
+            finished = header->write_finished.load() || header->write_aborted.load();
+            write_pos = header->write_pos.load(std::memory_order_acquire);
+            return cancelled || finished || write_pos > read_pos;
+        };
+        if (!waitFor(header->write_seq, header->consumer_waiting, header->producer_pid, has_data))
+            throw Exception(
+                ErrorCodes::CANNOT_READ_ALL_DATA,
+                "The producer of shared memory {} exited unexpectedly",
+                name);
+        if (cancelled)
+            throw Exception(ErrorCodes::QUERY_WAS_CANCELLED, "Read from shared memory {} is cancelled", name);
+
+        if (write_pos == read_pos)
+        {
+            if (header->write_aborted.load())
+                throw Exception(
+                    ErrorCodes::CANNOT_READ_ALL_DATA,
+                    "The producer of shared memory {} aborted without finishing",
+                    name);
+            if (is_first)
+                return false;
+            throw Exception(
+                ErrorCodes::CANNOT_READ_ALL_DATA,
+                "The producer of shared memory {} finished in the middle of the data, {} bytes left",
+                name,
+                size);
+        }
+
+        const size_t n = std::min<size_t>(size, write_pos - read_pos);
+        copyOut(read_pos, to, n);
+        read_pos += n;
+        to += n;
+        size -= n;
+        is_first = false;
+        header->read_pos.store(read_pos, std::memory_order_release);
+        header->read_seq.fetch_add(1);
+        if (header->producer_waiting.load())
+            wakeFutex(header->read_seq);
+    }
+    return true;
+}
+
+void ShmRingBuffer::cancelRead()
+{
+    assert(!is_producer);
+    header->read_cancelled = true;
+    header->read_seq.fetch_add(1);
+    wakeFutex(header->read_seq);
+    // Also wake the thread of this side that is waiting for the data.
+    header->write_seq.fetch_add(1);
+    wakeFutex(header->write_seq);
+}
+} // namespace DB
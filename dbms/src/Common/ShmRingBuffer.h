@@ -0,0 +1,94 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <common/types.h>
+
+#include <atomic>
+#include <boost/noncopyable.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+
+namespace DB
+{
+class ShmRingBuffer;
+using ShmRingBufferPtr = std::unique_ptr<ShmRingBuffer>;
+
+/** A single-producer single-consumer byte ring in a POSIX shared memory segment, used to transfer data
+  * between two processes on the same host without going through the network stack.
+  *
+  * The consumer creates the segment and passes its name and a random token to the producer by other means, then
+  * the producer opens it with the token. The name is unlinked as soon as the producer has mapped the segment, so
+  * the memory is released after both sides unmap it even if one of them crashes.
+  *
+  * Both sides wait on a futex in the segment when the ring is empty or full, and check whether the peer process
+  * is still alive every time the wait times out, so the peers must be in the same pid namespace.
+  */
+class ShmRingBuffer : private boost::noncopyable
+{
+public:
+    /// Create a segment with a unique name as the consumer.
+    static ShmRingBufferPtr create(size_t capacity);
+    /// Open the segment created by the consumer as the producer, throw if the token does not match.
+    static ShmRingBufferPtr open(const String & name, const String & token);
+
+    ~ShmRingBuffer();
+
+    const String & getName() const { return name; }
+    const String & getToken() const { return token; }
+
+    /// `read` and `write` throw if they are still waiting after the deadline.
+    void setDeadline(std::chrono::steady_clock::time_point deadline_) { deadline = deadline_; }
+
+    /// Write `size` bytes, wait if the ring is full.
+    /// Return false if the consumer has cancelled or exited.
+    bool write(const char * data, size_t size);
+    /// No more data, the consumer reads the remaining data and then gets false.
+    void finishWrite();
+
+    /// Read exactly `size` bytes, wait if the ring is empty.
+    /// Return false if the producer has finished and all the data is read.
+    /// Throw if the producer exits without finishing, or finishes in the middle of the `size` bytes.
+    /// Throw if the read is cancelled.
+    bool read(char * to, size_t size);
+    /// Tell the producer to stop writing, and wake the `read` waiting in another thread.
+    void cancelRead();
+
+private:
+    struct Header;
+
+    ShmRingBuffer(const String & name_, const String & token_, void * addr, size_t mapped_size_, bool is_producer_);
+
+    template <typename Pred>
+    bool waitFor(
+        std::atomic<UInt32> & seq,
+        std::atomic<bool> & waiting,
+        const std::atomic<Int32> & peer_pid,
+        Pred && ready);
+
+    void copyIn(UInt64 pos, const char * from, size_t size);
+    void copyOut(UInt64 pos, char * to, size_t size) const;
+
+    const String name;
+    const String token;
+    Header * header;
+    char * data_area;
+    const size_t mapped_size;
+    const size_t capacity;
+    const bool is_producer;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+};
+} // namespace DB
@@ -132,6 +132,16 @@ TiFlashMetrics::TiFlashMetrics()
                .Name("tiflash_storage_remote_cache_wait_on_downloading_seconds")
                .Help("Bounded wait duration of remote cache downloading")
                .Register(*registry);
+    registered_pipeline_numa_node_family = &prometheus::BuildGauge()
+                                                .Name("tiflash_pipeline_numa_node")
+                                                .Help("Pipeline cpu task thread pool status of each NUMA node")
+                                                .Register(*registry);
+    registered_pipeline_numa_node_tasks_family
+        = &prometheus::BuildCounter()
+               .Name("tiflash_pipeline_numa_node_tasks")
+               .Help("Pipeline cpu tasks that run on a NUMA node other than the preferred one")
+               .Register(*registry);
+
     registered_remote_cache_reject_family = &prometheus::BuildCounter()
                                                  .Name("tiflash_storage_remote_cache_reject")
                                                  .Help("Remote cache admission rejection by reason and file type")
@@ -421,4 +431,25 @@ prometheus::Counter & TiFlashMetrics::getRemoteCacheRejectCounter(
 {
     return *remote_cache_reject_metrics[static_cast<size_t>(file_type)][static_cast<size_t>(reason)];
 }
+
+prometheus::Gauge & TiFlashMetrics::getPipelineNUMANodeGauge(size_t numa_node, const String & type)
+{
+    auto node_str = std::to_string(numa_node);
+    std::lock_guard lock(pipeline_numa_node_mtx);
+    auto [it, inserted] = registered_pipeline_numa_node_metrics.try_emplace(fmt::format("{}_{}", node_str, type));
+    if (inserted)
+        it->second = &registered_pipeline_numa_node_family->Add({{"numa_node", node_str}, {"type", type}});
+    return *it->second;
+}
+
+prometheus::Counter & TiFlashMetrics::getPipelineNUMANodeCounter(size_t numa_node, const String & type)
+{
+    auto node_str = std::to_string(numa_node);
+    std::lock_guard lock(pipeline_numa_node_mtx);
+    auto [it, inserted]
+        = registered_pipeline_numa_node_tasks_metrics.try_emplace(fmt::format("{}_{}", node_str, type));
+    if (inserted)
+        it->second = &registered_pipeline_numa_node_tasks_family->Add({{"numa_node", node_str}, {"type", type}});
+    return *it->second;
+}
 } // namespace DB
@@ -171,6 +171,17 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_passthrough_none_compression_remote, {"type", "passthrough_none_compression_remote"}),                                 \
       F(type_passthrough_lz4_compression, {"type", "passthrough_lz4_compression"}),                                                 \
       F(type_passthrough_zstd_compression, {"type", "passthrough_zstd_compression"}))                                               \
+    M(tiflash_mpp_result_cache,                                                                                                     \
+      "MPP result cache statistics",                                                                                                \
+      Counter,                                                                                                                      \
+      F(type_hit, {"type", "hit"}),                                                                                                 \
+      F(type_hit_bytes, {"type", "hit_bytes"}),                                                                                     \
+      F(type_miss, {"type", "miss"}),                                                                                               \
+      F(type_insert, {"type", "insert"}),                                                                                           \
+      F(type_uncacheable, {"type", "uncacheable"}))                                                                                 \
+    M(tiflash_exchange_partition_skew_count,                                                                                        \
+      "Total number of hash exchange senders that detect skewed partition keys",                                                    \
+      Counter)                                                                                                                      \
     M(tiflash_sync_schema_applying, "Whether the schema is applying or not (holding lock)", Gauge)                                  \
     M(tiflash_schema_trigger_count,                                                                                                 \
       "Total number of each kinds of schema sync trigger",                                                                          \
@@ -274,6 +285,7 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_seg_split_fg, {"type", "seg_split_fg"}),                                                                               \
       F(type_seg_split_ingest, {"type", "seg_split_ingest"}),                                                                       \
       F(type_seg_merge_bg_gc, {"type", "seg_merge_bg_gc"}),                                                                         \
+      F(type_seg_merge_bg_empty, {"type", "seg_merge_bg_empty"}),                                                                   \
       F(type_place_index_update, {"type", "place_index_update"}))                                                                   \
     M(tiflash_storage_subtask_duration_seconds,                                                                                     \
       "Bucketed histogram of storage's sub task duration",                                                                          \
@@ -288,6 +300,7 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_seg_split_fg, {{"type", "seg_split_fg"}}, ExpBuckets{0.010, 2, 20}),                                                   \
       F(type_seg_split_ingest, {{"type", "seg_split_ingest"}}, ExpBuckets{0.010, 2, 20}),                                           \
       F(type_seg_merge_bg_gc, {{"type", "seg_merge_bg_gc"}}, ExpBuckets{0.010, 2, 20}),                                             \
+      F(type_seg_merge_bg_empty, {{"type", "seg_merge_bg_empty"}}, ExpBuckets{0.010, 2, 20}),                                       \
       F(type_place_index_update, {{"type", "place_index_update"}}, ExpBuckets{0.010, 2, 20}))                                       \
     M(tiflash_storage_subtask_throughput_bytes,                                                                                     \
       "Calculate the throughput of (maybe foreground) tasks of storage in bytes",                                                   \
@@ -688,6 +701,7 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_threads_of_client_cq_pool, {"type", "rpc_client_cq_pool"}),                                                            \
       F(type_threads_of_receiver_read_loop, {"type", "rpc_receiver_read_loop"}),                                                    \
       F(type_threads_of_receiver_reactor, {"type", "rpc_receiver_reactor"}),                                                        \
+      F(type_threads_of_receiver_decode, {"type", "rpc_receiver_decode"}),                                                          \
       F(type_max_threads_of_establish_mpp, {"type", "rpc_establish_mpp_max"}),                                                      \
       F(type_active_threads_of_establish_mpp, {"type", "rpc_establish_mpp"}),                                                       \
       F(type_max_threads_of_dispatch_mpp, {"type", "rpc_dispatch_mpp_max"}),                                                        \
@@ -707,6 +721,9 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_thread_soft_limit, {"type", "thread_soft_limit"}),                                                                     \
       F(type_thread_hard_limit, {"type", "thread_hard_limit"}),                                                                     \
       F(type_hard_limit_exceeded_count, {"type", "hard_limit_exceeded_count"}),                                                     \
+      F(type_global_estimated_memory_usage, {"type", "global_estimated_memory_usage"}),                                             \
+      F(type_memory_limit, {"type", "memory_limit"}),                                                                               \
+      F(type_memory_limit_waiting_count, {"type", "memory_limit_waiting_count"}),                                                   \
       F(type_group_entry_count, {"type", "group_entry_count"}))                                                                     \
     M(tiflash_task_scheduler_waiting_duration_seconds,                                                                              \
       "Bucketed histogram of task waiting for scheduling duration",                                                                 \
@@ -722,6 +739,7 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_sche_active_segment_limit, {"type", "sche_active_segment_limit"}),                                                     \
       F(type_sche_from_cache, {"type", "sche_from_cache"}),                                                                         \
       F(type_sche_new_task, {"type", "sche_new_task"}),                                                                             \
+      F(type_sche_attach_task, {"type", "sche_attach_task"}),                                                                       \
       F(type_ru_exhausted, {"type", "ru_exhausted"}),                                                                               \
       F(type_push_block_bytes, {"type", "push_block_bytes"}),                                                                       \
       F(type_add_cache_total_bytes_limit, {"type", "add_cache_total_bytes_limit"}))                                                 \
@@ -865,6 +883,15 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_io_queue, {{"type", "io_queue"}}, ExpBuckets{0.005, 2, 20}),                                                           \
       F(type_await, {{"type", "await"}}, ExpBuckets{0.005, 2, 20}),                                                                 \
       F(type_wait_for_notify, {{"type", "wait_for_notify"}}, ExpBuckets{0.005, 2, 20}))                                             \
+    M(tiflash_pipeline_task_schedule_latency_seconds,                                                                               \
+      "Bucketed histogram of the time a pipeline task waits in the task queue for each priority class in seconds",                  \
+      Histogram,                                                                                                                    \
+      F(type_cpu_high, {{"type", "cpu_high"}}, ExpBuckets{0.0005, 2, 20}),                                                          \
+      F(type_cpu_normal, {{"type", "cpu_normal"}}, ExpBuckets{0.0005, 2, 20}),                                                      \
+      F(type_cpu_low, {{"type", "cpu_low"}}, ExpBuckets{0.0005, 2, 20}),                                                            \
+      F(type_io_high, {{"type", "io_high"}}, ExpBuckets{0.0005, 2, 20}),                                                            \
+      F(type_io_normal, {{"type", "io_normal"}}, ExpBuckets{0.0005, 2, 20}),                                                        \
+      F(type_io_low, {{"type", "io_low"}}, ExpBuckets{0.0005, 2, 20}))                                                              \
     M(tiflash_pipeline_task_execute_max_time_seconds_per_round,                                                                     \
       "Bucketed histogram of pipeline task execute max time per round in seconds",                                                  \
       Histogram, /* these command usually cost several hundred milliseconds to several seconds, increase the start bucket to 5ms */ \
@@ -1410,6 +1437,13 @@ public:
         RemoteCacheFileTypeMetric file_type,
         RemoteCacheRejectReasonMetric reason);
 
+    // The per NUMA node status of the pipeline cpu task thread pool, `type` is one of
+    // thread_count/pending_tasks/executing_tasks/utilization.
+    prometheus::Gauge & getPipelineNUMANodeGauge(size_t numa_node, const String & type);
+    // The tasks that run on a NUMA node other than the preferred one, `type` is one of
+    // stolen (taken by an idle thread from another node's queue)/redirected (submitted to another node).
+    prometheus::Counter & getPipelineNUMANodeCounter(size_t numa_node, const String & type);
+
 private:
     TiFlashMetrics();
 
@@ -1486,6 +1520,14 @@ private:
         static_cast<size_t>(RemoteCacheFileTypeMetric::Count)>
         remote_cache_reject_metrics{};
 
+    prometheus::Family<prometheus::Gauge> * registered_pipeline_numa_node_family;
+    std::mutex pipeline_numa_node_mtx;
+    // {numa_node}_{type} -> Gauge
+    std::unordered_map<String, prometheus::Gauge *> registered_pipeline_numa_node_metrics;
+    prometheus::Family<prometheus::Counter> * registered_pipeline_numa_node_tasks_family;
+    // {numa_node}_{type} -> Counter
+    std::unordered_map<String, prometheus::Counter *> registered_pipeline_numa_node_tasks_metrics;
+
 public:
 #define MAKE_METRIC_MEMBER_M(family_name, help, type, ...) \
     MetricFamily<prometheus::type> family_name             \
@@ -99,6 +99,28 @@ inline size_t countCodePoints(const UInt8 * data, size_t size)
     return res;
 }
 
+/// returns true if all the octets in [data, data + size) are 7-bit ASCII
+inline bool isASCII(const UInt8 * data, size_t size)
+{
+    const auto * end = data + size;
+
+#if __SSE2__
+    constexpr auto bytes_sse = sizeof(__m128i);
+    const auto * src_end_sse = data + size / bytes_sse * bytes_sse;
+
+    for (; data < src_end_sse; data += bytes_sse)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data))) != 0)
+            return false;
+    }
+#endif
+
+    UInt8 mask = 0;
+    for (; data < end; ++data)
+        mask |= *data;
+    return mask < 0x80;
+}
+
 // Convert utf8 position to byte position.
 // For Example:
 //   Taking string "ni好a" as an example.
@@ -70,7 +70,14 @@ query_cpu_percent=77
         ASSERT_EQ(config.cpu_cores, static_cast<int>(std::thread::hardware_concurrency()));
         auto default_query_threads = std::vector<std::string>{"grpcpp_sync_ser"};
         ASSERT_EQ(config.query_threads, default_query_threads);
+        ASSERT_FALSE(config.numa_aware);
     }
+
+    auto config = CPUAffinityManager::readConfig(*loadConfigFromString(R"(
+[cpu]
+numa_aware=true
+)"));
+    ASSERT_TRUE(config.numa_aware);
 }
 
 #ifdef __linux__
@@ -147,6 +154,21 @@ TEST(CPUAffinityManagerTest, CPUAffinityManager)
     ASSERT_TRUE(cpu_affinity.isQueryThread("grpcpp_sync_server"));
     ASSERT_FALSE(cpu_affinity.isQueryThread("grpcpp_sync"));
 }
+
+TEST(CPUAffinityManagerTest, parseCPUList)
+{
+    cpu_set_t cpu_set;
+    ASSERT_TRUE(CPUAffinityManager::parseCPUList("0-3,8-9,12\n", cpu_set));
+    ASSERT_EQ(CPUAffinityManager::cpuSetToVec(cpu_set), std::vector<int>({0, 1, 2, 3, 8, 9, 12}));
+
+    // Memory only NUMA nodes have no cpus.
+    ASSERT_TRUE(CPUAffinityManager::parseCPUList("", cpu_set));
+    ASSERT_EQ(CPU_COUNT(&cpu_set), 0);
+
+    ASSERT_FALSE(CPUAffinityManager::parseCPUList("3-1", cpu_set));
+    ASSERT_FALSE(CPUAffinityManager::parseCPUList("a-b", cpu_set));
+    ASSERT_FALSE(CPUAffinityManager::parseCPUList("-1", cpu_set));
+}
 #endif
 
 } // namespace tests
@@ -671,5 +671,87 @@ catch (Exception & e)
     GTEST_FAIL();
 }
 
+TEST_F(TestMyTime, PackedFields)
+try
+{
+    std::vector<MyDateTime> datetimes{
+        MyDateTime(0, 0, 0, 0, 0, 0, 0),
+        MyDateTime(1970, 1, 1, 0, 0, 1, 0),
+        MyDateTime(2023, 12, 31, 23, 59, 59, 999999),
+        MyDateTime(9999, 2, 28, 7, 8, 9, 123456),
+    };
+    for (const auto & datetime : datetimes)
+    {
+        const auto packed = datetime.toPackedUInt();
+        EXPECT_EQ(MyTimePacked::year(packed), datetime.year);
+        EXPECT_EQ(MyTimePacked::month(packed), datetime.month);
+        EXPECT_EQ(MyTimePacked::day(packed), datetime.day);
+        EXPECT_EQ(MyTimePacked::hour(packed), datetime.hour);
+        EXPECT_EQ(MyTimePacked::minute(packed), datetime.minute);
+        EXPECT_EQ(MyTimePacked::second(packed), datetime.second);
+        EXPECT_EQ(MyTimePacked::microSecond(packed), datetime.micro_second);
+    }
+}
+CATCH
+
+TEST_F(TestMyTime, PackedFormatter)
+try
+{
+    std::vector<UInt64> packed_values{
+        MyDateTime(0, 0, 0, 0, 0, 0, 0).toPackedUInt(),
+        MyDateTime(2023, 12, 31, 23, 59, 59, 999999).toPackedUInt(),
+        MyDateTime(2023, 12, 31, 23, 1, 2, 3).toPackedUInt(),
+        MyDateTime(2024, 1, 1, 0, 0, 0, 0).toPackedUInt(),
+        MyDateTime(1999, 2, 3, 4, 5, 6, 7).toPackedUInt(),
+    };
+    for (const String & format :
+         {"%Y-%m-%d %H", "%Y-%m-%d %H:%i:%s.%f", "%y%m%d", "%T", "%%Y %S", "[%Y]", "%H%", "date %d"})
+    {
+        auto packed_formatter = MyDateTimePackedFormatter::tryCreate(format);
+        ASSERT_TRUE(packed_formatter.has_value()) << format;
+        MyDateTimeFormatter formatter(format);
+        for (const auto packed : packed_values)
+        {
+            String expected;
+            formatter.format(MyDateTime(packed), expected);
+            String actual(packed_formatter->length(), '\0');
+            packed_formatter->format(packed, actual.data());
+            EXPECT_EQ(actual, expected) << format;
+        }
+    }
+
+    for (const String & format : {"%b", "%M %Y", "%j", "%h", "%I", "%W", "%e", "%Q"})
+        ASSERT_FALSE(MyDateTimePackedFormatter::tryCreate(format).has_value()) << format;
+}
+CATCH
+
+TEST_F(TestMyTime, ConvertTimeZoneByOffsetWithinDay)
+try
+{
+    std::vector<UInt64> packed_values{
+        0,
+        MyDateTime(1970, 1, 1, 8, 0, 1, 0).toPackedUInt(),
+        MyDateTime(2023, 12, 31, 23, 59, 59, 999999).toPackedUInt(),
+        MyDateTime(2023, 6, 15, 12, 30, 0, 100).toPackedUInt(),
+        MyDateTime(2024, 2, 29, 0, 10, 0, 0).toPackedUInt(),
+        MyDateTime(2023, 2, 30, 10, 0, 0, 0).toPackedUInt(),
+    };
+    for (Int64 offset : {0, 3600, -3600, 8 * 3600, -5 * 3600 - 1800, 14 * 3600})
+    {
+        for (bool from_utc : {true, false})
+        {
+            for (const auto packed : packed_values)
+            {
+                UInt64 expected = 0;
+                convertTimeZoneByOffset(packed, expected, from_utc, offset);
+                UInt64 actual = 0;
+                if (tryConvertTimeZoneByOffsetWithinDay(packed, actual, from_utc, offset))
+                    EXPECT_EQ(actual, expected) << MyDateTime(packed).toString(6) << " " << offset;
+            }
+        }
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
@@ -0,0 +1,155 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/ShmRingBuffer.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+namespace DB::tests
+{
+TEST(ShmRingBufferTest, ReadWrite)
+try
+{
+    // The ring is much smaller than the data, so the data wraps around many times.
+    auto consumer = ShmRingBuffer::create(1000);
+    auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+    // Only one producer is allowed, and the name is unlinked after opened.
+    ASSERT_ANY_THROW(ShmRingBuffer::open(consumer->getName(), consumer->getToken()));
+
+    std::vector<char> data(100000);
+    std::iota(data.begin(), data.end(), 0);
+    const size_t rounds = 10;
+    std::thread writer([&] {
+        for (size_t i = 0; i < rounds; ++i)
+            ASSERT_TRUE(producer->write(data.data(), data.size()));
+        producer->finishWrite();
+    });
+
+    std::vector<char> buf(data.size());
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        ASSERT_TRUE(consumer->read(buf.data(), buf.size()));
+        ASSERT_EQ(buf, data);
+    }
+    char c;
+    ASSERT_FALSE(consumer->read(&c, 1));
+    writer.join();
+}
+CATCH
+
+TEST(ShmRingBufferTest, CancelAndAbort)
+try
+{
+    {
+        auto consumer = ShmRingBuffer::create(100);
+        auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+        std::vector<char> data(1000);
+        std::thread writer([&] { ASSERT_FALSE(producer->write(data.data(), data.size())); });
+        ASSERT_TRUE(consumer->read(data.data(), 10));
+        consumer->cancelRead();
+        writer.join();
+    }
+    {
+        auto consumer = ShmRingBuffer::create(100);
+        {
+            // The producer is destroyed without finishing
+            auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+            ASSERT_TRUE(producer->write("ab", 2));
+        }
+        char buf[2];
+        ASSERT_TRUE(consumer->read(buf, 2));
+        ASSERT_ANY_THROW(consumer->read(buf, 1));
+    }
+    {
+        auto consumer = ShmRingBuffer::create(100);
+        auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+        consumer->setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(200));
+        char c;
+        ASSERT_ANY_THROW(consumer->read(&c, 1));
+    }
+    ASSERT_ANY_THROW(ShmRingBuffer::open("/not_tiflash", String(32, '0')));
+}
+CATCH
+
+TEST(ShmRingBufferTest, Token)
+try
+{
+    auto consumer = ShmRingBuffer::create(100);
+    ASSERT_EQ(consumer->getToken().size(), 32);
+    ASSERT_NE(consumer->getToken(), ShmRingBuffer::create(100)->getToken());
+
+    ASSERT_ANY_THROW(ShmRingBuffer::open(consumer->getName(), ""));
+    ASSERT_ANY_THROW(ShmRingBuffer::open(consumer->getName(), String(32, '0')));
+    // The name is not unlinked by the failed opens, so the real producer can still open it.
+    auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+    ASSERT_TRUE(producer->write("a", 1));
+    char c;
+    ASSERT_TRUE(consumer->read(&c, 1));
+    ASSERT_EQ(c, 'a');
+}
+CATCH
+
+TEST(ShmRingBufferTest, SegmentMode)
+try
+{
+    auto consumer = ShmRingBuffer::create(100);
+    auto set_mode = [&](mode_t mode) {
+        int fd = ::shm_open(consumer->getName().c_str(), O_RDWR, 0600);
+        if (fd < 0)
+            return false;
+        bool ok = ::fchmod(fd, mode) == 0;
+        ::close(fd);
+        return ok;
+    };
+
+    // Others can access the segment, so it may have been tampered with.
+    ASSERT_TRUE(set_mode(0666));
+    ASSERT_ANY_THROW(ShmRingBuffer::open(consumer->getName(), consumer->getToken()));
+    ASSERT_TRUE(set_mode(0640));
+    ASSERT_ANY_THROW(ShmRingBuffer::open(consumer->getName(), consumer->getToken()));
+
+    ASSERT_TRUE(set_mode(0600));
+    auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+    ASSERT_TRUE(producer->write("a", 1));
+}
+CATCH
+
+TEST(ShmRingBufferTest, CancelWaitingRead)
+try
+{
+    auto consumer = ShmRingBuffer::create(100);
+    auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+    std::atomic_bool cancelled = false;
+    std::thread reader([&] {
+        char c;
+        // The producer is alive and writes nothing, so only the cancel wakes the read.
+        ASSERT_ANY_THROW(consumer->read(&c, 1));
+        ASSERT_TRUE(cancelled.load());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cancelled = true;
+    consumer->cancelRead();
+    reader.join();
+    ASSERT_FALSE(producer->write("a", 1));
+}
+CATCH
+
+} // namespace DB::tests
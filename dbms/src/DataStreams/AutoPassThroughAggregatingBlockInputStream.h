@@ -32,7 +32,8 @@ public:
         const BlockInputStreamPtr & input_,
         const Aggregator::Params & params_,
         const String & req_id,
-        UInt64 row_limit_unit)
+        UInt64 row_limit_unit,
+        const AutoPassThroughSharedSamplerPtr & shared_sampler = nullptr)
     {
         children.push_back(input_);
         auto_pass_through_context = std::make_unique<AutoPassThroughHashAggContext>(
@@ -41,6 +42,7 @@ public:
             [&]() { return this->isCancelled(); },
             req_id,
             row_limit_unit);
+        auto_pass_through_context->setSharedSampler(shared_sampler);
     }
 
     String getName() const override { return NAME; }
@@ -80,7 +80,8 @@ BlockInputStreamPtr constructRootExchangeReceiverStream(
             context.getTMTContext().getKVCluster(),
             context.getTMTContext().getMPPTaskManager(),
             false,
-            context.getSettingsRef().enable_async_grpc_client),
+            context.getSettingsRef().enable_async_grpc_client,
+            false),
         tipb_exchange_receiver.encoded_task_meta_size(),
         10,
         /*req_id=*/"",
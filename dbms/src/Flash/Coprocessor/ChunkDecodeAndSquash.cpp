@@ -146,6 +146,33 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::doDecodeAndSquash(const String
     return res;
 }
 
+std::optional<Block> CHBlockChunkDecodeAndSquash::squash(Block && block)
+{
+    std::optional<Block> res;
+    if (!block.rows())
+        return res;
+
+    if (!accumulated_block)
+    {
+        accumulated_block.emplace(std::move(block));
+    }
+    else
+    {
+        auto mutable_columns = accumulated_block->mutateColumns();
+        for (size_t i = 0; i < mutable_columns.size(); ++i)
+            mutable_columns[i]->insertRangeFrom(*block.getByPosition(i).column, 0, block.rows());
+        accumulated_block->setColumns(std::move(mutable_columns));
+    }
+
+    if (accumulated_block->rows() >= rows_limit)
+    {
+        /// Return accumulated data and reset accumulated_block
+        res.swap(accumulated_block);
+        return res;
+    }
+    return res;
+}
+
 std::optional<Block> CHBlockChunkDecodeAndSquash::flush()
 {
     if (!accumulated_block)
@@ -28,6 +28,8 @@ public:
     ~CHBlockChunkDecodeAndSquash() = default;
     std::optional<Block> decodeAndSquash(const String &);
     std::optional<Block> decodeAndSquashV1(std::string_view);
+    /// Squash a block that is already decoded, the block should have the same structure as `header`.
+    std::optional<Block> squash(Block && block);
     std::optional<Block> flush();
 
 private:
@@ -315,6 +315,11 @@ std::unordered_map<String, IOProfileInfos> & DAGContext::getInboundIOProfileInfo
     return inbound_io_profile_infos_map;
 }
 
+std::unordered_map<String, AutoPassThroughSharedSamplerPtr> & DAGContext::getAutoPassThroughSamplerMap()
+{
+    return auto_pass_through_sampler_map;
+}
+
 void DAGContext::updateFinalConcurrency(size_t cur_streams_size, size_t streams_upper_limit)
 {
     final_concurrency = std::min(std::max(final_concurrency, cur_streams_size), streams_upper_limit);
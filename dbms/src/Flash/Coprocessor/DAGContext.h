@@ -40,6 +40,7 @@
 #include <Flash/Executor/toRU.h>
 #include <Flash/Mpp/MPPTaskId.h>
 #include <Interpreters/SubqueryForSet.h>
+#include <Operators/AutoPassThroughSharedSampler.h>
 #include <Operators/IOProfileInfo.h>
 #include <Operators/OperatorProfileInfo.h>
 #include <Parsers/makeDummyQuery.h>
@@ -214,6 +215,8 @@ public:
 
     std::unordered_map<String, IOProfileInfos> & getInboundIOProfileInfosMap();
 
+    std::unordered_map<String, AutoPassThroughSharedSamplerPtr> & getAutoPassThroughSamplerMap();
+
     void addInboundIOProfileInfos(
         const String & executor_id,
         IOProfileInfos && io_profile_infos,
@@ -527,6 +530,9 @@ private:
     /// inbound_io_profile_infos_map is a map that maps from executor_id (table_scan / exchange_receiver) to IOProfileInfos.
     /// IOProfileInfos are from ExchangeReceiverSourceOp, CoprocessorSourceOp and local_read_source etc.
     std::unordered_map<String, IOProfileInfos> inbound_io_profile_infos_map;
+    /// auto_pass_through_sampler_map is a map that maps from executor_id (aggregation) to AutoPassThroughSharedSampler.
+    /// AggStatistics gets the decisions of auto pass through hash agg through it.
+    std::unordered_map<String, AutoPassThroughSharedSamplerPtr> auto_pass_through_sampler_map;
 
     UInt64 flags;
     UInt64 sql_mode;
@@ -989,7 +989,7 @@ String DAGExpressionAnalyzer::applyFunction(
     const TiDB::TiDBCollatorPtr & collator)
 {
     String result_name = genFuncString(func_name, arg_names, {collator});
-    if (actions->getSampleBlock().has(result_name))
+    if (tryReuseComputedColumn(actions, result_name))
         return result_name;
     const FunctionBuilderPtr & function_builder = FunctionFactory::instance().get(func_name, context);
     const ExpressionAction & action
@@ -1891,6 +1891,18 @@ void DAGExpressionAnalyzer::makeExplicitSet(
     prepared_sets[&expr] = std::make_shared<DAGSet>(std::move(set), std::move(remaining_exprs));
 }
 
+bool DAGExpressionAnalyzer::tryReuseComputedColumn(const ExpressionActionsPtr & actions, const String & result_name)
+{
+    if (!actions->getSampleBlock().has(result_name))
+        return false;
+    const auto & input_columns = actions->getRequiredColumnsWithTypes();
+    if (std::any_of(input_columns.begin(), input_columns.end(), [&](const auto & column) {
+            return column.name == result_name;
+        }))
+        ++eliminated_expr_count;
+    return true;
+}
+
 String DAGExpressionAnalyzer::getActions(
     const tipb::Expr & expr,
     const ExpressionActionsPtr & actions,
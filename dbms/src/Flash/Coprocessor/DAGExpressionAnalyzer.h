@@ -96,6 +96,16 @@ public:
 
     String getActions(const tipb::Expr & expr, const ExpressionActionsPtr & actions, bool output_as_uint8_type = false);
 
+    /// Return true if the column `result_name` is already available in `actions`, in which case it is reused
+    /// instead of being computed again. The column may come from a former sub-expression of the same actions,
+    /// or be an input of `actions` computed by a former chain step or child operator (e.g. a filter condition
+    /// that is projected later), since those intermediate columns are only pruned at finalize.
+    bool tryReuseComputedColumn(const ExpressionActionsPtr & actions, const String & result_name);
+
+    /// The number of expressions reused from the inputs of the actions, i.e. computed by a former chain step or
+    /// child operator. Duplicated sub-expressions within the same actions are not counted.
+    size_t getEliminatedExprCount() const { return eliminated_expr_count; }
+
     // appendExtraCastsAfterTS will append extra casts after tablescan if needed.
     // 1) add timezone cast after table scan, this is used for session level timezone support
     // the basic idea of supporting session level timezone is that:
@@ -331,6 +341,8 @@ private:
     bool building_filter_conditions = false;
     std::unordered_set<String> json_valid_guarded_exprs;
 
+    size_t eliminated_expr_count = 0;
+
     friend class DAGExpressionAnalyzerHelper;
 };
 
@@ -253,7 +253,7 @@ String DAGExpressionAnalyzerHelper::buildCastFunctionInternal(
     static const String tidb_cast_name = "tidb_cast";
 
     String result_name = genFuncString(tidb_cast_name, argument_names, {nullptr}, {&field_type});
-    if (actions->getSampleBlock().has(result_name))
+    if (analyzer->tryReuseComputedColumn(actions, result_name))
         return result_name;
 
     FunctionBuilderPtr function_builder = FunctionFactory::instance().get(tidb_cast_name, analyzer->getContext());
@@ -312,7 +312,7 @@ String DAGExpressionAnalyzerHelper::buildSingleParamJsonRelatedFunctions(
     // Guarded and strict casts can coexist in different logical branches and must not share an action.
     if (ignore_invalid_json)
         result_name += "_json_valid_guarded";
-    if (actions->getSampleBlock().has(result_name))
+    if (analyzer->tryReuseComputedColumn(actions, result_name))
         return result_name;
 
     const FunctionBuilderPtr & ifunction_builder = FunctionFactory::instance().get(func_name, analyzer->getContext());
@@ -508,7 +508,7 @@ String DAGExpressionAnalyzerHelper::buildGroupingFunction(
     String result_name = genFuncString(func_name, argument_names, {getCollatorFromExpr(expr)});
     // grouping function's metadata has naturally been encoded as proto-message as string, just appending them to the result name as new grouping functions' result_name.
     result_name += expr.val();
-    if (actions->getSampleBlock().has(result_name))
+    if (analyzer->tryReuseComputedColumn(actions, result_name))
         return result_name;
 
     FunctionBuilderPtr function_builder = FunctionFactory::instance().get(func_name, analyzer->getContext());
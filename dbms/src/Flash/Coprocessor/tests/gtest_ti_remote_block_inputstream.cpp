@@ -30,6 +30,7 @@
 #include <Flash/Mpp/BroadcastOrPassThroughWriter.cpp>
 #include <Flash/Mpp/ExchangeReceiver.cpp>
 #include <memory>
+#include <thread>
 #include <utility>
 
 
@@ -432,18 +433,25 @@ public:
         ASSERT_EQ(receiver_stream->getTotalRows(), reference_block.rows());
     }
 
-    static std::shared_ptr<MockExchangeReceiverInputStream> makeExchangeReceiverInputStream(
+    static std::shared_ptr<MockExchangeReceiver> makeExchangeReceiver(
         PacketQueuePtr queue_ptr,
-        const ContextPtr & context)
+        const Settings & settings)
     {
-        auto receiver = std::make_shared<MockExchangeReceiver>(
+        return std::make_shared<MockExchangeReceiver>(
             std::make_shared<MockReceiverContext>(queue_ptr, makeFields()),
             1,
             1,
             "mock_req_id",
             "mock_exchange_receiver_id",
             0,
-            context->getSettingsRef());
+            settings);
+    }
+
+    static std::shared_ptr<MockExchangeReceiverInputStream> makeExchangeReceiverInputStream(
+        PacketQueuePtr queue_ptr,
+        const ContextPtr & context)
+    {
+        auto receiver = makeExchangeReceiver(queue_ptr, context->getSettingsRef());
         auto receiver_stream
             = std::make_shared<MockExchangeReceiverInputStream>(receiver, "mock_req_id", "executor_0", 0);
         return receiver_stream;
@@ -482,6 +490,16 @@ public:
         checkChunkInResponse(source_blocks, decoded_blocks, receiver_stream, writer);
     }
 
+    static std::vector<Block> readAll(const std::shared_ptr<MockExchangeReceiverInputStream> & receiver_stream)
+    {
+        std::vector<Block> decoded_blocks;
+        receiver_stream->readPrefix();
+        while (const auto & block = receiver_stream->read())
+            decoded_blocks.emplace_back(block);
+        receiver_stream->readSuffix();
+        return decoded_blocks;
+    }
+
     std::unique_ptr<DAGContext> dag_context_ptr{};
     ContextPtr context;
 };
@@ -502,5 +520,108 @@ try
 }
 CATCH
 
+TEST_F(TestTiRemoteBlockInputStream, testDecodeStage)
+try
+{
+    for (UInt64 decode_concurrency : {1, 4})
+    {
+        SCOPED_TRACE(fmt::format("decode_concurrency={}", decode_concurrency));
+        PacketQueuePtr queue_ptr = std::make_shared<PacketQueue>(1000);
+        std::vector<Block> source_blocks;
+        auto writer = std::make_shared<MockWriter>(*dag_context_ptr, queue_ptr);
+        prepareQueue(writer, source_blocks, false);
+        queue_ptr->finish();
+
+        auto settings = context->getSettings();
+        settings.exchange_receiver_decode_concurrency = decode_concurrency;
+        auto receiver = makeExchangeReceiver(queue_ptr, settings);
+        ASSERT_NE(receiver->decoded_message_queue, nullptr);
+        auto receiver_stream
+            = std::make_shared<MockExchangeReceiverInputStream>(receiver, "mock_req_id", "executor_0", 0);
+        auto decoded_blocks = readAll(receiver_stream);
+
+        // Each packet only contains 6144 rows, the blocks decoded from the packets are squashed across
+        // the packets by the consumer.
+        ASSERT_GT(decoded_blocks.size(), 1);
+        for (size_t i = 0; i + 1 < decoded_blocks.size(); ++i)
+            ASSERT_GE(decoded_blocks[i].rows(), 8192) << i;
+
+        if (decode_concurrency == 1)
+        {
+            // The order of the packets is kept with one decode thread
+            checkNoChunkInResponse(source_blocks, decoded_blocks, receiver_stream, writer);
+        }
+        else
+        {
+            Block reference_block = squashBlocks(source_blocks);
+            Block decoded_block = squashBlocks(decoded_blocks);
+            ASSERT_COLUMNS_EQ_UR(
+                reference_block.getColumnsWithTypeAndName(),
+                decoded_block.getColumnsWithTypeAndName());
+            ASSERT_EQ(receiver_stream->getTotalRows(), reference_block.rows());
+        }
+        ASSERT_EQ(receiver->getDataSizeInQueue()->load(), 0);
+    }
+}
+CATCH
+
+TEST_F(TestTiRemoteBlockInputStream, testDecodeStageMemoryLimit)
+try
+{
+    PacketQueuePtr queue_ptr = std::make_shared<PacketQueue>(1000);
+    std::vector<Block> source_blocks;
+    auto writer = std::make_shared<MockWriter>(*dag_context_ptr, queue_ptr);
+    prepareQueue(writer, source_blocks, false);
+    queue_ptr->finish();
+
+    auto settings = context->getSettings();
+    settings.exchange_receiver_decode_concurrency = 1;
+    // Any message exceeds the limit, so each queue buffers only one message
+    settings.max_buffered_bytes_in_executor = 1;
+    auto receiver = makeExchangeReceiver(queue_ptr, settings);
+    for (size_t i = 0; i < 1000 && receiver->decoded_message_queue->size() == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    // Wait for the decode thread to be blocked by the limit
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(receiver->decoded_message_queue->size(), 1);
+    ASSERT_GT(receiver->getDataSizeInQueue()->load(), 0);
+
+    auto receiver_stream = std::make_shared<MockExchangeReceiverInputStream>(receiver, "mock_req_id", "executor_0", 0);
+    auto decoded_blocks = readAll(receiver_stream);
+    checkNoChunkInResponse(source_blocks, decoded_blocks, receiver_stream, writer);
+    // Both the received and the decoded messages are counted and released
+    ASSERT_EQ(receiver->getDataSizeInQueue()->load(), 0);
+}
+CATCH
+
+TEST_F(TestTiRemoteBlockInputStream, testDecodeStageCancel)
+try
+{
+    PacketQueuePtr queue_ptr = std::make_shared<PacketQueue>(1000);
+    std::vector<Block> source_blocks;
+    auto writer = std::make_shared<MockWriter>(*dag_context_ptr, queue_ptr);
+    prepareQueue(writer, source_blocks, false);
+    // The packet queue is not finished, the receiver keeps waiting for more packets
+
+    auto settings = context->getSettings();
+    settings.exchange_receiver_decode_concurrency = 2;
+    auto receiver = makeExchangeReceiver(queue_ptr, settings);
+    ReceivedMessagePtr recv_msg;
+    ASSERT_EQ(receiver->receive(0, recv_msg), ReceiveStatus::ok);
+    ASSERT_TRUE(recv_msg->isDecoded());
+
+    receiver->cancel();
+    // All the decode threads exit and the decoded queue is cancelled
+    for (size_t i = 0; i < 1000 && receiver->live_decoders.load() > 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(receiver->live_decoders.load(), 0);
+    ASSERT_EQ(receiver->decoded_message_queue->getStatus(), MPMCQueueStatus::CANCELLED);
+    ASSERT_EQ(receiver->receive(0, recv_msg), ReceiveStatus::eof);
+
+    // Let the read loop exit
+    queue_ptr->finish();
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
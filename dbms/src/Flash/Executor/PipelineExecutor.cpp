@@ -40,7 +40,8 @@ PipelineExecutor::PipelineExecutor(
           auto_spill_trigger,
           register_operator_spill_context,
           context.getDAGContext()->getKeyspaceID(),
-          context.getDAGContext()->getResourceGroupName())
+          context.getDAGContext()->getResourceGroupName(),
+          context.getSettingsRef().pipeline_query_weight)
 {
     PhysicalPlan physical_plan{context, log->identifier()};
     physical_plan.build(context.getDAGContext()->dag_request());
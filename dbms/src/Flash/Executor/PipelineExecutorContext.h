@@ -45,6 +45,10 @@ class PipelineExecutorContext : private boost::noncopyable
 public:
     static constexpr auto timeout_err_msg = "error with timeout";
 
+    // The default weight of a query in fair share scheduling,
+    // the cpu time is shared by the queries in proportion to their weights.
+    static constexpr UInt64 DEFAULT_QUERY_WEIGHT = 1024;
+
     // Only used for unit test.
     PipelineExecutorContext()
         : log(Logger::get())
@@ -62,7 +66,8 @@ public:
         AutoSpillTrigger * auto_spill_trigger_ = nullptr,
         const RegisterOperatorSpillContext & register_operator_spill_context_ = nullptr,
         const KeyspaceID & keyspace_id_ = NullspaceID,
-        const String & resource_group_name_ = "")
+        const String & resource_group_name_ = "",
+        UInt64 query_weight_ = DEFAULT_QUERY_WEIGHT)
         : query_id(query_id_)
         , log(Logger::get(req_id))
         , mem_tracker(mem_tracker_)
@@ -71,6 +76,7 @@ public:
         , register_operator_spill_context(register_operator_spill_context_)
         , keyspace_id(keyspace_id_)
         , resource_group_name(resource_group_name_)
+        , query_weight(query_weight_)
     {}
 
     ExecutionResult toExecutionResult();
@@ -142,6 +148,18 @@ public:
 
     const KeyspaceID & getKeyspaceID() const { return keyspace_id; }
 
+    UInt64 getQueryWeight() const { return query_weight; }
+
+    // The NUMA node that the cpu tasks of this query prefer to run on, -1 means not assigned yet.
+    Int32 getNUMANode() const { return numa_node.load(); }
+
+    // Assign the NUMA node if it is not assigned yet, returns the node actually assigned.
+    Int32 assignNUMANode(Int32 node)
+    {
+        Int32 expected = -1;
+        return numa_node.compare_exchange_strong(expected, node) ? node : expected;
+    }
+
     void addSharedQueue(const SharedQueuePtr & shared_queue);
 
     void addOneTimeFuture(const OneTimeNotifyFuturePtr & future);
@@ -193,6 +211,12 @@ private:
 
     const String resource_group_name;
 
+    const UInt64 query_weight = DEFAULT_QUERY_WEIGHT;
+
+    // All the tasks of a query prefer the same NUMA node, so that the hash tables and arenas allocated by one
+    // pipeline are local to the threads of the pipelines reading them.
+    std::atomic<Int32> numa_node{-1};
+
     std::vector<SharedQueuePtr> shared_queues;
 
     std::vector<OneTimeNotifyFuturePtr> one_time_futures;
@@ -32,6 +32,7 @@
 #include <Flash/Mpp/MPPHandler.h>
 #include <Flash/Mpp/MPPTaskManager.h>
 #include <Flash/Mpp/MppVersion.h>
+#include <Flash/Mpp/ShmTransport.h>
 #include <Flash/Mpp/Utils.h>
 #include <Flash/ServiceUtils.h>
 #include <IO/Buffer/MemoryReadWriteBuffer.h>
@@ -114,6 +115,11 @@ void FlashService::init(Context & context_)
     auto settings = context->getSettingsRef();
     enable_local_tunnel = settings.enable_local_tunnel;
     enable_async_grpc_client = settings.enable_async_grpc_client;
+    enable_shm_transport = settings.enable_shm_transport;
+    // The async EstablishMPPConnection writes the packets by the completion queue, only the sync one supports the
+    // shared memory transport. Disaggregated page fetching is always sync.
+    if (enable_shm_transport && is_async)
+        LOG_WARNING(log, "The shared memory transport is not used by MPP exchange because enable_async_server is on");
     const size_t default_size = getNumberOfLogicalCPUCores();
 
     auto cop_pool_size = static_cast<size_t>(settings.cop_pool_size);
@@ -704,9 +710,24 @@ grpc::Status FlashService::EstablishMPPConnection(
     }
     else
     {
-        SyncPacketWriter writer(sync_writer);
-        tunnel->connectSync(&writer);
+        // Write into the shared memory ring buffer if the receiver is on the same host and requests it.
+        std::unique_ptr<PacketWriter> writer;
+        ShmRingBufferPtr ring;
+        if (enable_shm_transport)
+            ring = ShmTransport::tryAccept(*grpc_context, tunnel->getLogger());
+        if (ring != nullptr)
+        {
+            sync_writer->SendInitialMetadata();
+            writer = std::make_unique<ShmPacketWriter>(std::move(ring));
+        }
+        else
+        {
+            writer = std::make_unique<SyncPacketWriter>(sync_writer);
+        }
+        tunnel->connectSync(writer.get());
         tunnel->waitForFinish();
+        // Finish the ring buffer before returning the status.
+        writer.reset();
         LOG_INFO(
             tunnel->getLogger(),
             "connection for {} cost {} ms, including {} ms to wait task.",
@@ -779,6 +800,9 @@ std::tuple<ContextPtr, grpc::Status> FlashService::createDBContextForTest() cons
         tmp_context->setSetting("enable_async_server", is_async ? "true" : "false");
         tmp_context->setSetting("enable_local_tunnel", enable_local_tunnel ? "true" : "false");
         tmp_context->setSetting("enable_async_grpc_client", enable_async_grpc_client ? "true" : "false");
+        // The async server never accepts the shared memory transport. The processes on the same host are assumed to
+        // share the config, so the receivers do not request it and keep reading with the async gRPC client.
+        tmp_context->setSetting("enable_shm_transport", enable_shm_transport && !is_async ? "true" : "false");
         return std::make_tuple(tmp_context, grpc::Status::OK);
     }
     CATCH_FLASHSERVICE_EXCEPTION
@@ -869,6 +893,9 @@ std::tuple<ContextPtr, grpc::Status> FlashService::createDBContext(const grpc::S
         tmp_context->setSetting("enable_async_server", is_async ? "true" : "false");
         tmp_context->setSetting("enable_local_tunnel", enable_local_tunnel ? "true" : "false");
         tmp_context->setSetting("enable_async_grpc_client", enable_async_grpc_client ? "true" : "false");
+        // The async server never accepts the shared memory transport. The processes on the same host are assumed to
+        // share the config, so the receivers do not request it and keep reading with the async gRPC client.
+        tmp_context->setSetting("enable_shm_transport", enable_shm_transport && !is_async ? "true" : "false");
         return std::make_tuple(tmp_context, grpc::Status::OK);
     }
     CATCH_FLASHSERVICE_EXCEPTION
@@ -1072,12 +1099,27 @@ grpc::Status FlashService::FetchDisaggPages(
     if (auto check_result = checkGrpcContext(grpc_context); !check_result.ok())
         return check_result;
 
+    // Write into the shared memory ring buffer if the compute node is on the same host and requests it.
+    auto shm_ring = enable_shm_transport ? ShmTransport::tryAccept(*grpc_context, log) : nullptr;
+    if (shm_ring != nullptr)
+        sync_writer->SendInitialMetadata();
+    SCOPE_EXIT({
+        if (shm_ring != nullptr)
+            shm_ring->finishWrite();
+    });
+    auto write_packet = [&](const disaggregated::PagesPacket & packet) {
+        if (shm_ring != nullptr)
+            ShmTransport::writeMessage(*shm_ring, packet);
+        else
+            sync_writer->Write(packet);
+    };
+
     auto record_error = [&](grpc::StatusCode err_code, const String & err_msg) {
         disaggregated::PagesPacket err_response;
         auto * err = err_response.mutable_error();
         err->set_code(err_code);
         err->set_msg(err_msg);
-        sync_writer->Write(err_response);
+        write_packet(err_response);
         // Do NOT both write an error packet AND return a non-OK grpc::Status.
         // We only write an error packet and return OK.
         return grpc::Status::OK;
@@ -1154,10 +1196,10 @@ grpc::Status FlashService::FetchDisaggPages(
             read_ids.emplace_back(page_id);
 
         auto stream_writer = std::make_unique<WNFetchPagesStreamWriter>(
-            [sync_writer](const disaggregated::PagesPacket & packet) {
+            [&write_packet](const disaggregated::PagesPacket & packet) {
                 GET_METRIC(tiflash_coprocessor_response_bytes, type_disagg_fetch_pages)
                     .Increment(packet.ByteSizeLong());
-                sync_writer->Write(packet);
+                write_packet(packet);
             },
             task.seg_task,
             read_ids,
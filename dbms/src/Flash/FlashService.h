@@ -148,6 +148,7 @@ protected:
     bool is_async = false;
     bool enable_local_tunnel = false;
     bool enable_async_grpc_client = false;
+    bool enable_shm_transport = false;
 
     std::unique_ptr<Management::ManualCompactManager> manual_compact_manager;
     std::unique_ptr<S3::S3LockService> s3_lock_service;
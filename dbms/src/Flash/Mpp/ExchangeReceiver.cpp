@@ -19,6 +19,7 @@
 #include <Common/TiFlashMetrics.h>
 #include <Flash/Coprocessor/CoprocessorReader.h>
 #include <Flash/Coprocessor/FineGrainedShuffle.h>
+#include <Flash/Coprocessor/GenSchemaAndColumn.h>
 #include <Flash/Mpp/ExchangeReceiver.h>
 #include <Flash/Mpp/GRPCCompletionQueuePool.h>
 #include <Flash/Mpp/GRPCReceiverContext.h>
@@ -295,6 +296,22 @@ private:
     std::mutex mu;
 };
 
+size_t getDecodeConcurrency(const Settings & settings, bool enable_fine_grained_shuffle)
+{
+    // With fine grained shuffle, each message is already split per stream
+    return enable_fine_grained_shuffle ? 0 : settings.exchange_receiver_decode_concurrency.get();
+}
+
+// With the decode stage, the received messages and the decoded messages are buffered in two queues,
+// they share the limit of `max_buffered_bytes_in_executor`. 0 means unlimited.
+Int64 getQueueMaxBytes(const Settings & settings, size_t decode_concurrency)
+{
+    const Int64 max_buffered_bytes = settings.max_buffered_bytes_in_executor.get();
+    if (max_buffered_bytes <= 0 || decode_concurrency == 0)
+        return max_buffered_bytes;
+    return std::max<Int64>(1, max_buffered_bytes / 2);
+}
+
 ReceiveStatus toReceiveStatus(MPMCQueueResult pop_result)
 {
     switch (pop_result)
@@ -328,11 +345,15 @@ ExchangeReceiverBase<RPCContext>::ExchangeReceiverBase(
     , connection_uncreated_num(source_num)
     , thread_manager(newThreadManager())
     , received_message_queue(
-          CapacityLimits(max_buffer_size, settings.max_buffered_bytes_in_executor.get()),
+          CapacityLimits(
+              max_buffer_size,
+              getQueueMaxBytes(settings, getDecodeConcurrency(settings, enable_fine_grained_shuffle_flag))),
           exc_log,
           &data_size_in_queue,
           enable_fine_grained_shuffle_flag,
           output_stream_count)
+    , decode_concurrency(getDecodeConcurrency(settings, enable_fine_grained_shuffle_flag))
+    , decode_rows_limit(settings.max_block_size)
     , live_local_connections(0)
     , live_connections(source_num)
     , state(ExchangeReceiverState::NORMAL)
@@ -345,6 +366,8 @@ ExchangeReceiverBase<RPCContext>::ExchangeReceiverBase(
     {
         rpc_context->fillSchema(schema);
         setUpConnection();
+        if (decode_concurrency > 0)
+            setUpDecoders(CapacityLimits(max_buffer_size, getQueueMaxBytes(settings, decode_concurrency)));
     }
     catch (...)
     {
@@ -453,6 +476,8 @@ void ExchangeReceiverBase<RPCContext>::close()
 {
     setEndState(ExchangeReceiverState::CLOSED);
     finishReceivedQueue();
+    if (decoded_message_queue)
+        decoded_message_queue->finish();
 }
 
 template <typename RPCContext>
@@ -577,6 +602,21 @@ void ExchangeReceiverBase<RPCContext>::setUpConnectionWithReadLoop(Request && re
     --connection_uncreated_num;
 }
 
+template <typename RPCContext>
+void ExchangeReceiverBase<RPCContext>::setUpDecoders(const CapacityLimits & queue_limits)
+{
+    // The memory tracker is propagated to the decode threads, so the decoded blocks are accounted
+    // to the same memory tracker as the received packets.
+    decoded_message_queue = std::make_unique<DecodedMessageQueue>(queue_limits);
+    live_decoders = decode_concurrency;
+    for (size_t i = 0; i < decode_concurrency; ++i)
+    {
+        thread_manager->schedule(true, "RecvDecoder", [this] { decodeLoop(); });
+        ++thread_count;
+    }
+    LOG_DEBUG(exc_log, "decode stage is enabled, decode_concurrency: {}", decode_concurrency);
+}
+
 template <typename RPCContext>
 void ExchangeReceiverBase<RPCContext>::reactor(const std::vector<Request> & async_requests)
 {
@@ -718,6 +758,69 @@ void ExchangeReceiverBase<RPCContext>::readLoop(const Request & req)
             waiting_task_time);
 }
 
+template <typename RPCContext>
+void ExchangeReceiverBase<RPCContext>::decodeLoop()
+{
+    GET_METRIC(tiflash_thread_count, type_threads_of_receiver_decode).Increment();
+    SCOPE_EXIT({ GET_METRIC(tiflash_thread_count, type_threads_of_receiver_decode).Decrement(); });
+
+    auto header = Block(getColumnWithTypeAndName(toNamesAndTypes(schema)));
+    auto decoder = std::make_unique<CHBlockChunkDecodeAndSquash>(header, decode_rows_limit);
+    MPMCQueueResult pop_result;
+    MPMCQueueResult push_result = MPMCQueueResult::OK;
+    while (true)
+    {
+        ReceivedMessagePtr recv_msg;
+        pop_result = received_message_queue.pop<true>(0, recv_msg);
+        if (pop_result != MPMCQueueResult::OK)
+            break;
+
+        // The chunks of a message are squashed into blocks of `decode_rows_limit` rows, the remaining rows
+        // are flushed at the end of the message so that each message is decoded independently. The
+        // consumers squash the small blocks across messages, see `decodeChunks`.
+        // If decoding fails, the message is left undecoded and the consumer will decode it again and
+        // report the error.
+        if (recv_msg->getErrorPtr() == nullptr && !recv_msg->getChunks(0).empty())
+        {
+            try
+            {
+                std::queue<Block> block_queue;
+                decodeChunks(0, recv_msg, block_queue, decoder);
+                std::vector<Block> blocks;
+                blocks.reserve(block_queue.size() + 1);
+                for (; !block_queue.empty(); block_queue.pop())
+                    blocks.push_back(std::move(block_queue.front()));
+                if (auto last = decoder->flush(); last && last->rows() > 0)
+                    blocks.push_back(std::move(*last));
+                recv_msg->setDecodedBlocks(std::move(blocks));
+            }
+            catch (...)
+            {
+                tryLogCurrentException(exc_log, "decode received message failed");
+                decoder = std::make_unique<CHBlockChunkDecodeAndSquash>(header, decode_rows_limit);
+            }
+        }
+
+        const auto message_bytes = DecodedMessageQueue::getMessageBytes(recv_msg);
+        ExchangeReceiverMetric::addDataSizeMetric(data_size_in_queue, message_bytes);
+        push_result = decoded_message_queue->push(std::move(recv_msg));
+        if (push_result != MPMCQueueResult::OK)
+        {
+            ExchangeReceiverMetric::subDataSizeMetric(data_size_in_queue, message_bytes);
+            break;
+        }
+    }
+
+    // The last decoder finishes the decoded queue after all the received messages are decoded.
+    if (live_decoders.fetch_sub(1) == 1)
+    {
+        if (pop_result == MPMCQueueResult::CANCELLED || push_result == MPMCQueueResult::CANCELLED)
+            decoded_message_queue->cancel();
+        else
+            decoded_message_queue->finish();
+    }
+}
+
 template <typename RPCContext>
 DecodeDetail ExchangeReceiverBase<RPCContext>::decodeChunks(
     size_t stream_id,
@@ -728,6 +831,21 @@ DecodeDetail ExchangeReceiverBase<RPCContext>::decodeChunks(
     assert(recv_msg != nullptr);
     DecodeDetail detail;
 
+    if (recv_msg->isDecoded())
+    {
+        // The decode threads squash the blocks within a message, squash them across messages here.
+        detail.packet_bytes = recv_msg->getPacket().ByteSizeLong();
+        for (auto & block : recv_msg->getDecodedBlocks())
+        {
+            auto result = decoder_ptr->squash(std::move(block));
+            if (!result)
+                continue;
+            detail.rows += result->rows();
+            block_queue.push(std::move(*result));
+        }
+        return detail;
+    }
+
     const auto & chunks = recv_msg->getChunks(stream_id);
     if (chunks.empty())
         return detail;
@@ -803,6 +921,15 @@ template <typename RPCContext>
 ReceiveStatus ExchangeReceiverBase<RPCContext>::receive(size_t stream_id, ReceivedMessagePtr & recv_msg)
 {
     verifyStreamId(stream_id);
+    if (decoded_message_queue)
+    {
+        auto res = decoded_message_queue->pop(recv_msg);
+        if (res == MPMCQueueResult::OK)
+            ExchangeReceiverMetric::subDataSizeMetric(
+                data_size_in_queue,
+                DecodedMessageQueue::getMessageBytes(recv_msg));
+        return toReceiveStatus(res);
+    }
     return toReceiveStatus(received_message_queue.pop<true>(stream_id, recv_msg));
 }
 
@@ -810,6 +937,17 @@ template <typename RPCContext>
 ReceiveStatus ExchangeReceiverBase<RPCContext>::tryReceive(size_t stream_id, ReceivedMessagePtr & recv_msg)
 {
     // verifyStreamId has been called in `ExchangeReceiverSourceOp`.
+    if (decoded_message_queue)
+    {
+        auto res = decoded_message_queue->tryPop(recv_msg);
+        if (res == MPMCQueueResult::OK)
+            ExchangeReceiverMetric::subDataSizeMetric(
+                data_size_in_queue,
+                DecodedMessageQueue::getMessageBytes(recv_msg));
+        else if (res == MPMCQueueResult::EMPTY)
+            setNotifyFuture(decoded_message_queue.get());
+        return toReceiveStatus(res);
+    }
     return toReceiveStatus(received_message_queue.pop<false>(stream_id, recv_msg));
 }
 
@@ -1036,6 +1174,8 @@ template <typename RPCContext>
 void ExchangeReceiverBase<RPCContext>::cancelReceivedQueue()
 {
     received_message_queue.cancel();
+    if (decoded_message_queue)
+        decoded_message_queue->cancel();
 }
 
 /// Explicit template instantiations - to avoid code bloat in headers.
@@ -151,6 +151,8 @@ private:
 
     void readLoop(const Request & req);
 
+    void decodeLoop();
+
     void reactor(const std::vector<Request> & async_requests);
 
     void setUpConnection();
@@ -195,8 +197,11 @@ private:
 
     void setUpConnectionWithReadLoop(Request && req);
     void setUpLocalConnections(std::vector<Request> & requests, bool has_remote_conn);
+    void setUpDecoders(const CapacityLimits & queue_limits);
 
+#ifndef DBMS_PUBLIC_GTEST
 private:
+#endif
     LoggerPtr exc_log;
 
     std::shared_ptr<RPCContext> rpc_context;
@@ -212,6 +217,16 @@ private:
 
     ReceivedMessageQueue received_message_queue;
 
+    /// The number of threads decoding the received messages before they are popped by the consumers,
+    /// 0 means the consumers decode the messages by themselves.
+    const size_t decode_concurrency;
+    /// The rows limit of the blocks squashed by the decode threads
+    const size_t decode_rows_limit;
+    /// The messages decoded by the decode threads, only used when decode_concurrency > 0.
+    /// It shares `max_buffered_bytes_in_executor` with `received_message_queue`.
+    std::unique_ptr<DecodedMessageQueue> decoded_message_queue;
+    std::atomic<size_t> live_decoders{0};
+
     std::vector<std::unique_ptr<AsyncRequestHandler<RPCContext>>> async_handler_ptrs;
 
     std::mutex mu;
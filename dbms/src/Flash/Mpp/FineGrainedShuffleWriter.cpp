@@ -36,7 +36,8 @@ FineGrainedShuffleWriter<ExchangeWriterPtr>::FineGrainedShuffleWriter(
     uint64_t fine_grained_shuffle_stream_count_,
     UInt64 fine_grained_shuffle_batch_size_,
     MPPDataPacketVersion data_codec_version_,
-    tipb::CompressionMode compression_mode_)
+    tipb::CompressionMode compression_mode_,
+    PartitionSkewDetectorPtr skew_detector_)
     : DAGResponseWriter(/*records_per_chunk=*/-1, dag_context_)
     , writer(writer_)
     , partition_col_ids(std::move(partition_col_ids_))
@@ -46,6 +47,7 @@ FineGrainedShuffleWriter<ExchangeWriterPtr>::FineGrainedShuffleWriter(
     , hash(0)
     , data_codec_version(data_codec_version_)
     , compression_method(ToInternalCompressionMethod(compression_mode_))
+    , skew_detector(std::move(skew_detector_))
 {
     max_buffered_rows = fine_grained_shuffle_batch_size * fine_grained_shuffle_stream_count;
     max_buffered_bytes = max_buffered_bytes_;
@@ -207,6 +209,8 @@ void FineGrainedShuffleWriter<ExchangeWriterPtr>::batchWriteFineGrainedShuffleIm
                     hash,
                     selector,
                     scattered);
+            if (skew_detector)
+                skew_detector->sample(hash);
             block.clear();
         }
         blocks.clear();
@@ -16,6 +16,7 @@
 
 #include <Flash/Coprocessor/ChunkCodec.h>
 #include <Flash/Coprocessor/DAGResponseWriter.h>
+#include <Flash/Mpp/PartitionSkewDetector.h>
 #include <Flash/Mpp/TrackedMppDataPacket.h>
 #include <common/types.h>
 
@@ -38,7 +39,8 @@ public:
         UInt64 fine_grained_shuffle_stream_count_,
         UInt64 fine_grained_shuffle_batch_size,
         MPPDataPacketVersion data_codec_version_,
-        tipb::CompressionMode compression_mode_);
+        tipb::CompressionMode compression_mode_,
+        PartitionSkewDetectorPtr skew_detector_ = nullptr);
     void prepare(const Block & sample_block) override;
     WaitResult waitForWritable() const override;
     WriteResult write(const Block & block) override;
@@ -72,6 +74,8 @@ private:
     DataTypes expected_types;
     MPPDataPacketVersion data_codec_version;
     CompressionMethod compression_method{};
+    // Detect the hot partition keys in the first rows, nullptr if disabled
+    PartitionSkewDetectorPtr skew_detector;
 };
 
 } // namespace DB
@@ -17,6 +17,7 @@
 #include <Flash/Coprocessor/GenSchemaAndColumn.h>
 #include <Flash/Mpp/GRPCCompletionQueuePool.h>
 #include <Flash/Mpp/GRPCReceiverContext.h>
+#include <Flash/Mpp/ShmTransport.h>
 #include <Flash/Statistics/ConnectionProfileInfo.h>
 #include <fmt/core.h>
 #include <grpcpp/completion_queue.h>
@@ -51,6 +52,35 @@ struct GrpcExchangePacketReader : public ExchangePacketReader
     void cancel(const String &) override {}
 };
 
+/// Reads the packets from a shared memory ring buffer if the sender accepts it, otherwise from the gRPC stream.
+struct ShmExchangePacketReader : public ExchangePacketReader
+{
+    grpc::ClientContext client_context;
+    std::unique_ptr<grpc::ClientReader<mpp::MPPDataPacket>> reader;
+    // Declared after `reader` to be destroyed first, which tells the sender to stop writing.
+    ShmRingBufferPtr ring;
+
+    bool read(TrackedMppDataPacketPtr & packet) override
+    {
+        if (ring == nullptr)
+            return packet->read(reader);
+
+        if (!ShmTransport::readPacket(*ring, packet->getPacket()))
+            return false;
+        packet->mem_tracker_wrapper.freeAll();
+        packet->mem_tracker_wrapper.alloc(estimateAllocatedSize(packet->getPacket()));
+        return true;
+    }
+
+    grpc::Status finish() override { return reader->Finish(); }
+
+    void cancel(const String &) override
+    {
+        if (ring != nullptr)
+            ring->cancelRead();
+    }
+};
+
 struct AsyncGrpcExchangePacketReader : public AsyncExchangePacketReader
 {
     pingcap::kv::Cluster * cluster;
@@ -98,13 +128,15 @@ GRPCReceiverContext::GRPCReceiverContext(
     pingcap::kv::Cluster * cluster_,
     std::shared_ptr<MPPTaskManager> task_manager_,
     bool enable_local_tunnel_,
-    bool enable_async_grpc_)
+    bool enable_async_grpc_,
+    bool enable_shm_transport_)
     : exchange_receiver_meta(exchange_receiver_meta_)
     , task_meta(task_meta_)
     , cluster(cluster_)
     , task_manager(std::move(task_manager_))
     , enable_local_tunnel(enable_local_tunnel_)
     , enable_async_grpc(enable_async_grpc_)
+    , enable_shm_transport(enable_shm_transport_)
 {
     conn_type_vec.resize(exchange_receiver_meta.encoded_task_meta_size(), ConnectionProfileInfo::Local);
 }
@@ -119,6 +151,7 @@ ExchangeRecvRequest GRPCReceiverContext::makeRequest(int index) const
     ExchangeRecvRequest req;
     req.source_index = index;
     req.is_local = enable_local_tunnel && sender_task->address() == task_meta.address();
+    req.is_shm = enable_shm_transport && !req.is_local && ShmTransport::isSameHostPeer(sender_task->address());
     req.send_task_id = sender_task->task_id();
     req.recv_task_id = task_meta.task_id();
     req.req.set_allocated_receiver_meta(new mpp::TaskMeta(task_meta)); // NOLINT
@@ -141,7 +174,9 @@ ExchangeRecvRequest GRPCReceiverContext::makeRequest(int index) const
 
 bool GRPCReceiverContext::supportAsync(const ExchangeRecvRequest & request) const
 {
-    return enable_async_grpc && !request.is_local;
+    // The shared memory ring buffer is read in the sync way. It is only requested when the async server is off,
+    // see `FlashService::createDBContext`.
+    return enable_async_grpc && !request.is_local && !request.is_shm;
 }
 
 void GRPCReceiverContext::establishMPPConnectionLocalV2(
@@ -241,16 +276,28 @@ ExchangePacketReaderPtr GRPCReceiverContext::makeReader(const ExchangeRecvReques
     }
     else
     {
-        RpcCallEstablishMPPConnection rpc(cluster->rpc_client, request.req.sender_meta().address());
-        auto reader = std::make_unique<GrpcExchangePacketReader>();
-        reader->reader = rpc.call(&reader->client_context, request.req);
-        return reader;
+        return makeSyncReader(request);
     }
 }
 
 ExchangePacketReaderPtr GRPCReceiverContext::makeSyncReader(const ExchangeRecvRequest & request) const
 {
     RpcCallEstablishMPPConnection rpc(cluster->rpc_client, request.req.sender_meta().address());
+    if (request.is_shm)
+    {
+        auto reader = std::make_unique<ShmExchangePacketReader>();
+        auto log = Logger::get(fmt::format("tunnel{}+{}", request.send_task_id, request.recv_task_id));
+        reader->ring = ShmTransport::tryRequest(reader->client_context, log);
+        reader->reader = rpc.call(&reader->client_context, request.req);
+        if (reader->ring != nullptr)
+        {
+            reader->reader->WaitForInitialMetadata();
+            if (!ShmTransport::isAccepted(reader->client_context, *reader->ring))
+                reader->ring.reset();
+        }
+        return reader;
+    }
+
     auto reader = std::make_unique<GrpcExchangePacketReader>();
     reader->reader = rpc.call(&reader->client_context, request.req);
     return reader;
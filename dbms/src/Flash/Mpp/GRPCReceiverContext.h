@@ -62,6 +62,8 @@ struct ExchangeRecvRequest
     Int64 recv_task_id = -2;
     mpp::EstablishMPPConnectionRequest req;
     bool is_local = false;
+    // The sender is another process on the same host, try to receive through shared memory.
+    bool is_shm = false;
 
     String debugString() const;
 };
@@ -80,7 +82,8 @@ public:
         pingcap::kv::Cluster * cluster_,
         std::shared_ptr<MPPTaskManager> task_manager_,
         bool enable_local_tunnel_,
-        bool enable_async_grpc_);
+        bool enable_async_grpc_,
+        bool enable_shm_transport_);
 
     ExchangeRecvRequest makeRequest(int index) const;
 
@@ -119,5 +122,6 @@ private:
     std::shared_ptr<MPPTaskManager> task_manager;
     bool enable_local_tunnel;
     bool enable_async_grpc;
+    bool enable_shm_transport;
 };
 } // namespace DB
@@ -14,6 +14,7 @@
 
 #include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Mpp/HashBaseWriterHelper.h>
+#include <Flash/Mpp/PartitionSkewDetector.h>
 #include <TiDB/Decode/TypeMapping.h>
 
 namespace DB::HashBaseWriterHelper
@@ -147,13 +148,16 @@ void scatterColumns(
     const TiDB::TiDBCollators & collators,
     std::vector<String> & partition_key_containers,
     uint32_t bucket_num,
-    std::vector<std::vector<MutableColumnPtr>> & result_columns)
+    std::vector<std::vector<MutableColumnPtr>> & result_columns,
+    PartitionSkewDetector * skew_detector)
 {
     if unlikely (input_block.rows() == 0)
         return;
 
     WeakHash32 hash(0);
     computeHash(input_block, partition_col_ids, collators, partition_key_containers, hash);
+    if (skew_detector)
+        skew_detector->sample(hash);
 
     IColumn::Selector selector;
     fillSelector(input_block.rows(), hash, bucket_num, selector);
@@ -177,12 +181,15 @@ void scatterColumnsSelectiveBlock(
     const TiDB::TiDBCollators & collators,
     std::vector<String> & partition_key_containers,
     uint32_t bucket_num,
-    std::vector<std::vector<MutableColumnPtr>> & result_columns)
+    std::vector<std::vector<MutableColumnPtr>> & result_columns,
+    PartitionSkewDetector * skew_detector)
 {
     RUNTIME_CHECK(input_block.info.selective && !input_block.info.selective->empty());
 
     WeakHash32 hash(0);
     computeHashSelectiveBlock(input_block, partition_col_ids, collators, partition_key_containers, hash);
+    if (skew_detector)
+        skew_detector->sample(hash);
 
     IColumn::Selector selector;
     fillSelector(input_block.info.selective->size(), hash, bucket_num, selector);
@@ -18,6 +18,11 @@
 #include <Flash/Mpp/TrackedMppDataPacket.h>
 #include <TiDB/Collation/Collator.h>
 
+namespace DB
+{
+class PartitionSkewDetector;
+} // namespace DB
+
 namespace DB::HashBaseWriterHelper
 {
 void materializeBlock(Block & input_block);
@@ -54,7 +59,8 @@ void scatterColumns(
     const TiDB::TiDBCollators & collators,
     std::vector<String> & partition_key_containers,
     uint32_t bucket_num,
-    std::vector<std::vector<MutableColumnPtr>> & result_columns);
+    std::vector<std::vector<MutableColumnPtr>> & result_columns,
+    PartitionSkewDetector * skew_detector = nullptr);
 
 void scatterColumnsSelectiveBlock(
     const Block & input_block,
@@ -62,7 +68,8 @@ void scatterColumnsSelectiveBlock(
     const TiDB::TiDBCollators & collators,
     std::vector<String> & partition_key_containers,
     uint32_t bucket_num,
-    std::vector<std::vector<MutableColumnPtr>> & result_columns);
+    std::vector<std::vector<MutableColumnPtr>> & result_columns,
+    PartitionSkewDetector * skew_detector = nullptr);
 
 void scatterColumnsForFineGrainedShuffle(
     const Block & block,
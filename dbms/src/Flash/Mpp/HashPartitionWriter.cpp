@@ -34,13 +34,15 @@ HashPartitionWriter<ExchangeWriterPtr>::HashPartitionWriter(
     UInt64 max_buffered_bytes_,
     DAGContext & dag_context_,
     MPPDataPacketVersion data_codec_version_,
-    tipb::CompressionMode compression_mode_)
+    tipb::CompressionMode compression_mode_,
+    PartitionSkewDetectorPtr skew_detector_)
     : DAGResponseWriter(/*records_per_chunk=*/-1, dag_context_)
     , writer(writer_)
     , partition_col_ids(std::move(partition_col_ids_))
     , collators(std::move(collators_))
     , data_codec_version(data_codec_version_)
     , compression_method(ToInternalCompressionMethod(compression_mode_))
+    , skew_detector(std::move(skew_detector_))
 {
     partition_num = writer_->getPartitionNum();
     RUNTIME_CHECK(partition_num > 0);
@@ -163,7 +165,8 @@ void HashPartitionWriter<ExchangeWriterPtr>::partitionAndWriteBlocksV1()
                 collators,
                 partition_key_containers,
                 partition_num,
-                dest_tbl_cols);
+                dest_tbl_cols,
+                skew_detector.get());
         else
             HashBaseWriterHelper::scatterColumns(
                 block,
@@ -171,7 +174,8 @@ void HashPartitionWriter<ExchangeWriterPtr>::partitionAndWriteBlocksV1()
                 collators,
                 partition_key_containers,
                 partition_num,
-                dest_tbl_cols);
+                dest_tbl_cols,
+                skew_detector.get());
         block.clear();
 
         for (size_t part_id = 0; part_id < partition_num; ++part_id)
@@ -225,7 +229,8 @@ void HashPartitionWriter<ExchangeWriterPtr>::partitionAndWriteBlocks()
                     collators,
                     partition_key_containers,
                     partition_num,
-                    dest_tbl_cols);
+                    dest_tbl_cols,
+                    skew_detector.get());
             else
                 HashBaseWriterHelper::scatterColumns(
                     block,
@@ -233,7 +238,8 @@ void HashPartitionWriter<ExchangeWriterPtr>::partitionAndWriteBlocks()
                     collators,
                     partition_key_containers,
                     partition_num,
-                    dest_tbl_cols);
+                    dest_tbl_cols,
+                    skew_detector.get());
 
             blocks.pop_back();
 
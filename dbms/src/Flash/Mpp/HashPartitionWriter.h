@@ -16,6 +16,7 @@
 
 #include <Flash/Coprocessor/ChunkCodec.h>
 #include <Flash/Coprocessor/DAGResponseWriter.h>
+#include <Flash/Mpp/PartitionSkewDetector.h>
 #include <Flash/Mpp/TrackedMppDataPacket.h>
 #include <common/types.h>
 
@@ -37,7 +38,8 @@ public:
         UInt64 max_buffered_bytes_,
         DAGContext & dag_context_,
         MPPDataPacketVersion data_codec_version_,
-        tipb::CompressionMode compression_mode_);
+        tipb::CompressionMode compression_mode_,
+        PartitionSkewDetectorPtr skew_detector_ = nullptr);
     WaitResult waitForWritable() const override;
     WriteResult write(const Block & block) override;
     WriteResult flush() override;
@@ -55,6 +57,8 @@ private:
     DataTypes expected_types;
     MPPDataPacketVersion data_codec_version;
     CompressionMethod compression_method{};
+    // Detect the hot partition keys in the first rows, nullptr if disabled
+    PartitionSkewDetectorPtr skew_detector;
 };
 
 } // namespace DB
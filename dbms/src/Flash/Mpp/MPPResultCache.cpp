@@ -0,0 +1,382 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/MemoryTracker.h>
+#include <Common/SipHash.h>
+#include <Common/TiFlashMetrics.h>
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Mpp/MPPResultCache.h>
+#include <Flash/Mpp/MPPTunnelSet.h>
+#include <Flash/Mpp/TrackedMppDataPacket.h>
+#include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/KVStore/TMTContext.h>
+#include <Storages/StorageDeltaMerge.h>
+#include <common/logger_useful.h>
+#include <google/protobuf/message.h>
+#include <tipb/executor.pb.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace
+{
+bool isNonDeterministic(tipb::ScalarFuncSig sig)
+{
+    switch (sig)
+    {
+    case tipb::ScalarFuncSig::Rand:
+    case tipb::ScalarFuncSig::SysDateWithFsp:
+    case tipb::ScalarFuncSig::SysDateWithoutFsp:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Walks all the executors and expressions in the plan, returns false if the result of the plan can not be cached.
+bool checkPlan(const google::protobuf::Message & msg, std::vector<TableID> & scanned_table_ids)
+{
+    if (const auto * executor = dynamic_cast<const tipb::Executor *>(&msg); executor != nullptr)
+    {
+        switch (executor->tp())
+        {
+        case tipb::ExecType::TypeExchangeReceiver:
+        case tipb::ExecType::TypeCTESource:
+        case tipb::ExecType::TypeCTESink:
+            return false;
+        case tipb::ExecType::TypeTableScan:
+            scanned_table_ids.push_back(executor->tbl_scan().table_id());
+            break;
+        default:
+            break;
+        }
+    }
+    else if (const auto * expr = dynamic_cast<const tipb::Expr *>(&msg); expr != nullptr)
+    {
+        if (expr->tp() == tipb::ExprType::ScalarFunc && isNonDeterministic(expr->sig()))
+            return false;
+    }
+
+    const auto * reflection = msg.GetReflection();
+    std::vector<const google::protobuf::FieldDescriptor *> fields;
+    reflection->ListFields(msg, &fields);
+    for (const auto * field : fields)
+    {
+        if (field->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
+            continue;
+        if (field->is_repeated())
+        {
+            for (int i = 0; i < reflection->FieldSize(msg, field); ++i)
+            {
+                if (!checkPlan(reflection->GetRepeatedMessage(msg, field, i), scanned_table_ids))
+                    return false;
+            }
+        }
+        else if (!checkPlan(reflection->GetMessage(msg, field), scanned_table_ids))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void appendBinary(String & s, T value)
+{
+    s.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+} // namespace
+
+MPPResultCache::MPPResultCache(size_t max_bytes)
+    : max_entry_bytes(std::max<size_t>(max_bytes / 8, 1))
+    , cache(max_bytes)
+{}
+
+MPPResultCache::EntryPtr MPPResultCache::get(const String & key, UInt64 read_tso)
+{
+    auto entry = cache.get(key);
+    if (entry == nullptr || entry->max_write_version > std::min(entry->read_tso, read_tso))
+        return nullptr;
+    return entry;
+}
+
+void MPPResultCache::set(const String & key, const EntryPtr & entry)
+{
+    cache.set(key, entry);
+}
+
+std::optional<String> MPPResultCache::digestPlan(
+    const tipb::DAGRequest & dag_req,
+    const mpp::DispatchTaskRequest & task_request,
+    std::vector<TableID> & scanned_table_ids)
+{
+    if (!dag_req.has_root_executor() || !dag_req.root_executor().has_exchange_sender())
+        return std::nullopt;
+    if (!checkPlan(dag_req, scanned_table_ids))
+        return std::nullopt;
+
+    tipb::DAGRequest canonical_req = dag_req;
+    canonical_req.clear_start_ts_fallback();
+    auto * exchange_sender = canonical_req.mutable_root_executor()->mutable_exchange_sender();
+    const auto receiver_num = exchange_sender->encoded_task_meta_size();
+    exchange_sender->clear_encoded_task_meta();
+
+    mpp::DispatchTaskRequest regions_req;
+    *regions_req.mutable_regions() = task_request.regions();
+    *regions_req.mutable_table_regions() = task_request.table_regions();
+
+    SipHash hash;
+    hash.update(canonical_req.SerializeAsString());
+    hash.update(receiver_num);
+    hash.update(regions_req.SerializeAsString());
+    hash.update(task_request.schema_ver());
+    hash.update(task_request.meta().mpp_version());
+    String digest(16, '\0');
+    hash.get128(digest.data());
+    return digest;
+}
+
+MPPResultRecorder::MPPResultRecorder(size_t max_bytes_, size_t tunnel_num, MemoryTracker * memory_tracker_)
+    : max_bytes(max_bytes_)
+    , memory_tracker(memory_tracker_)
+    , buffers(tunnel_num)
+{}
+
+MPPResultRecorder::~MPPResultRecorder()
+{
+    if (memory_tracker != nullptr)
+        memory_tracker->free(tracked_bytes.load());
+}
+
+void MPPResultRecorder::record(size_t index, const mpp::MPPDataPacket & packet)
+{
+    assert(index < buffers.size());
+    if (overflow.load(std::memory_order_relaxed))
+        return;
+    // The size of the data is enough for the limit, `ByteSizeLong` walks all the fields of the packet
+    const size_t size = estimateAllocatedSize(packet);
+    if (bytes.fetch_add(size, std::memory_order_relaxed) + size > max_bytes)
+    {
+        // The result will not be cached, release the recorded packets now
+        if (!overflow.exchange(true))
+        {
+            for (auto & buffer : buffers)
+            {
+                std::lock_guard lock(buffer.mu);
+                buffer.packets = {};
+            }
+            if (memory_tracker != nullptr)
+                memory_tracker->free(tracked_bytes.exchange(0));
+        }
+        return;
+    }
+    // The copy is an optional cache entry, do not fail the query for it
+    if (memory_tracker != nullptr)
+    {
+        memory_tracker->alloc(size, /*check_memory_limit*/ false);
+        tracked_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    auto & buffer = buffers[index];
+    std::lock_guard lock(buffer.mu);
+    buffer.packets.push_back(packet);
+}
+
+MPPResultCache::EntryPtr MPPResultRecorder::finish()
+{
+    if (overflow.load())
+        return nullptr;
+    auto entry = std::make_shared<MPPResultCache::Entry>();
+    entry->bytes = bytes.load();
+    size_t packet_num = 0;
+    for (const auto & buffer : buffers)
+        packet_num += buffer.packets.size();
+    entry->packets.reserve(packet_num);
+    for (size_t index = 0; index < buffers.size(); ++index)
+    {
+        std::lock_guard lock(buffers[index].mu);
+        for (auto & packet : buffers[index].packets)
+            entry->packets.emplace_back(static_cast<UInt16>(index), std::move(packet));
+        buffers[index].packets = {};
+    }
+    // The packets belong to the cache from now on
+    if (memory_tracker != nullptr)
+        memory_tracker->free(tracked_bytes.exchange(0));
+    return entry;
+}
+
+MPPTaskResultCachePtr MPPTaskResultCache::create(
+    const Context & context,
+    const DAGContext & dag_context,
+    const tipb::DAGRequest & dag_req,
+    const mpp::DispatchTaskRequest & task_request,
+    const LoggerPtr & log)
+{
+    auto cache = context.getGlobalContext().getMPPResultCache();
+    if (cache == nullptr)
+        return nullptr;
+
+    std::vector<TableID> table_ids;
+    auto plan_digest = MPPResultCache::digestPlan(dag_req, task_request, table_ids);
+    if (!plan_digest)
+    {
+        GET_METRIC(tiflash_mpp_result_cache, type_uncacheable).Increment();
+        return nullptr;
+    }
+    // The table scan of a partition table reads the physical tables in `table_regions`.
+    for (const auto & [table_id, regions] : dag_context.tables_regions_info.getTableRegionsInfoMap())
+    {
+        if (table_id != InvalidTableID)
+            table_ids.push_back(table_id);
+    }
+    std::sort(table_ids.begin(), table_ids.end());
+    table_ids.erase(std::unique(table_ids.begin(), table_ids.end()), table_ids.end());
+    if (table_ids.empty())
+        return nullptr;
+
+    return std::make_unique<MPPTaskResultCache>(
+        context,
+        cache,
+        std::move(*plan_digest),
+        std::move(table_ids),
+        dag_context.getKeyspaceID(),
+        task_request.meta().start_ts(),
+        log);
+}
+
+MPPTaskResultCache::MPPTaskResultCache(
+    const Context & context_,
+    const MPPResultCachePtr & cache_,
+    String && plan_digest_,
+    std::vector<TableID> && table_ids_,
+    KeyspaceID keyspace_id_,
+    UInt64 read_tso_,
+    const LoggerPtr & log_)
+    : context(context_)
+    , cache(cache_)
+    , plan_digest(std::move(plan_digest_))
+    , table_ids(std::move(table_ids_))
+    , keyspace_id(keyspace_id_)
+    , read_tso(read_tso_)
+    , log(log_)
+{}
+
+std::optional<MPPTaskResultCache::TableVersions> MPPTaskResultCache::captureVersions(bool resolve) const
+{
+    auto & tmt = context.getTMTContext();
+    TableVersions versions;
+    versions.reserve(table_ids.size());
+    std::vector<std::pair<DM::DeltaMergeStorePtr, UInt64>> unresolved_stores;
+    for (auto table_id : table_ids)
+    {
+        auto storage = std::dynamic_pointer_cast<StorageDeltaMerge>(tmt.getStorages().get(keyspace_id, table_id));
+        auto store = storage != nullptr ? storage->getStoreIfInited() : nullptr;
+        if (store == nullptr)
+            return std::nullopt;
+        auto data_version = store->getDataVersion();
+        // The store is created before the cache is enabled
+        if (!data_version.tracked)
+            return std::nullopt;
+        if (resolve && data_version.unresolved_seq != 0)
+            unresolved_stores.emplace_back(store, data_version.unresolved_seq);
+        versions.push_back(TableVersion{
+            .table_id = table_id,
+            .version = data_version.version,
+            .max_write_version = data_version.max_write_version,
+            .unresolved_seq = data_version.unresolved_seq,
+            .changing = data_version.changing,
+        });
+    }
+    if (unresolved_stores.empty())
+        return versions;
+
+    // The rows of unknown versions are committed before they are restored or ingested, so they are
+    // older than a ts allocated now.
+    auto ts = tmt.getPDClient()->getTS();
+    for (const auto & [store, unresolved_seq] : unresolved_stores)
+        store->resolveMaxWriteVersion(unresolved_seq, ts);
+    return captureVersions(false);
+}
+
+void MPPTaskResultCache::beforeRead()
+{
+    versions_before_read = captureVersions(true);
+}
+
+MPPResultCache::EntryPtr MPPTaskResultCache::lookup(DAGContext & dag_context, MPPTunnelSet & tunnel_set)
+{
+    // The regions that are not available locally are read from other nodes, whose data versions are unknown.
+    if (!versions_before_read || !dag_context.getCoprocessorReaders().empty())
+    {
+        GET_METRIC(tiflash_mpp_result_cache, type_uncacheable).Increment();
+        return nullptr;
+    }
+    auto versions = captureVersions(false);
+    if (versions != versions_before_read)
+    {
+        LOG_DEBUG(log, "The data is changed during reading, skip the result cache");
+        GET_METRIC(tiflash_mpp_result_cache, type_uncacheable).Increment();
+        return nullptr;
+    }
+
+    key = plan_digest;
+    appendBinary(key, keyspace_id);
+    for (const auto & table_version : *versions)
+    {
+        if (table_version.unresolved_seq != 0 || table_version.changing)
+        {
+            GET_METRIC(tiflash_mpp_result_cache, type_uncacheable).Increment();
+            return nullptr;
+        }
+        appendBinary(key, table_version.table_id);
+        appendBinary(key, table_version.version);
+        max_write_version = std::max(max_write_version, table_version.max_write_version);
+    }
+
+    if (auto entry = cache->get(key, read_tso); entry != nullptr)
+    {
+        GET_METRIC(tiflash_mpp_result_cache, type_hit).Increment();
+        LOG_DEBUG(log, "Hit the result cache, packets={} bytes={}", entry->packets.size(), entry->bytes);
+        return entry;
+    }
+    GET_METRIC(tiflash_mpp_result_cache, type_miss).Increment();
+    // If some rows are invisible to the read ts, the result can not be reused by any other read ts.
+    if (max_write_version <= read_tso)
+    {
+        recorder = std::make_shared<MPPResultRecorder>(
+            cache->getMaxEntryBytes(),
+            tunnel_set.getTunnels().size(),
+            current_memory_tracker);
+        tunnel_set.setResultRecorder(recorder);
+    }
+    return nullptr;
+}
+
+void MPPTaskResultCache::finish(const MPPTunnelSet & tunnel_set)
+{
+    if (recorder == nullptr)
+        return;
+    auto entry = recorder->finish();
+    if (entry == nullptr)
+        return;
+    for (const auto & tunnel : tunnel_set.getTunnels())
+        entry->sent_rows.push_back(tunnel->getSentRows());
+    entry->read_tso = read_tso;
+    entry->max_write_version = max_write_version;
+    cache->set(key, entry);
+    GET_METRIC(tiflash_mpp_result_cache, type_insert).Increment();
+    LOG_DEBUG(log, "Insert the result cache, packets={} bytes={}", entry->packets.size(), entry->bytes);
+}
+} // namespace DB
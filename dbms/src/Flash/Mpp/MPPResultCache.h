@@ -0,0 +1,193 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/LRUCache.h>
+#include <Common/Logger.h>
+#include <Storages/KVStore/Types.h>
+#include <common/types.h>
+#include <kvproto/mpp.pb.h>
+#include <tipb/select.pb.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace DB
+{
+class Context;
+class DAGContext;
+class MemoryTracker;
+class MPPTunnelSet;
+
+/// MPPResultCache caches the packets written by the leaf MPP tasks (the tasks that only read tables), so that
+/// a dashboard query repeated on unchanged tables is answered by replaying the packets instead of scanning
+/// and computing again.
+///
+/// The key is the digest of the plan and the regions to read, together with the data versions of the read
+/// tables (see `DeltaMergeStore::DataVersion`). So any write, delete range or ingest on the tables makes the
+/// old entries unreachable, and they are evicted by LRU.
+class MPPResultCache
+{
+public:
+    struct Entry
+    {
+        /// The packets in the order they are written, with the index of the tunnel they are written to.
+        std::vector<std::pair<UInt16, mpp::MPPDataPacket>> packets;
+        /// The rows sent to each tunnel, replayed for the execution summary and the task statistics.
+        std::vector<Int64> sent_rows;
+        size_t bytes = 0;
+        /// The read ts of the task that generated this entry.
+        UInt64 read_tso = 0;
+        /// An upper bound of the versions of the rows in the read tables when this entry is generated.
+        UInt64 max_write_version = 0;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    explicit MPPResultCache(size_t max_bytes);
+
+    /// The entry can be reused by `read_tso` only if all the rows are visible to both the read ts of the
+    /// entry and `read_tso`, otherwise the results of the two read ts may be different.
+    EntryPtr get(const String & key, UInt64 read_tso);
+
+    void set(const String & key, const EntryPtr & entry);
+
+    /// The results larger than this are not cached, so that a single big result does not flush the cache.
+    size_t getMaxEntryBytes() const { return max_entry_bytes; }
+
+    /// Returns std::nullopt if the result of the plan can not be cached, e.g. the plan receives data from
+    /// other tasks or calls non-deterministic functions. The read ts and the addresses of the receivers are
+    /// not included in the digest, the number of receivers is. The ids of the tables read by TableScan are
+    /// appended to `scanned_table_ids`.
+    static std::optional<String> digestPlan(
+        const tipb::DAGRequest & dag_req,
+        const mpp::DispatchTaskRequest & task_request,
+        std::vector<TableID> & scanned_table_ids);
+
+private:
+    struct EntryWeight
+    {
+        size_t operator()(const String & key, const Entry & entry) const { return key.size() + entry.bytes; }
+    };
+
+    const size_t max_entry_bytes;
+    LRUCache<String, Entry, std::hash<String>, EntryWeight> cache;
+};
+
+using MPPResultCachePtr = std::shared_ptr<MPPResultCache>;
+
+/// Records the packets written to MPPTunnelSet. Thread safe, because the packets may be written by
+/// multiple threads. The packets of each tunnel are recorded into their own buffer, so the writers of
+/// different tunnels do not contend, and the buffers are merged by `finish`. The order of the packets
+/// written to the same tunnel is kept, which is all the receivers depend on.
+class MPPResultRecorder
+{
+public:
+    /// The recorded packets are tracked by `memory_tracker_` until they are handed over by `finish`.
+    MPPResultRecorder(size_t max_bytes_, size_t tunnel_num, MemoryTracker * memory_tracker_);
+
+    ~MPPResultRecorder();
+
+    void record(size_t index, const mpp::MPPDataPacket & packet);
+
+    /// Returns nullptr if the recorded packets exceed `max_bytes`.
+    MPPResultCache::EntryPtr finish();
+
+private:
+    struct TunnelBuffer
+    {
+        std::mutex mu;
+        std::vector<mpp::MPPDataPacket> packets;
+    };
+
+    const size_t max_bytes;
+    MemoryTracker * const memory_tracker;
+    std::vector<TunnelBuffer> buffers;
+    std::atomic<size_t> bytes{0};
+    std::atomic<bool> overflow{false};
+    /// The bytes allocated from `memory_tracker`.
+    std::atomic<size_t> tracked_bytes{0};
+};
+
+using MPPResultRecorderPtr = std::shared_ptr<MPPResultRecorder>;
+
+/// The result cache of a leaf MPPTask:
+/// 1. `beforeRead` captures the data versions of the read tables before the learner read.
+/// 2. `lookup` captures the data versions again after the snapshots are acquired. The result is cacheable
+///    only if the versions are not changed in between and no change is in progress, so the snapshots are
+///    consistent with the versions. Returns the cached entry if hit, otherwise a recorder is attached to the
+///    tunnel set.
+/// 3. `finish` inserts the recorded result after the task writes all its result successfully.
+class MPPTaskResultCache
+{
+public:
+    /// Returns nullptr if the cache is disabled or the result of the task can not be cached.
+    static std::unique_ptr<MPPTaskResultCache> create(
+        const Context & context,
+        const DAGContext & dag_context,
+        const tipb::DAGRequest & dag_req,
+        const mpp::DispatchTaskRequest & task_request,
+        const LoggerPtr & log);
+
+    MPPTaskResultCache(
+        const Context & context_,
+        const MPPResultCachePtr & cache_,
+        String && plan_digest_,
+        std::vector<TableID> && table_ids_,
+        KeyspaceID keyspace_id_,
+        UInt64 read_tso_,
+        const LoggerPtr & log_);
+
+    void beforeRead();
+
+    MPPResultCache::EntryPtr lookup(DAGContext & dag_context, MPPTunnelSet & tunnel_set);
+
+    void finish(const MPPTunnelSet & tunnel_set);
+
+private:
+    struct TableVersion
+    {
+        TableID table_id;
+        UInt64 version;
+        UInt64 max_write_version;
+        UInt64 unresolved_seq;
+        bool changing;
+
+        bool operator==(const TableVersion &) const = default;
+    };
+    using TableVersions = std::vector<TableVersion>;
+
+    /// Returns std::nullopt if the store of any table is not available. If `resolve` is true, the rows of
+    /// unknown versions are resolved with a ts allocated by PD.
+    std::optional<TableVersions> captureVersions(bool resolve) const;
+
+    const Context & context;
+    const MPPResultCachePtr cache;
+    const String plan_digest;
+    const std::vector<TableID> table_ids;
+    const KeyspaceID keyspace_id;
+    const UInt64 read_tso;
+    const LoggerPtr log;
+
+    std::optional<TableVersions> versions_before_read;
+    String key;
+    UInt64 max_write_version = 0;
+    MPPResultRecorderPtr recorder;
+};
+
+using MPPTaskResultCachePtr = std::unique_ptr<MPPTaskResultCache>;
+} // namespace DB
@@ -29,6 +29,7 @@
 #include <Flash/Mpp/GRPCReceiverContext.h>
 #include <Flash/Mpp/MPPTask.h>
 #include <Flash/Mpp/MPPTunnelSet.h>
+#include <Flash/Mpp/PlanMemoryHistory.h>
 #include <Flash/Mpp/Utils.h>
 #include <Flash/executeQuery.h>
 #include <Interpreters/Context.h>
@@ -239,6 +240,17 @@ void MPPTask::finishWrite()
     }
 }
 
+ExecutionResult MPPTask::replayCachedResult(const MPPResultCache::Entry & entry)
+{
+    /// The executors are built but not executed, the learner read and the lock checks are done in building.
+    for (const auto & [index, packet] : entry.packets)
+        tunnel_set->write(std::make_shared<TrackedMppDataPacket>(packet, getMemoryTracker()), index);
+    for (size_t i = 0; i < entry.sent_rows.size(); ++i)
+        tunnel_set->updateSentRows(entry.sent_rows[i], i);
+    GET_METRIC(tiflash_mpp_result_cache, type_hit_bytes).Increment(entry.bytes);
+    return ExecutionResult::success();
+}
+
 void MPPTask::run()
 {
     newThreadManager()->scheduleThenDetach(true, "MPPTask", [self = shared_from_this()] { self->runImpl(); });
@@ -343,7 +355,8 @@ bool MPPTask::initExchangeReceivers()
                         context->getTMTContext().getKVCluster(),
                         context->getTMTContext().getMPPTaskManager(),
                         context->getSettingsRef().enable_local_tunnel,
-                        context->getSettingsRef().enable_async_grpc_client),
+                        context->getSettingsRef().enable_async_grpc_client,
+                        context->getSettingsRef().enable_shm_transport),
                     executor.exchange_receiver().encoded_task_meta_size(),
                     context->getMaxStreams(),
                     log->identifier(),
@@ -548,6 +561,7 @@ void MPPTask::prepare(const mpp::DispatchTaskRequest & task_request)
     dag_context->tidb_host = context->getClientInfo().current_address.toString();
 
     context->setDAGContext(dag_context.get());
+    result_cache = MPPTaskResultCache::create(*context, *dag_context, dag_req, task_request, log);
 
     injectFailPointBeforeRegisterMPPTask(dag_context->isRootMPPTask());
     auto [result, reason] = manager->registerTask(this);
@@ -632,11 +646,24 @@ void MPPTask::runImpl()
     try
     {
         LOG_DEBUG(log, "task starts preprocessing");
+        if (result_cache)
+            result_cache->beforeRead();
         preprocess();
+        MPPResultCache::EntryPtr cached_result;
+        if (result_cache)
+            cached_result = result_cache->lookup(*dag_context, *tunnel_set);
         auto time_cost_in_preprocess_ns = stopwatch.elapsed();
         auto time_cost_in_preprocess_ms = time_cost_in_preprocess_ns / MILLISECOND_TO_NANO;
         LOG_DEBUG(log, "task preprocess done");
         schedule_entry.setNeededThreads(estimateCountOfNewThreads());
+        // The scheduler is created with the global settings, skip the estimation which takes the lock of the task
+        // manager if it does not limit the memory.
+        if (context->getGlobalContext().getSettingsRef().task_scheduler_memory_limit > 0)
+        {
+            auto plan_info = PlanMemoryHistory::analyzePlan(dag_context->dag_request);
+            plan_digest = plan_info.digest;
+            schedule_entry.setEstimatedMemory(manager->estimateTaskMemory(plan_info));
+        }
 
         // tunnel_set may be nullptr when we get cte sink
         int tunnel_thread = 0;
@@ -645,10 +672,12 @@ void MPPTask::runImpl()
 
         LOG_DEBUG(
             log,
-            "Estimate new thread count of query: {} including tunnel_threads: {}, receiver_threads: {}",
+            "Estimate new thread count of query: {} including tunnel_threads: {}, receiver_threads: {}, estimated "
+            "memory: {}",
             schedule_entry.getNeededThreads(),
             tunnel_thread,
-            new_thread_count_of_mpp_receiver);
+            new_thread_count_of_mpp_receiver,
+            schedule_entry.getEstimatedMemory());
 
         scheduleOrWait();
 
@@ -685,7 +714,8 @@ void MPPTask::runImpl()
         }
 #endif
 
-        auto result = query_executor_holder->execute();
+        Stopwatch cpu_watch(CLOCK_THREAD_CPUTIME_ID);
+        auto result = cached_result ? replayCachedResult(*cached_result) : query_executor_holder->execute();
 
         log_level = Poco::Message::PRIO_DEBUG;
         if (!result.is_success || status != RUNNING)
@@ -693,10 +723,13 @@ void MPPTask::runImpl()
         LOG_IMPL(
             log,
             log_level,
-            "mpp task finish execute, is_success: {}, status: {}",
+            "mpp task finish execute, is_success: {}, status: {}, hit result cache: {}",
             result.is_success,
-            magic_enum::enum_name(status.load()));
-        auto cpu_time_ns = query_executor_holder->collectCPUTimeNs();
+            magic_enum::enum_name(status.load()),
+            cached_result != nullptr);
+        /// On a hit of the result cache, the executors are not executed and no data is read, so only the cpu time
+        /// of replaying the packets is charged.
+        auto cpu_time_ns = cached_result ? cpu_watch.elapsed() : query_executor_holder->collectCPUTimeNs();
         auto cpu_ru = cpuTimeToRU(cpu_time_ns);
         auto read_bytes = dag_context->getReadBytes();
         auto read_ru = bytesToRU(read_bytes);
@@ -729,6 +762,8 @@ void MPPTask::runImpl()
 
             // finish MPPTunnel
             finishWrite();
+            if (result_cache)
+                result_cache->finish(*tunnel_set);
 
             // finish receiver
             receiver_set->close();
@@ -767,6 +802,8 @@ void MPPTask::runImpl()
             /// todo log executor level peak memory usage instead
             auto peak_memory = getMemoryTracker()->getPeak();
             mpp_task_statistics.setMemoryPeak(peak_memory);
+            if (plan_digest)
+                manager->recordTaskPeakMemory(*plan_digest, peak_memory);
         }
     }
     else
@@ -18,6 +18,7 @@
 #include <Common/Logger.h>
 #include <Flash/Executor/QueryExecutor.h>
 #include <Flash/Mpp/MPPReceiverSet.h>
+#include <Flash/Mpp/MPPResultCache.h>
 #include <Flash/Mpp/MPPTaskId.h>
 #include <Flash/Mpp/MPPTaskScheduleEntry.h>
 #include <Flash/Mpp/MPPTaskStatistics.h>
@@ -32,6 +33,7 @@
 #include <atomic>
 #include <boost/noncopyable.hpp>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 namespace DB
@@ -128,6 +130,9 @@ private:
 
     void finishWrite();
 
+    /// Write the packets of the cached result to the tunnels instead of executing the executors.
+    ExecutionResult replayCachedResult(const MPPResultCache::Entry & entry);
+
     bool switchStatus(TaskStatus from, TaskStatus to);
 
     void preprocess();
@@ -210,6 +215,13 @@ private:
 
     int new_thread_count_of_mpp_receiver = 0;
 
+    /// The digest of the plan, used to record the peak memory of this plan for the memory estimation of scheduler.
+    /// Not set if the scheduler does not limit the memory.
+    std::optional<UInt64> plan_digest;
+
+    /// nullptr if the result of this task is not cacheable.
+    MPPTaskResultCachePtr result_cache;
+
     const LoggerPtr log;
 
     MPPTaskStatistics mpp_task_statistics;
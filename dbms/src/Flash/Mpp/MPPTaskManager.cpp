@@ -605,4 +605,16 @@ void MPPTaskManager::releaseThreadsFromScheduler(const String & resource_group_n
     std::lock_guard lock(mu);
     scheduler->releaseThreadsThenSchedule(resource_group_name, needed_threads, *this);
 }
+
+UInt64 MPPTaskManager::estimateTaskMemory(const PlanMemoryHistory::PlanInfo & plan_info)
+{
+    std::lock_guard lock(mu);
+    return scheduler->estimateMemory(plan_info);
+}
+
+void MPPTaskManager::recordTaskPeakMemory(UInt64 plan_digest, Int64 peak_memory)
+{
+    std::lock_guard lock(mu);
+    scheduler->recordPeakMemory(plan_digest, peak_memory);
+}
 } // namespace DB
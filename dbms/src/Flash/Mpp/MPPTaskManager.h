@@ -254,6 +254,10 @@ public:
 
     void releaseThreadsFromScheduler(const String & resource_group_name, int needed_threads);
 
+    UInt64 estimateTaskMemory(const PlanMemoryHistory::PlanInfo & plan_info);
+
+    void recordTaskPeakMemory(UInt64 plan_digest, Int64 peak_memory);
+
     std::pair<MPPTunnelPtr, String> findTunnelWithTimeout(
         const ::mpp::EstablishMPPConnectionRequest * request,
         std::chrono::seconds timeout);
@@ -36,6 +36,9 @@ public:
     int getNeededThreads() const;
     void setNeededThreads(int needed_threads_);
 
+    UInt64 getEstimatedMemory() const { return estimated_memory; }
+    void setEstimatedMemory(UInt64 estimated_memory_) { estimated_memory = estimated_memory_; }
+
     bool schedule(ScheduleState state);
     void waitForSchedule();
 
@@ -43,6 +46,13 @@ public:
 
     const String & getResourceGroupName() const { return id.gather_id.query_id.resource_group_name; }
 
+    /// for test
+    ScheduleState getScheduleState()
+    {
+        std::lock_guard lock(schedule_mu);
+        return schedule_state;
+    }
+
     ~MPPTaskScheduleEntry();
 
     MPPTaskScheduleEntry(MPPTaskManager * manager_, const MPPTaskId & id_);
@@ -52,6 +62,8 @@ private:
     MPPTaskId id;
 
     int needed_threads;
+    /// 0 means the memory is not estimated or the memory limit of scheduler is not set.
+    UInt64 estimated_memory = 0;
 
     std::mutex schedule_mu;
     std::condition_variable schedule_cv;
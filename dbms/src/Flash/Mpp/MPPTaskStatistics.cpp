@@ -16,6 +16,7 @@
 #include <DataStreams/TiRemoteBlockInputStream.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Mpp/MPPTaskStatistics.h>
+#include <Flash/Mpp/MPPTunnelSet.h>
 #include <Flash/Mpp/getMPPTaskTracingLog.h>
 #include <common/logger_useful.h>
 #include <fmt/format.h>
@@ -95,6 +96,7 @@ void MPPTaskStatistics::collectRuntimeStatistics()
     // record io bytes
     output_bytes = return_statistics.bytes;
     recordInputBytes(*dag_context);
+    recordOutputPartitions(*dag_context);
 }
 
 tipb::SelectResponse MPPTaskStatistics::genExecutionSummaryResponse()
@@ -121,6 +123,7 @@ void MPPTaskStatistics::logTracingJson()
         R"(,"compile_start_timestamp":{},"compile_end_timestamp":{})"
         R"(,"read_wait_index_start_timestamp":{},"read_wait_index_end_timestamp":{})"
         R"(,"local_input_bytes":{},"remote_input_bytes":{},"output_bytes":{})"
+        R"(,"output_partition_rows":[{}],"output_partition_bytes":[{}])"
         R"(,"status":"{}","error_message":"{}","cpu_ru":{},"read_ru":{},"memory_peak":{},"extra_info":{}}})",
         id.gather_id.query_id.start_ts,
         id.task_id,
@@ -142,6 +145,8 @@ void MPPTaskStatistics::logTracingJson()
         local_input_bytes,
         remote_input_bytes,
         output_bytes,
+        fmt::join(output_partition_rows, ","),
+        fmt::join(output_partition_bytes, ","),
         magic_enum::enum_name(status),
         error_message,
         ru_info.cpu_ru,
@@ -177,6 +182,21 @@ void MPPTaskStatistics::setExtraInfo(const String & extra_info_)
     extra_info = extra_info_;
 }
 
+void MPPTaskStatistics::recordOutputPartitions(DAGContext & dag_context)
+{
+    // The root executor may be a CTESink without tunnels
+    if (!dag_context.tunnel_set)
+        return;
+    const auto & tunnels = dag_context.tunnel_set->getTunnels();
+    output_partition_rows.resize(tunnels.size());
+    output_partition_bytes.resize(tunnels.size());
+    for (size_t i = 0; i < tunnels.size(); ++i)
+    {
+        output_partition_rows[i] = tunnels[i]->getSentRows();
+        output_partition_bytes[i] = tunnels[i]->getConnectionProfileInfo().bytes;
+    }
+}
+
 void MPPTaskStatistics::recordInputBytes(DAGContext & dag_context)
 {
     switch (dag_context.getExecutionMode())
@@ -65,6 +65,8 @@ private:
 
     void recordInputBytes(DAGContext & dag_context);
 
+    void recordOutputPartitions(DAGContext & dag_context);
+
     const LoggerPtr log;
 
     DAGContext * dag_context = nullptr;
@@ -87,6 +89,9 @@ private:
     Int64 local_input_bytes = 0;
     Int64 remote_input_bytes = 0;
     Int64 output_bytes = 0;
+    // The rows and bytes sent to each partition, used to find the skewed partitions
+    std::vector<Int64> output_partition_rows;
+    std::vector<Int64> output_partition_bytes;
 
     // executor dag
     bool is_root = false;
@@ -536,6 +536,10 @@ public:
 
     const ConnectionProfileInfo & getConnectionProfileInfo() const { return connection_profile_info; }
 
+    // The number of rows sent by this tunnel, used to find the skewed partitions of hash exchange.
+    void updateSentRows(size_t rows) { sent_rows.fetch_add(rows, std::memory_order_relaxed); }
+    Int64 getSentRows() const { return sent_rows.load(std::memory_order_relaxed); }
+
     bool isLocal() const { return mode == TunnelSenderMode::LOCAL; }
     bool isAsync() const { return mode == TunnelSenderMode::ASYNC_GRPC; }
 
@@ -597,6 +601,7 @@ private:
     std::shared_ptr<MemoryTracker> mem_tracker;
     const CapacityLimits queue_limit;
     ConnectionProfileInfo connection_profile_info;
+    std::atomic<Int64> sent_rows{0};
     const LoggerPtr log;
     TunnelSenderMode mode; // Tunnel transfer data mode
     TunnelSenderPtr
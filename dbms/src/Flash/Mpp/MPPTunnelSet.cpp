@@ -43,6 +43,8 @@ template <typename Tunnel>
 void MPPTunnelSetBase<Tunnel>::write(TrackedMppDataPacketPtr && data, size_t index)
 {
     assert(index < tunnels.size());
+    if (result_recorder)
+        result_recorder->record(index, data->getPacket());
     tunnels[index]->write(std::move(data));
 }
 
@@ -50,6 +52,8 @@ template <typename Tunnel>
 void MPPTunnelSetBase<Tunnel>::forceWrite(TrackedMppDataPacketPtr && data, size_t index)
 {
     assert(index < tunnels.size());
+    if (result_recorder)
+        result_recorder->record(index, data->getPacket());
     tunnels[index]->forceWrite(std::move(data));
 }
 
@@ -57,14 +61,20 @@ template <typename Tunnel>
 void MPPTunnelSetBase<Tunnel>::write(tipb::SelectResponse & response, size_t index)
 {
     assert(index < tunnels.size());
-    tunnels[index]->write(serializePacket(response));
+    auto packet = serializePacket(response);
+    if (result_recorder)
+        result_recorder->record(index, packet->getPacket());
+    tunnels[index]->write(std::move(packet));
 }
 
 template <typename Tunnel>
 void MPPTunnelSetBase<Tunnel>::forceWrite(tipb::SelectResponse & response, size_t index)
 {
     assert(index < tunnels.size());
-    tunnels[index]->forceWrite(serializePacket(response));
+    auto packet = serializePacket(response);
+    if (result_recorder)
+        result_recorder->record(index, packet->getPacket());
+    tunnels[index]->forceWrite(std::move(packet));
 }
 
 template <typename Tunnel>
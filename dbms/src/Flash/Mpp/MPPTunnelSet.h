@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Flash/Mpp/MPPResultCache.h>
 #include <Flash/Mpp/MPPTaskId.h>
 #include <Flash/Mpp/MPPTunnel.h>
 #include <Flash/Mpp/MppVersion.h>
@@ -64,6 +65,11 @@ public:
 
     bool isLocal(size_t index) const;
 
+    void updateSentRows(size_t rows, size_t index) { tunnels[index]->updateSentRows(rows); }
+
+    /// Should be set before writing, all the packets written except the execution summary are recorded.
+    void setResultRecorder(const MPPResultRecorderPtr & recorder) { result_recorder = recorder; }
+
 private:
     std::vector<TunnelPtr> tunnels;
     std::unordered_map<MPPTaskId, size_t> receiver_task_id_to_index_map;
@@ -71,6 +77,8 @@ private:
 
     int external_thread_cnt = 0;
     size_t local_tunnel_cnt = 0;
+
+    MPPResultRecorderPtr result_recorder;
 };
 
 class MPPTunnelSet : public MPPTunnelSetBase<MPPTunnel>
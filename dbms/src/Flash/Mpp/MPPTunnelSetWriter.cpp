@@ -30,6 +30,31 @@ void checkPacketSize(size_t size)
     static constexpr size_t max_packet_size = 1u << 31;
     RUNTIME_CHECK_MSG(size < max_packet_size, "Packet is too large to send, size : {}", size);
 }
+
+size_t getRows(const std::vector<MutableColumns> & part_columns)
+{
+    size_t rows = 0;
+    for (const auto & columns : part_columns)
+    {
+        if (!columns.empty() && columns.front())
+            rows += columns.front()->size();
+    }
+    return rows;
+}
+
+size_t getFineGrainedRows(
+    const std::vector<IColumn::ScatterColumns> & scattered,
+    size_t bucket_idx,
+    UInt64 fine_grained_shuffle_stream_count,
+    size_t num_columns)
+{
+    if (num_columns == 0)
+        return 0;
+    size_t rows = 0;
+    for (size_t i = 0; i < fine_grained_shuffle_stream_count; ++i)
+        rows += scattered[0][bucket_idx + i]->size();
+    return rows;
+}
 } // namespace
 
 
@@ -364,11 +389,15 @@ void MPPTunnelSetWriterBase::passThroughWrite(
 
 void MPPTunnelSetWriterBase::partitionWrite(Blocks & blocks, int16_t partition_id)
 {
+    size_t rows = 0;
+    for (const auto & block : blocks)
+        rows += block.rows();
     auto && tracked_packet = MPPTunnelSetHelper::ToPacketV0(blocks, result_field_types);
     assert(tracked_packet);
     auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
+    mpp_tunnel_set->updateSentRows(rows, partition_id);
     updatePartitionWriterMetrics(
         CompressionMethod::NONE,
         packet_bytes,
@@ -388,6 +417,7 @@ void MPPTunnelSetWriterBase::partitionWrite(
     bool is_local = mpp_tunnel_set->isLocal(partition_id);
     compression_method = is_local ? CompressionMethod::NONE : compression_method;
 
+    const size_t rows = getRows(part_columns);
     size_t original_size = 0;
     auto tracked_packet
         = MPPTunnelSetHelper::ToPacket(header, std::move(part_columns), version, compression_method, original_size);
@@ -396,6 +426,7 @@ void MPPTunnelSetWriterBase::partitionWrite(
     auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
+    mpp_tunnel_set->updateSentRows(rows, partition_id);
     updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
 }
 
@@ -421,6 +452,7 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
     bool is_local = mpp_tunnel_set->isLocal(partition_id);
     compression_method = is_local ? CompressionMethod::NONE : compression_method;
 
+    const size_t rows = getFineGrainedRows(scattered, bucket_idx, fine_grained_shuffle_stream_count, num_columns);
     size_t original_size = 0;
     auto tracked_packet = MPPTunnelSetHelper::ToFineGrainedPacket(
         header,
@@ -435,6 +467,7 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
     auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
+    mpp_tunnel_set->updateSentRows(rows, partition_id);
     updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
 }
 
@@ -446,6 +479,7 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
     size_t num_columns,
     int16_t partition_id)
 {
+    const size_t rows = getFineGrainedRows(scattered, bucket_idx, fine_grained_shuffle_stream_count, num_columns);
     auto tracked_packet = MPPTunnelSetHelper::ToFineGrainedPacketV0(
         header,
         scattered,
@@ -457,6 +491,7 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
     auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
+    mpp_tunnel_set->updateSentRows(rows, partition_id);
     updatePartitionWriterMetrics(
         CompressionMethod::NONE,
         packet_bytes,
@@ -26,12 +26,21 @@ extern const char random_min_tso_scheduler_failpoint[];
 } // namespace FailPoints
 
 constexpr UInt64 OS_THREAD_SOFT_LIMIT = 100000;
+constexpr size_t PLAN_MEMORY_HISTORY_CAPACITY = 1024;
 
-MinTSOScheduler::MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 active_set_soft_limit_)
+MinTSOScheduler::MinTSOScheduler(
+    UInt64 soft_limit,
+    UInt64 hard_limit,
+    UInt64 active_set_soft_limit_,
+    UInt64 memory_limit_,
+    UInt64 memory_per_operator_)
     : thread_soft_limit(soft_limit)
     , thread_hard_limit(hard_limit)
     , global_estimated_thread_usage(0)
     , active_set_soft_limit(active_set_soft_limit_)
+    , memory_limit(memory_limit_)
+    , memory_per_operator(memory_per_operator_)
+    , plan_memory_history(PLAN_MEMORY_HISTORY_CAPACITY)
     , log(Logger::get())
 {
     auto cores = static_cast<size_t>(getNumberOfLogicalCPUCores());
@@ -72,6 +81,15 @@ MinTSOScheduler::MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 ac
                 thread_soft_limit,
                 active_set_soft_limit);
         }
+        if (memory_limit > 0)
+        {
+            LOG_INFO(
+                log,
+                "memory_limit is {}, memory_per_operator is {} in MinTSOScheduler.",
+                memory_limit,
+                memory_per_operator);
+        }
+        GET_METRIC(tiflash_task_scheduler, type_memory_limit).Set(memory_limit);
     }
 }
 
@@ -159,7 +177,18 @@ void MinTSOScheduler::deleteQuery(
             .Set(group_entry.active_set.size());
 
         /// NOTE: if updated min_query_id query has waiting tasks, they should be scheduled, especially when the soft-limited threads are amost used and active tasks are in resources deadlock which cannot release threads soon.
-        if (group_entry.updateMinQueryId(query_id, true, is_cancelled ? "when cancelling it" : "as finishing it", log))
+        bool force_scheduling = group_entry.updateMinQueryId(
+            query_id,
+            true,
+            is_cancelled ? "when cancelling it" : "as finishing it",
+            log);
+        if (releaseQueryMemory(query_id))
+        {
+            /// the released memory is shared by the waiting queries of all resource groups.
+            for (auto & iter : group_entries)
+                scheduleWaitingQueries(iter.second, task_manager, log);
+        }
+        else if (force_scheduling)
         {
             scheduleWaitingQueries(group_entry, task_manager, log);
         }
@@ -175,6 +204,40 @@ void MinTSOScheduler::deleteQuery(
     }
 }
 
+UInt64 MinTSOScheduler::estimateMemory(const PlanMemoryHistory::PlanInfo & plan_info) const
+{
+    if (!isMemoryLimitEnabled())
+        return 0;
+    if (auto observed = plan_memory_history.get(plan_info.digest); observed > 0)
+        return observed;
+    return plan_info.memory_intensive_operators * memory_per_operator;
+}
+
+void MinTSOScheduler::recordPeakMemory(UInt64 plan_digest, Int64 peak_memory)
+{
+    if (!isMemoryLimitEnabled() || peak_memory <= 0)
+        return;
+    plan_memory_history.record(plan_digest, peak_memory);
+}
+
+bool MinTSOScheduler::releaseQueryMemory(const MPPQueryId & query_id)
+{
+    auto iter = query_estimated_memory.find(query_id);
+    if (iter == query_estimated_memory.end())
+        return false;
+    RUNTIME_ASSERT(
+        global_estimated_memory_usage >= iter->second,
+        log,
+        "global_estimated_memory_usage {} should not be smaller than the memory {} of query {}",
+        global_estimated_memory_usage,
+        iter->second,
+        query_id.toString());
+    global_estimated_memory_usage -= iter->second;
+    query_estimated_memory.erase(iter);
+    GET_METRIC(tiflash_task_scheduler, type_global_estimated_memory_usage).Set(global_estimated_memory_usage);
+    return true;
+}
+
 MPPQueryId MinTSOScheduler::getCurrentMinTSOQueryId(const String & resource_group_name)
 {
     auto & group_entry = getOrCreateGroupEntry(resource_group_name);
@@ -308,11 +371,25 @@ bool MinTSOScheduler::scheduleImp(
     auto needed_threads = schedule_entry.getNeededThreads();
     auto & group_entry = getOrCreateGroupEntry(query_id.resource_group_name);
 
+    /// the memory is reserved per query, so only the part exceeding the reserved memory of the query is needed.
+    UInt64 needed_memory = 0;
+    if (isMemoryLimitEnabled())
+    {
+        auto iter = query_estimated_memory.find(query_id);
+        UInt64 reserved_memory = iter == query_estimated_memory.end() ? 0 : iter->second;
+        if (schedule_entry.getEstimatedMemory() > reserved_memory)
+            needed_memory = schedule_entry.getEstimatedMemory() - reserved_memory;
+    }
+    /// the min_query_id query is not limited by memory, otherwise it may never be scheduled.
+    /// and if no memory is reserved, any query can be scheduled to avoid starving the queries larger than the limit.
+    auto check_memory = needed_memory == 0 || global_estimated_memory_usage == 0
+        || global_estimated_memory_usage + needed_memory <= memory_limit;
     auto check_for_new_min_tso
         = query_id <= group_entry.min_query_id && global_estimated_thread_usage + needed_threads <= thread_hard_limit;
-    auto check_for_not_min_tso = (group_entry.active_set.size() < active_set_soft_limit
-                                  || group_entry.active_set.find(query_id) != group_entry.active_set.end())
+    auto check_threads_for_not_min_tso = (group_entry.active_set.size() < active_set_soft_limit
+                                          || group_entry.active_set.find(query_id) != group_entry.active_set.end())
         && (group_entry.estimated_thread_usage + needed_threads <= thread_soft_limit);
+    auto check_for_not_min_tso = check_threads_for_not_min_tso && check_memory;
     if (check_for_new_min_tso || check_for_not_min_tso)
     {
         group_entry
@@ -324,6 +401,13 @@ bool MinTSOScheduler::scheduleImp(
             global_estimated_thread_usage += needed_threads;
             GET_RESOURCE_GROUP_METRIC(tiflash_task_scheduler, type_active_tasks_count, group_entry.resource_group_name)
                 .Increment();
+            if (needed_memory > 0)
+            {
+                query_estimated_memory[query_id] = schedule_entry.getEstimatedMemory();
+                global_estimated_memory_usage += needed_memory;
+                GET_METRIC(tiflash_task_scheduler, type_global_estimated_memory_usage)
+                    .Set(global_estimated_memory_usage);
+            }
         }
         GET_RESOURCE_GROUP_METRIC(tiflash_task_scheduler, type_active_queries_count, group_entry.resource_group_name)
             .Set(group_entry.active_set.size());
@@ -381,6 +465,8 @@ bool MinTSOScheduler::scheduleImp(
         }
         if (!isWaiting)
         {
+            if (check_threads_for_not_min_tso && !check_memory)
+                GET_METRIC(tiflash_task_scheduler, type_memory_limit_waiting_count).Increment();
             group_entry.waiting_set.insert(query_id);
             query_task_set->waiting_tasks.push(schedule_entry.getMPPTaskId());
             GET_RESOURCE_GROUP_METRIC(
@@ -395,12 +481,16 @@ bool MinTSOScheduler::scheduleImp(
             log,
             "Resource temporary not available for query {}(is first schedule: {}), available threads count are {}, "
             "available active set size = {}, "
-            "required threads count are {}, waiting set size = {}",
+            "required threads count are {}, required memory is {}, reserved memory is {} of the memory limit {}, "
+            "waiting set size = {}",
             query_id.toString(),
             !isWaiting,
             thread_soft_limit - group_entry.estimated_thread_usage,
             active_set_soft_limit - group_entry.active_set.size(),
             needed_threads,
+            needed_memory,
+            global_estimated_memory_usage,
+            memory_limit,
             group_entry.waiting_set.size());
         return false;
     }
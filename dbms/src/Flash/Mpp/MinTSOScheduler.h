@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Flash/Mpp/MPPTask.h>
+#include <Flash/Mpp/PlanMemoryHistory.h>
 #include <common/logger_useful.h>
 
 namespace DB
@@ -32,10 +33,17 @@ using MPPGatherTaskSetPtr = std::shared_ptr<MPPGatherTaskSet>;
 /// The min_query_id query avoids the deadlock resulted from threads competition among nodes.
 /// schedule tasks under the lock protection of the task manager.
 /// NOTE: if the updated min-tso query has waiting tasks, necessarily scheduling them, otherwise the query would hang.
+/// If memory_limit is set, the queries except the min_query_id query are also admitted only when their estimated memory
+/// fits under the memory limit. The memory is reserved per query until the query is deleted from the scheduler.
 class MinTSOScheduler : private boost::noncopyable
 {
 public:
-    MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 active_set_soft_limit_);
+    MinTSOScheduler(
+        UInt64 soft_limit,
+        UInt64 hard_limit,
+        UInt64 active_set_soft_limit_,
+        UInt64 memory_limit_ = 0,
+        UInt64 memory_per_operator_ = 0);
     ~MinTSOScheduler() = default;
     /// try to schedule this task if it is the min_query_id query or there are enough threads, otherwise put it into the waiting set.
     /// NOTE: call tryToSchedule under the lock protection of MPPTaskManager
@@ -50,8 +58,15 @@ public:
         const String & resource_group_name,
         int needed_threads,
         MPPTaskManager & task_manager);
+    /// estimate the memory of a task by the observed peak memory of the queries with the same plan, or by the count of
+    /// memory intensive operators in the plan if the plan has not been seen recently. Return 0 if memory_limit is not set.
+    /// NOTE: call estimateMemory and recordPeakMemory under the lock protection of MPPTaskManager
+    UInt64 estimateMemory(const PlanMemoryHistory::PlanInfo & plan_info) const;
+    void recordPeakMemory(UInt64 plan_digest, Int64 peak_memory);
+
     /// for test
     MPPQueryId getCurrentMinTSOQueryId(const String & resource_group_name);
+    UInt64 getGlobalEstimatedMemoryUsage() const { return global_estimated_memory_usage; }
 
 private:
     bool scheduleImp(
@@ -61,6 +76,9 @@ private:
         bool isWaiting,
         bool & has_error);
     bool isDisabled() const { return thread_hard_limit == 0 && thread_soft_limit == 0; }
+    bool isMemoryLimitEnabled() const { return !isDisabled() && memory_limit > 0; }
+    /// return true if some memory is released.
+    bool releaseQueryMemory(const MPPQueryId & query_id);
 
     struct GroupEntry
     {
@@ -90,6 +108,14 @@ private:
     UInt64 global_estimated_thread_usage;
     /// to prevent from too many queries just issue a part of tasks to occupy threads, in proportion to the hardware cores.
     size_t active_set_soft_limit;
+    /// the memory budget of all the queries, 0 means no limit.
+    const UInt64 memory_limit;
+    /// the estimated memory of each memory intensive operator if the plan has not been seen recently.
+    const UInt64 memory_per_operator;
+    UInt64 global_estimated_memory_usage = 0;
+    /// the memory reserved by each active query, which is the max estimated memory of its scheduled tasks.
+    std::unordered_map<MPPQueryId, UInt64, MPPQueryIdHash> query_estimated_memory;
+    PlanMemoryHistory plan_memory_history;
     LoggerPtr log;
 };
 
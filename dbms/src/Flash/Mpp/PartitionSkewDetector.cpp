@@ -0,0 +1,87 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/FmtUtils.h>
+#include <Common/TiFlashMetrics.h>
+#include <Flash/Mpp/PartitionSkewDetector.h>
+#include <common/logger_useful.h>
+
+namespace DB
+{
+PartitionSkewDetector::PartitionSkewDetector(UInt16 partition_num_, UInt64 sample_rows_, const LoggerPtr & log_)
+    : partition_num(partition_num_)
+    , sample_rows(sample_rows_)
+    , log(log_)
+    , sketch(SKETCH_CAPACITY)
+{
+    RUNTIME_CHECK(partition_num > 0);
+}
+
+void PartitionSkewDetector::sample(const WeakHash32 & hash)
+{
+    if (!isSampling())
+        return;
+
+    const auto & hash_data = hash.getData();
+    const size_t rows = std::min<size_t>(hash_data.size(), sample_rows - sampled_rows);
+    for (size_t i = 0; i < rows; ++i)
+        sketch.insert(hash_data[i]);
+    sampled_rows += rows;
+
+    if (!isSampling())
+        finishSampling();
+}
+
+void PartitionSkewDetector::finishSampling()
+{
+    // A key is hot if it takes more than SKEW_RATIO times the fair share of the rows. So with no more
+    // than SKEW_RATIO partitions, no key is reported.
+    for (const auto & counter : sketch.topK(SKETCH_CAPACITY))
+    {
+        // `count - error` is the lower bound of the real frequency
+        const UInt64 rows = counter.count - counter.error;
+        if (rows < MIN_HOT_KEY_ROWS || rows * partition_num <= sampled_rows * SKEW_RATIO)
+            continue;
+        hot_keys.push_back(HotKey{
+            .hash = counter.key,
+            .partition_id = getPartitionId(counter.key, partition_num),
+            .rows = rows,
+        });
+    }
+    sketch.clear();
+
+    if (hot_keys.empty())
+        return;
+
+    GET_METRIC(tiflash_exchange_partition_skew_count).Increment();
+    FmtBuffer fmt_buf;
+    fmt_buf.joinStr(
+        hot_keys.cbegin(),
+        hot_keys.cend(),
+        [&](const HotKey & key, FmtBuffer & fb) {
+            fb.fmtAppend(
+                "{{hash={} partition={} rows_ratio={:.3f}}}",
+                key.hash,
+                key.partition_id,
+                static_cast<double>(key.rows) / sampled_rows);
+        },
+        ", ");
+    LOG_INFO(
+        log,
+        "Detected skewed partition keys in hash exchange, partition_num={} sampled_rows={} hot_keys=[{}]",
+        partition_num,
+        sampled_rows,
+        fmt_buf.toString());
+}
+} // namespace DB
@@ -0,0 +1,83 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Common/SpaceSaving.h>
+#include <Common/WeakHash.h>
+#include <common/types.h>
+
+#include <vector>
+
+namespace DB
+{
+/// PartitionSkewDetector samples the partition key hashes of the first rows sent by a hash exchange
+/// sender with a SpaceSaving sketch, and reports the hot keys that take more than `SKEW_RATIO` times
+/// the fair share (1 / partition_num) of the rows. The rows of such a key always go to the same
+/// partition, so the receiver of that partition will be much slower than the others no matter how
+/// well the other keys are distributed. A key is reported only if it has at least `MIN_HOT_KEY_ROWS`
+/// sampled rows, so a small sample or a small partition_num does not produce noisy reports.
+///
+/// Rows with the same partition key hash are routed to the same partition, so the sketch is keyed by
+/// the hash instead of the key itself to avoid copying the keys.
+class PartitionSkewDetector
+{
+public:
+    // A key is hot if it takes more than SKEW_RATIO times the fair share of the rows
+    static constexpr UInt64 SKEW_RATIO = 3;
+    static constexpr UInt64 MIN_HOT_KEY_ROWS = 1024;
+
+    struct HotKey
+    {
+        UInt32 hash;
+        UInt16 partition_id;
+        // The estimated number of sampled rows with this key
+        UInt64 rows;
+    };
+
+    PartitionSkewDetector(UInt16 partition_num_, UInt64 sample_rows_, const LoggerPtr & log_);
+
+    /// Sample the hash values computed for a block, do nothing after enough rows are sampled.
+    void sample(const WeakHash32 & hash);
+
+    bool isSampling() const { return sampled_rows < sample_rows; }
+
+    /// Only valid after sampling is finished.
+    const std::vector<HotKey> & getHotKeys() const { return hot_keys; }
+
+    /// Returns the partition id that the hash value is routed to, should be the same as
+    /// `HashBaseWriterHelper::fillSelector`.
+    static UInt16 getPartitionId(UInt32 hash, UInt16 partition_num)
+    {
+        return static_cast<UInt16>((static_cast<UInt64>(hash) * partition_num) >> 32u);
+    }
+
+private:
+    void finishSampling();
+
+    // The number of candidates tracked by the sketch
+    static constexpr size_t SKETCH_CAPACITY = 64;
+
+    const UInt16 partition_num;
+    const UInt64 sample_rows;
+    const LoggerPtr log;
+
+    UInt64 sampled_rows = 0;
+    SpaceSaving<UInt32> sketch;
+    std::vector<HotKey> hot_keys;
+};
+
+using PartitionSkewDetectorPtr = std::unique_ptr<PartitionSkewDetector>;
+} // namespace DB
@@ -0,0 +1,78 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/SipHash.h>
+#include <Flash/Coprocessor/DAGRequest.h>
+#include <Flash/Mpp/PlanMemoryHistory.h>
+
+namespace DB
+{
+PlanMemoryHistory::PlanMemoryHistory(size_t capacity_)
+    : capacity(std::max<size_t>(capacity_, 1))
+{}
+
+UInt64 PlanMemoryHistory::get(UInt64 plan_digest) const
+{
+    auto iter = estimates.find(plan_digest);
+    return iter == estimates.end() ? 0 : iter->second;
+}
+
+void PlanMemoryHistory::record(UInt64 plan_digest, UInt64 peak_memory)
+{
+    auto iter = estimates.find(plan_digest);
+    if (iter != estimates.end())
+    {
+        auto & estimate = iter->second;
+        estimate = peak_memory >= estimate ? peak_memory : estimate - (estimate - peak_memory) / 4;
+        return;
+    }
+
+    if (estimates.size() >= capacity)
+    {
+        estimates.erase(insertion_order.front());
+        insertion_order.pop_front();
+    }
+    estimates.emplace(plan_digest, peak_memory);
+    insertion_order.push_back(plan_digest);
+}
+
+PlanMemoryHistory::PlanInfo PlanMemoryHistory::analyzePlan(const DAGRequest & dag_request)
+{
+    SipHash hash;
+    size_t memory_intensive_operators = 0;
+    dag_request.traverse([&](const tipb::Executor & executor) {
+        hash.update(static_cast<Int32>(executor.tp()));
+        hash.update(executor.executor_id());
+        switch (executor.tp())
+        {
+        case tipb::ExecType::TypeTableScan:
+            hash.update(executor.tbl_scan().table_id());
+            break;
+        case tipb::ExecType::TypePartitionTableScan:
+            hash.update(executor.partition_table_scan().table_id());
+            break;
+        case tipb::ExecType::TypeJoin:
+        case tipb::ExecType::TypeAggregation:
+        case tipb::ExecType::TypeTopN:
+        case tipb::ExecType::TypeSort:
+            ++memory_intensive_operators;
+            break;
+        default:
+            break;
+        }
+        return true;
+    });
+    return PlanInfo{.digest = hash.get64(), .memory_intensive_operators = memory_intensive_operators};
+}
+} // namespace DB
@@ -0,0 +1,60 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <common/types.h>
+
+#include <deque>
+#include <unordered_map>
+
+namespace DB
+{
+class DAGRequest;
+
+/// PlanMemoryHistory records the observed peak memory of recent queries by the digest of their plans, so that
+/// MinTSOScheduler can estimate the memory of a new task from the queries with the same plan.
+/// Not thread safe, should be protected by the lock of MPPTaskManager.
+class PlanMemoryHistory
+{
+public:
+    struct PlanInfo
+    {
+        UInt64 digest;
+        /// The number of operators that may hold a lot of memory, such as hash join, hash agg and sort.
+        size_t memory_intensive_operators;
+    };
+
+    explicit PlanMemoryHistory(size_t capacity_);
+
+    /// Returns 0 if the plan has not been seen recently.
+    UInt64 get(UInt64 plan_digest) const;
+
+    /// The estimation follows a rising peak immediately and decays slowly when the peak drops, so that a
+    /// single small run does not make the next big run to be under-estimated.
+    void record(UInt64 plan_digest, UInt64 peak_memory);
+
+    size_t size() const { return estimates.size(); }
+
+    /// The digest only depends on the shape of the plan and the scanned tables, the time related fields
+    /// such as start_ts are not included.
+    static PlanInfo analyzePlan(const DAGRequest & dag_request);
+
+private:
+    const size_t capacity;
+    std::unordered_map<UInt64, UInt64> estimates;
+    /// The plans are evicted in insertion order when the history is full.
+    std::deque<UInt64> insertion_order;
+};
+} // namespace DB
@@ -73,4 +73,17 @@ bool ReceivedMessage::containUsefulMessage() const
 {
     return error_ptr != nullptr || resp_ptr != nullptr || !chunks.empty();
 }
+
+void ReceivedMessage::setDecodedBlocks(std::vector<Block> && blocks)
+{
+    decoded_blocks = std::move(blocks);
+    decoded_rows = 0;
+    decoded_bytes = 0;
+    for (const auto & block : decoded_blocks)
+    {
+        decoded_rows += block.rows();
+        decoded_bytes += block.allocatedBytes();
+    }
+    decoded = true;
+}
 } // namespace DB
@@ -16,6 +16,7 @@
 
 #include <Common/FailPoint.h>
 #include <Common/LooseBoundedMPMCQueue.h>
+#include <Core/Block.h>
 #include <Flash/Mpp/TrackedMppDataPacket.h>
 
 #include <atomic>
@@ -37,6 +38,12 @@ class ReceivedMessage
     std::atomic<size_t> remaining_consumers;
     size_t fine_grained_consumer_size;
     std::atomic<bool> packet_size_recorded{false}; // used to flag if fined grained shuffle packet size is recorded
+    /// The blocks decoded from `chunks` by the decode stage of ExchangeReceiver.
+    /// Only set when the decode stage is enabled and the chunks are decoded successfully.
+    bool decoded = false;
+    std::vector<Block> decoded_blocks;
+    size_t decoded_rows = 0;
+    size_t decoded_bytes = 0;
 
 public:
     // Constructor that move chunks.
@@ -58,5 +65,11 @@ public:
     const mpp::MPPDataPacket & getPacket() const { return packet->packet; }
     std::atomic<bool> & getPacketSizeRecorded() { return packet_size_recorded; }
     bool containUsefulMessage() const;
+
+    void setDecodedBlocks(std::vector<Block> && blocks);
+    bool isDecoded() const { return decoded; }
+    std::vector<Block> & getDecodedBlocks() { return decoded_blocks; }
+    size_t getDecodedRows() const { return decoded_rows; }
+    size_t getDecodedBytes() const { return decoded_bytes; }
 };
 } // namespace DB
@@ -89,6 +89,29 @@ public:
     }
 };
 
+/// The queue of messages that are already decoded by the decode stage of ExchangeReceiver.
+class DecodedMessageQueue final
+    : public NotifyFuture
+    , public LooseBoundedMPMCQueue<ReceivedMessagePtr>
+{
+public:
+    explicit DecodedMessageQueue(const CapacityLimits & queue_limits)
+        : LooseBoundedMPMCQueue<ReceivedMessagePtr>(queue_limits, [](const ReceivedMessagePtr & message) {
+            return getMessageBytes(message);
+        })
+    {}
+
+    static size_t getMessageBytes(const ReceivedMessagePtr & message)
+    {
+        return message->getDecodedBytes() + message->getPacket().ByteSizeLong();
+    }
+
+    void registerTask(TaskPtr && task) override
+    {
+        registerPipeReadTask(std::move(task), NotifyType::WAIT_ON_GRPC_RECV_READ);
+    }
+};
+
 class ReceivedMessageQueue
 {
 public:
@@ -0,0 +1,271 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/isLocalAddress.h>
+#include <Flash/Mpp/ShmTransport.h>
+#include <Poco/Net/SocketAddress.h>
+#include <google/protobuf/message.h>
+
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace DB::ShmTransport
+{
+namespace
+{
+// The format of the data in the ring buffer is versioned by the key, a peer that does not know the key
+// falls back to gRPC.
+constexpr auto METADATA_KEY = "tiflash-shm-ring-v1";
+constexpr auto TOKEN_METADATA_KEY = "tiflash-shm-ring-v1-token";
+
+struct PacketHeader
+{
+    Int64 version;
+    UInt32 error_size;
+    UInt32 data_size;
+    UInt32 chunk_num;
+    UInt32 stream_id_num;
+};
+
+UInt32 checkedSize(size_t size)
+{
+    RUNTIME_CHECK(size <= std::numeric_limits<UInt32>::max(), size);
+    return static_cast<UInt32>(size);
+}
+
+template <typename T>
+bool writeRaw(ShmRingBuffer & ring, const T * data, size_t num)
+{
+    return ring.write(reinterpret_cast<const char *>(data), num * sizeof(T));
+}
+
+// Only used for the data after the first field of a packet, which must be there.
+template <typename T>
+void readRaw(ShmRingBuffer & ring, T * to, size_t num)
+{
+    RUNTIME_CHECK_MSG(
+        ring.read(reinterpret_cast<char *>(to), num * sizeof(T)),
+        "Unexpected end of packet from shared memory {}",
+        ring.getName());
+}
+
+void readString(ShmRingBuffer & ring, String & s, size_t size)
+{
+    s.resize(size);
+    readRaw(ring, s.data(), size);
+}
+
+std::optional<String> getMetadata(const grpc::ServerContext & server_context, const String & key)
+{
+    const auto & metadata = server_context.client_metadata();
+    auto it = metadata.find(key);
+    if (it == metadata.end())
+        return std::nullopt;
+    return String(it->second.data(), it->second.size());
+}
+
+void replaceAll(String & s, std::string_view from, std::string_view to)
+{
+    for (auto pos = s.find(from); pos != String::npos; pos = s.find(from, pos + to.size()))
+        s.replace(pos, from.size(), to);
+}
+
+// Resolving the address and listing the network interfaces are slow, and the peers of a node are usually a small
+// and fixed set, so cache the result by the host part of the address, the port does not affect the result.
+class SameHostCache
+{
+public:
+    bool isSameHost(const String & address)
+    {
+        const String host = address.substr(0, address.rfind(':'));
+        {
+            std::lock_guard lock(mu);
+            if (auto it = cache.find(host); it != cache.end())
+                return it->second;
+        }
+        bool is_same_host = false;
+        try
+        {
+            is_same_host = isLocalAddress(Poco::Net::SocketAddress(address));
+        }
+        catch (...)
+        {}
+        std::lock_guard lock(mu);
+        // Only happens when a lot of clients connect from different hosts, start over to bound the memory.
+        if (cache.size() >= MAX_CACHED_HOSTS)
+            cache.clear();
+        cache.emplace(host, is_same_host);
+        return is_same_host;
+    }
+
+private:
+    static constexpr size_t MAX_CACHED_HOSTS = 1024;
+
+    std::mutex mu;
+    std::unordered_map<String, bool> cache;
+};
+} // namespace
+
+bool isSameHostPeer(const String & address)
+{
+    static SameHostCache cache;
+    return cache.isSameHost(address);
+}
+
+bool isSameHostGrpcPeer(const String & peer)
+{
+    if (peer.starts_with("unix:") || peer.starts_with("unix-abstract:"))
+        return true;
+    if (!peer.starts_with("ipv4:") && !peer.starts_with("ipv6:"))
+        return false;
+    String address = peer.substr(5);
+    // Some versions of gRPC encode the brackets of IPv6 addresses.
+    replaceAll(address, "%5B", "[");
+    replaceAll(address, "%5D", "]");
+    return isSameHostPeer(address);
+}
+
+ShmRingBufferPtr tryRequest(grpc::ClientContext & client_context, const LoggerPtr & log)
+{
+    try
+    {
+        auto ring = ShmRingBuffer::create(RING_BUFFER_CAPACITY);
+        client_context.AddMetadata(METADATA_KEY, ring->getName());
+        client_context.AddMetadata(TOKEN_METADATA_KEY, ring->getToken());
+        return ring;
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, "Create shared memory ring buffer failed, fallback to gRPC");
+        return nullptr;
+    }
+}
+
+bool isAccepted(const grpc::ClientContext & client_context, const ShmRingBuffer & ring)
+{
+    const auto & metadata = client_context.GetServerInitialMetadata();
+    auto it = metadata.find(METADATA_KEY);
+    return it != metadata.end() && std::string_view(it->second.data(), it->second.size()) == ring.getName();
+}
+
+ShmRingBufferPtr tryAccept(grpc::ServerContext & server_context, const LoggerPtr & log)
+{
+    auto name = getMetadata(server_context, METADATA_KEY);
+    if (!name)
+        return nullptr;
+    auto token = getMetadata(server_context, TOKEN_METADATA_KEY);
+    if (!token)
+    {
+        LOG_WARNING(log, "Shared memory ring buffer {} is requested without token, fallback to gRPC", *name);
+        return nullptr;
+    }
+    // The segment is only shared with the processes on the same host.
+    if (const auto peer = server_context.peer(); !isSameHostGrpcPeer(peer))
+    {
+        LOG_WARNING(log, "Shared memory ring buffer {} is requested by remote peer {}, fallback to gRPC", *name, peer);
+        return nullptr;
+    }
+
+    try
+    {
+        auto ring = ShmRingBuffer::open(*name, *token);
+        server_context.AddInitialMetadata(METADATA_KEY, *name);
+        return ring;
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, fmt::format("Open shared memory ring buffer {} failed, fallback to gRPC", *name));
+        return nullptr;
+    }
+}
+
+bool writePacket(ShmRingBuffer & ring, const mpp::MPPDataPacket & packet)
+{
+    String error;
+    if (packet.has_error())
+        RUNTIME_CHECK(packet.error().SerializeToString(&error));
+
+    PacketHeader header{
+        .version = packet.version(),
+        .error_size = checkedSize(error.size()),
+        .data_size = checkedSize(packet.data().size()),
+        .chunk_num = checkedSize(packet.chunks_size()),
+        .stream_id_num = checkedSize(packet.stream_ids_size()),
+    };
+    std::vector<UInt32> chunk_sizes;
+    chunk_sizes.reserve(packet.chunks_size());
+    for (const auto & chunk : packet.chunks())
+        chunk_sizes.push_back(checkedSize(chunk.size()));
+
+    if (!writeRaw(ring, &header, 1) || !writeRaw(ring, chunk_sizes.data(), chunk_sizes.size())
+        || !writeRaw(ring, packet.stream_ids().data(), packet.stream_ids_size())
+        || !ring.write(error.data(), error.size()) || !ring.write(packet.data().data(), packet.data().size()))
+        return false;
+    for (const auto & chunk : packet.chunks())
+    {
+        if (!ring.write(chunk.data(), chunk.size()))
+            return false;
+    }
+    return true;
+}
+
+bool readPacket(ShmRingBuffer & ring, mpp::MPPDataPacket & packet)
+{
+    PacketHeader header{};
+    if (!ring.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+
+    packet.Clear();
+    packet.set_version(header.version);
+    std::vector<UInt32> chunk_sizes(header.chunk_num);
+    readRaw(ring, chunk_sizes.data(), chunk_sizes.size());
+    auto * stream_ids = packet.mutable_stream_ids();
+    stream_ids->Resize(header.stream_id_num, 0);
+    readRaw(ring, stream_ids->mutable_data(), header.stream_id_num);
+    if (header.error_size > 0)
+    {
+        String error;
+        readString(ring, error, header.error_size);
+        RUNTIME_CHECK(packet.mutable_error()->ParseFromString(error));
+    }
+    readString(ring, *packet.mutable_data(), header.data_size);
+    for (auto size : chunk_sizes)
+        readString(ring, *packet.add_chunks(), size);
+    return true;
+}
+
+bool writeMessage(ShmRingBuffer & ring, const google::protobuf::Message & message)
+{
+    String buf;
+    RUNTIME_CHECK(message.SerializeToString(&buf));
+    UInt64 size = buf.size();
+    return writeRaw(ring, &size, 1) && ring.write(buf.data(), buf.size());
+}
+
+bool readMessage(ShmRingBuffer & ring, google::protobuf::Message & message)
+{
+    UInt64 size = 0;
+    if (!ring.read(reinterpret_cast<char *>(&size), sizeof(size)))
+        return false;
+    String buf;
+    readString(ring, buf, size);
+    RUNTIME_CHECK(message.ParseFromString(buf));
+    return true;
+}
+} // namespace DB::ShmTransport
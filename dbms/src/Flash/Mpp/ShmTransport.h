@@ -0,0 +1,83 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Common/ShmRingBuffer.h>
+#include <Common/grpcpp.h>
+#include <Flash/Mpp/PacketWriter.h>
+#include <common/types.h>
+#include <kvproto/mpp.pb.h>
+
+namespace google::protobuf
+{
+class Message;
+} // namespace google::protobuf
+
+namespace DB
+{
+/// Helpers to transfer the data of a server streaming gRPC call through a ShmRingBuffer when the client and the
+/// server are different processes on the same host. The gRPC call is still used to set up the connection and to
+/// return the final status:
+/// 1. The client creates a ring buffer and puts its name and token in the metadata of the call.
+/// 2. The server opens the ring buffer and replies the name in the initial metadata, then writes the packets into
+///    the ring buffer instead of the gRPC stream, and finishes the ring buffer before returning the status.
+///    The server only accepts it if enabled by the config, and the gRPC peer is on the same host.
+/// 3. The client waits for the initial metadata and reads from the ring buffer if the server accepts it, otherwise
+///    from the gRPC stream, so it falls back to gRPC if the server can not open the ring buffer or does not know it.
+namespace ShmTransport
+{
+/// Only limits the data in flight, a larger packet is streamed through the ring buffer.
+constexpr size_t RING_BUFFER_CAPACITY = 4 * 1024 * 1024;
+
+/// Whether the peer of `address` ("host:port") is on the same host.
+bool isSameHostPeer(const String & address);
+/// Same as `isSameHostPeer`, but `peer` is got from `grpc::ServerContext::peer()`, e.g. "ipv4:127.0.0.1:3930".
+bool isSameHostGrpcPeer(const String & peer);
+
+/// Called by the client before starting the call. Return nullptr if the ring buffer can not be created.
+ShmRingBufferPtr tryRequest(grpc::ClientContext & client_context, const LoggerPtr & log);
+/// Called by the client after the initial metadata is received.
+bool isAccepted(const grpc::ClientContext & client_context, const ShmRingBuffer & ring);
+
+/// Called by the server, return nullptr if the client does not request, the client is not on the same host, or the
+/// ring buffer can not be opened. The caller should send the initial metadata immediately if accepted.
+ShmRingBufferPtr tryAccept(grpc::ServerContext & server_context, const LoggerPtr & log);
+
+/// MPP packets are written field by field without protobuf serialization, the chunks are copied into the ring
+/// buffer directly.
+bool writePacket(ShmRingBuffer & ring, const mpp::MPPDataPacket & packet);
+bool readPacket(ShmRingBuffer & ring, mpp::MPPDataPacket & packet);
+
+bool writeMessage(ShmRingBuffer & ring, const google::protobuf::Message & message);
+bool readMessage(ShmRingBuffer & ring, google::protobuf::Message & message);
+} // namespace ShmTransport
+
+class ShmPacketWriter : public PacketWriter
+{
+public:
+    explicit ShmPacketWriter(ShmRingBufferPtr && ring_)
+        : ring(std::move(ring_))
+    {}
+
+    // The tunnel has finished when the writer is destroyed.
+    ~ShmPacketWriter() override { ring->finishWrite(); }
+
+    bool write(const mpp::MPPDataPacket & packet) override { return ShmTransport::writePacket(*ring, packet); }
+
+private:
+    ShmRingBufferPtr ring;
+};
+} // namespace DB
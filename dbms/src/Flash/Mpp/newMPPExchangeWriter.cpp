@@ -38,7 +38,9 @@ std::unique_ptr<DAGResponseWriter> buildMPPExchangeWriter(
     UInt64 fine_grained_shuffle_stream_count,
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
-    Int64 batch_send_min_limit_compression)
+    Int64 batch_send_min_limit_compression,
+    UInt64 skew_sample_rows,
+    const String & req_id)
 {
     if (dag_context.isRootMPPTask())
     {
@@ -63,6 +65,12 @@ std::unique_ptr<DAGResponseWriter> buildMPPExchangeWriter(
 
         if (exchange_type == tipb::ExchangeType::Hash)
         {
+            PartitionSkewDetectorPtr skew_detector;
+            if (skew_sample_rows > 0 && writer->getPartitionNum() > 1)
+                skew_detector = std::make_unique<PartitionSkewDetector>(
+                    writer->getPartitionNum(),
+                    skew_sample_rows,
+                    Logger::get(req_id));
             if (enable_fine_grained_shuffle)
             {
                 return std::make_unique<FineGrainedShuffleWriter<ExchangeWriterPtr>>(
@@ -74,7 +82,8 @@ std::unique_ptr<DAGResponseWriter> buildMPPExchangeWriter(
                     fine_grained_shuffle_stream_count,
                     fine_grained_shuffle_batch_size,
                     data_codec_version,
-                    compression_mode);
+                    compression_mode,
+                    std::move(skew_detector));
             }
             else
             {
@@ -86,7 +95,8 @@ std::unique_ptr<DAGResponseWriter> buildMPPExchangeWriter(
                     max_buffered_bytes,
                     dag_context,
                     data_codec_version,
-                    compression_mode);
+                    compression_mode,
+                    std::move(skew_detector));
             }
         }
         else
@@ -118,6 +128,7 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
     Int64 batch_send_min_limit_compression,
+    UInt64 skew_sample_rows,
     const String & req_id,
     bool is_async)
 {
@@ -139,7 +150,9 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
             fine_grained_shuffle_stream_count,
             fine_grained_shuffle_batch_size,
             compression_mode,
-            batch_send_min_limit_compression);
+            batch_send_min_limit_compression,
+            skew_sample_rows,
+            req_id);
     }
     else
     {
@@ -158,7 +171,9 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
             fine_grained_shuffle_stream_count,
             fine_grained_shuffle_batch_size,
             compression_mode,
-            batch_send_min_limit_compression);
+            batch_send_min_limit_compression,
+            skew_sample_rows,
+            req_id);
     }
 }
 } // namespace DB
@@ -32,6 +32,7 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
     Int64 batch_send_min_limit_compression,
+    UInt64 skew_sample_rows,
     const String & req_id,
     bool is_async = false);
 
@@ -0,0 +1,153 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Mpp/MPPTaskManager.h>
+#include <Interpreters/Context.h>
+#include <Server/RaftConfigParser.h>
+#include <Storages/KVStore/TMTContext.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+namespace DB
+{
+namespace tests
+{
+class TestMinTSOScheduler : public testing::Test
+{
+public:
+    static constexpr UInt64 memory_limit = 100;
+
+    TestMinTSOScheduler()
+    {
+        global_context = Context::createGlobal(Context::ApplicationType::LOCAL);
+        global_context->setSetting("task_scheduler_memory_limit", memory_limit);
+        TiFlashRaftConfig raft_config;
+        global_context->createTMTContext(raft_config, pingcap::ClusterConfig());
+        task_manager = global_context->getTMTContext().getMPPTaskManager();
+    }
+
+    /// register a task of the query with `query_ts` that needs 10 threads and `estimated_memory` bytes
+    MPPTaskPtr registerTask(UInt64 query_ts, Int64 task_id, UInt64 estimated_memory)
+    {
+        auto context = std::make_shared<Context>(*global_context);
+        context->setCurrentQueryId(fmt::format("query_id_for_test_{}", query_ts));
+
+        mpp::TaskMeta task_meta;
+        task_meta.set_gather_id(1);
+        task_meta.set_task_id(task_id);
+        task_meta.set_local_query_id(1);
+        task_meta.set_query_ts(query_ts);
+        task_meta.set_server_id(1);
+        task_meta.set_start_ts(query_ts);
+        task_meta.set_resource_group_name("");
+
+        auto task = MPPTask::newTaskForTest(task_meta, context);
+        auto [registered, error_msg] = task_manager->registerTask(task.get());
+        RUNTIME_CHECK_MSG(registered, "{}", error_msg);
+        std::tie(registered, error_msg) = task_manager->makeTaskActive(task);
+        RUNTIME_CHECK_MSG(registered, "{}", error_msg);
+        task->getScheduleEntry().setEstimatedMemory(estimated_memory);
+        return task;
+    }
+
+    void finishTask(const MPPTaskPtr & task)
+    {
+        auto [unregistered, error_msg] = task_manager->unregisterTask(task->getId(), "");
+        ASSERT_TRUE(unregistered) << error_msg;
+    }
+
+    static ScheduleState getScheduleState(const MPPTaskPtr & task)
+    {
+        return task->getScheduleEntry().getScheduleState();
+    }
+
+protected:
+    std::unique_ptr<Context> global_context;
+    MPPTaskManagerPtr task_manager;
+};
+
+TEST_F(TestMinTSOScheduler, testMemoryAdmission)
+try
+{
+    /// the min_tso query
+    auto task_1 = registerTask(1, 1, 60);
+    ASSERT_TRUE(task_manager->tryToScheduleTask(task_1->getScheduleEntry()));
+    ASSERT_EQ(task_manager->getCurrentMinTSOQueryId(""), task_1->getId().gather_id.query_id);
+
+    /// 60 + 30 fits under the memory limit
+    auto task_2 = registerTask(2, 1, 30);
+    ASSERT_TRUE(task_manager->tryToScheduleTask(task_2->getScheduleEntry()));
+    /// the memory is reserved per query, so only the extra 10 is needed by the second task of the same query
+    auto task_3 = registerTask(2, 2, 40);
+    ASSERT_TRUE(task_manager->tryToScheduleTask(task_3->getScheduleEntry()));
+
+    /// 60 + 40 + 40 exceeds the memory limit, so the task waits although there are enough threads
+    auto task_4 = registerTask(3, 1, 40);
+    ASSERT_FALSE(task_manager->tryToScheduleTask(task_4->getScheduleEntry()));
+    ASSERT_EQ(getScheduleState(task_4), ScheduleState::WAITING);
+
+    /// a task without estimated memory is not limited by memory
+    auto task_5 = registerTask(4, 1, 0);
+    ASSERT_TRUE(task_manager->tryToScheduleTask(task_5->getScheduleEntry()));
+    ASSERT_EQ(getScheduleState(task_4), ScheduleState::WAITING);
+
+    /// finishing a task does not release the memory of the query before the query is deleted
+    finishTask(task_2);
+    ASSERT_EQ(getScheduleState(task_4), ScheduleState::WAITING);
+
+    /// deleting the query releases its memory, then the waiting query fits under the memory limit
+    finishTask(task_3);
+    ASSERT_EQ(getScheduleState(task_4), ScheduleState::SCHEDULED);
+    ASSERT_EQ(task_manager->getCurrentMinTSOQueryId(""), task_1->getId().gather_id.query_id);
+
+    finishTask(task_1);
+    finishTask(task_4);
+    finishTask(task_5);
+    ASSERT_EQ(task_manager->getCurrentMinTSOQueryId(""), MPPTaskId::Max_Query_Id);
+}
+CATCH
+
+TEST_F(TestMinTSOScheduler, testMinTSOBypassMemoryLimit)
+try
+{
+    /// the min_tso query is admitted although its estimated memory exceeds the memory limit
+    auto task_1 = registerTask(2, 1, 2 * memory_limit);
+    ASSERT_TRUE(task_manager->tryToScheduleTask(task_1->getScheduleEntry()));
+
+    auto task_2 = registerTask(3, 1, 80);
+    ASSERT_FALSE(task_manager->tryToScheduleTask(task_2->getScheduleEntry()));
+
+    /// an older query becomes the min_tso query, so it is admitted over the memory limit
+    auto task_3 = registerTask(1, 1, 80);
+    ASSERT_TRUE(task_manager->tryToScheduleTask(task_3->getScheduleEntry()));
+    ASSERT_EQ(task_manager->getCurrentMinTSOQueryId(""), task_3->getId().gather_id.query_id);
+    ASSERT_EQ(getScheduleState(task_2), ScheduleState::WAITING);
+
+    /// 80 + 80 still exceeds the memory limit after the first query is deleted
+    finishTask(task_1);
+    ASSERT_EQ(getScheduleState(task_2), ScheduleState::WAITING);
+
+    /// the waiting query becomes the min_tso query and is scheduled
+    finishTask(task_3);
+    ASSERT_EQ(task_manager->getCurrentMinTSOQueryId(""), task_2->getId().gather_id.query_id);
+    ASSERT_EQ(getScheduleState(task_2), ScheduleState::SCHEDULED);
+
+    finishTask(task_2);
+    ASSERT_EQ(task_manager->getCurrentMinTSOQueryId(""), MPPTaskId::Max_Query_Id);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,175 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/MemoryTracker.h>
+#include <Flash/Mpp/MPPResultCache.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+#include <tipb/executor.pb.h>
+
+#include <thread>
+
+namespace DB::tests
+{
+namespace
+{
+mpp::MPPDataPacket makePacket(size_t bytes)
+{
+    mpp::MPPDataPacket packet;
+    packet.add_chunks(String(bytes, 'a'));
+    return packet;
+}
+
+// ExchangeSender <- Selection <- TableScan
+tipb::DAGRequest makePlan(TableID table_id, tipb::ScalarFuncSig sig)
+{
+    tipb::DAGRequest dag_req;
+    dag_req.set_start_ts_fallback(100);
+    auto * sender = dag_req.mutable_root_executor();
+    sender->set_tp(tipb::ExecType::TypeExchangeSender);
+    sender->mutable_exchange_sender()->add_encoded_task_meta("receiver");
+    auto * selection = sender->mutable_exchange_sender()->mutable_child();
+    selection->set_tp(tipb::ExecType::TypeSelection);
+    auto * cond = selection->mutable_selection()->add_conditions();
+    cond->set_tp(tipb::ExprType::ScalarFunc);
+    cond->set_sig(sig);
+    auto * scan = selection->mutable_selection()->mutable_child();
+    scan->set_tp(tipb::ExecType::TypeTableScan);
+    scan->mutable_tbl_scan()->set_table_id(table_id);
+    return dag_req;
+}
+} // namespace
+
+TEST(MPPResultCacheTest, Visibility)
+try
+{
+    MPPResultCache cache(1024 * 1024);
+    auto entry = std::make_shared<MPPResultCache::Entry>();
+    entry->packets.emplace_back(0, makePacket(100));
+    entry->bytes = 100;
+    entry->read_tso = 200;
+    entry->max_write_version = 150;
+    cache.set("key", entry);
+
+    ASSERT_NE(cache.get("key", 200), nullptr);
+    ASSERT_NE(cache.get("key", 300), nullptr);
+    // Some rows are invisible to the read ts
+    ASSERT_EQ(cache.get("key", 149), nullptr);
+    ASSERT_EQ(cache.get("other", 200), nullptr);
+}
+CATCH
+
+TEST(MPPResultCacheTest, Recorder)
+try
+{
+    auto memory_tracker = MemoryTracker::create();
+    {
+        MPPResultRecorder recorder(1000, 2, memory_tracker.get());
+        recorder.record(1, makePacket(100));
+        recorder.record(0, makePacket(100));
+        recorder.record(1, makePacket(50));
+        // The copies are tracked by the memory tracker of the task until they are handed over to the cache
+        ASSERT_EQ(memory_tracker->get(), 250);
+        auto entry = recorder.finish();
+        ASSERT_EQ(memory_tracker->get(), 0);
+        ASSERT_NE(entry, nullptr);
+        ASSERT_EQ(entry->bytes, 250);
+        // The packets are grouped by tunnel, in the order they are written to the tunnel
+        ASSERT_EQ(entry->packets.size(), 3);
+        ASSERT_EQ(entry->packets[0].first, 0);
+        ASSERT_EQ(entry->packets[1].first, 1);
+        ASSERT_EQ(entry->packets[1].second.chunks(0).size(), 100);
+        ASSERT_EQ(entry->packets[2].first, 1);
+        ASSERT_EQ(entry->packets[2].second.chunks(0).size(), 50);
+    }
+    {
+        // The result is too large to be cached, the recorded packets are released at once
+        MPPResultRecorder recorder(1000, 1, memory_tracker.get());
+        for (size_t i = 0; i < 9; ++i)
+            recorder.record(0, makePacket(100));
+        ASSERT_EQ(memory_tracker->get(), 900);
+        for (size_t i = 0; i < 11; ++i)
+            recorder.record(0, makePacket(100));
+        ASSERT_EQ(memory_tracker->get(), 0);
+        ASSERT_EQ(recorder.finish(), nullptr);
+    }
+    {
+        // The memory is released if the task fails before finishing
+        MPPResultRecorder recorder(1000, 1, memory_tracker.get());
+        recorder.record(0, makePacket(100));
+        ASSERT_EQ(memory_tracker->get(), 100);
+    }
+    ASSERT_EQ(memory_tracker->get(), 0);
+}
+CATCH
+
+TEST(MPPResultCacheTest, RecorderConcurrentWrite)
+try
+{
+    constexpr size_t tunnel_num = 4;
+    constexpr size_t packets_per_writer = 1000;
+    MPPResultRecorder recorder(1024 * 1024 * 1024, tunnel_num, nullptr);
+    std::vector<std::thread> writers;
+    // Two writers for each tunnel
+    for (size_t i = 0; i < 2 * tunnel_num; ++i)
+    {
+        writers.emplace_back([&recorder, i] {
+            for (size_t j = 0; j < packets_per_writer; ++j)
+                recorder.record(i % tunnel_num, makePacket(10));
+        });
+    }
+    for (auto & writer : writers)
+        writer.join();
+
+    auto entry = recorder.finish();
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->packets.size(), 2 * tunnel_num * packets_per_writer);
+    ASSERT_EQ(entry->bytes, 2 * tunnel_num * packets_per_writer * 10);
+    for (size_t i = 0; i < entry->packets.size(); ++i)
+        ASSERT_EQ(entry->packets[i].first, i / (2 * packets_per_writer));
+}
+CATCH
+
+TEST(MPPResultCacheTest, DigestPlan)
+try
+{
+    mpp::DispatchTaskRequest task_request;
+    task_request.set_schema_ver(1);
+    std::vector<TableID> table_ids;
+
+    auto plan = makePlan(10, tipb::ScalarFuncSig::GTInt);
+    auto digest = MPPResultCache::digestPlan(plan, task_request, table_ids);
+    ASSERT_TRUE(digest.has_value());
+    ASSERT_EQ(table_ids, std::vector<TableID>{10});
+
+    // The read ts is not a part of the digest
+    plan.set_start_ts_fallback(200);
+    ASSERT_EQ(MPPResultCache::digestPlan(plan, task_request, table_ids), digest);
+    // Different table or schema version
+    ASSERT_NE(MPPResultCache::digestPlan(makePlan(11, tipb::ScalarFuncSig::GTInt), task_request, table_ids), digest);
+    task_request.set_schema_ver(2);
+    ASSERT_NE(MPPResultCache::digestPlan(plan, task_request, table_ids), digest);
+
+    // Non-deterministic functions
+    ASSERT_FALSE(MPPResultCache::digestPlan(makePlan(10, tipb::ScalarFuncSig::Rand), task_request, table_ids));
+
+    // Receives data from other tasks
+    auto * receiver = plan.mutable_root_executor()->mutable_exchange_sender()->mutable_child();
+    receiver->Clear();
+    receiver->set_tp(tipb::ExecType::TypeExchangeReceiver);
+    ASSERT_FALSE(MPPResultCache::digestPlan(plan, task_request, table_ids));
+}
+CATCH
+
+} // namespace DB::tests
@@ -0,0 +1,96 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Mpp/PartitionSkewDetector.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace DB::tests
+{
+namespace
+{
+// Generate `rows` hash values, `hot_ratio` of them are `hot_hash` and the others are random.
+WeakHash32 genHash(size_t rows, UInt32 hot_hash, double hot_ratio, std::mt19937 & gen)
+{
+    WeakHash32 hash(rows);
+    std::bernoulli_distribution is_hot(hot_ratio);
+    for (auto & h : hash.getData())
+        h = is_hot(gen) ? hot_hash : static_cast<UInt32>(gen());
+    return hash;
+}
+} // namespace
+
+TEST(PartitionSkewDetectorTest, DetectHotKey)
+try
+{
+    std::mt19937 gen(42);
+    const UInt32 hot_hash = 0xC0000000; // routed to the partition 12 of 16
+    PartitionSkewDetector detector(16, 10000, Logger::get());
+    ASSERT_TRUE(detector.isSampling());
+    for (size_t i = 0; i < 10 && detector.isSampling(); ++i)
+        detector.sample(genHash(4096, hot_hash, 0.4, gen));
+    ASSERT_FALSE(detector.isSampling());
+
+    const auto & hot_keys = detector.getHotKeys();
+    ASSERT_EQ(hot_keys.size(), 1);
+    ASSERT_EQ(hot_keys[0].hash, hot_hash);
+    ASSERT_EQ(hot_keys[0].partition_id, 12);
+    ASSERT_GT(hot_keys[0].rows, 10000 * PartitionSkewDetector::SKEW_RATIO / 16);
+    ASSERT_LE(hot_keys[0].rows, 10000);
+
+    // The rows after sampling are ignored
+    detector.sample(genHash(4096, 0, 1.0, gen));
+    ASSERT_EQ(detector.getHotKeys().size(), 1);
+}
+CATCH
+
+TEST(PartitionSkewDetectorTest, NoHotKey)
+try
+{
+    std::mt19937 gen(42);
+    {
+        // A frequent key that takes more than a fair share, but less than SKEW_RATIO times of it, is not hot
+        PartitionSkewDetector detector(16, 10000, Logger::get());
+        detector.sample(genHash(10000, 0x12345678, 0.15, gen));
+        ASSERT_FALSE(detector.isSampling());
+        ASSERT_TRUE(detector.getHotKeys().empty());
+    }
+    {
+        // With a few partitions, a key can not take SKEW_RATIO times the fair share
+        PartitionSkewDetector detector(PartitionSkewDetector::SKEW_RATIO, 10000, Logger::get());
+        detector.sample(genHash(10000, 0x12345678, 1.0, gen));
+        ASSERT_FALSE(detector.isSampling());
+        ASSERT_TRUE(detector.getHotKeys().empty());
+    }
+    {
+        // Too few rows are sampled
+        PartitionSkewDetector detector(16, PartitionSkewDetector::MIN_HOT_KEY_ROWS - 1, Logger::get());
+        detector.sample(genHash(10000, 0x12345678, 1.0, gen));
+        ASSERT_FALSE(detector.isSampling());
+        ASSERT_TRUE(detector.getHotKeys().empty());
+    }
+}
+CATCH
+
+TEST(PartitionSkewDetectorTest, PartitionId)
+{
+    ASSERT_EQ(PartitionSkewDetector::getPartitionId(0, 3), 0);
+    ASSERT_EQ(PartitionSkewDetector::getPartitionId(0xFFFFFFFF, 3), 2);
+    ASSERT_EQ(PartitionSkewDetector::getPartitionId(0x80000000, 2), 1);
+    ASSERT_EQ(PartitionSkewDetector::getPartitionId(0x7FFFFFFF, 2), 0);
+}
+
+} // namespace DB::tests
@@ -0,0 +1,53 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Mpp/PlanMemoryHistory.h>
+#include <gtest/gtest.h>
+
+namespace DB::tests
+{
+TEST(PlanMemoryHistoryTest, Record)
+{
+    PlanMemoryHistory history(16);
+    ASSERT_EQ(history.get(1), 0);
+
+    history.record(1, 1000);
+    ASSERT_EQ(history.get(1), 1000);
+    // Follow a rising peak immediately
+    history.record(1, 4000);
+    ASSERT_EQ(history.get(1), 4000);
+    // Decay slowly when the peak drops
+    history.record(1, 0);
+    ASSERT_EQ(history.get(1), 3000);
+    history.record(1, 2000);
+    ASSERT_EQ(history.get(1), 2750);
+    ASSERT_EQ(history.get(2), 0);
+}
+
+TEST(PlanMemoryHistoryTest, Evict)
+{
+    PlanMemoryHistory history(3);
+    for (UInt64 digest = 1; digest <= 3; ++digest)
+        history.record(digest, digest * 100);
+    // Update an existing plan does not change the eviction order
+    history.record(1, 1000);
+    ASSERT_EQ(history.size(), 3);
+
+    history.record(4, 400);
+    ASSERT_EQ(history.size(), 3);
+    ASSERT_EQ(history.get(1), 0);
+    ASSERT_EQ(history.get(2), 200);
+    ASSERT_EQ(history.get(4), 400);
+}
+} // namespace DB::tests
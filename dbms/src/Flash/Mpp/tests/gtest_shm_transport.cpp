@@ -0,0 +1,87 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Mpp/ShmTransport.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <kvproto/disaggregated.pb.h>
+
+#include <thread>
+
+namespace DB::tests
+{
+TEST(ShmTransportTest, Packets)
+try
+{
+    auto consumer = ShmRingBuffer::create(64);
+    auto producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+
+    std::vector<mpp::MPPDataPacket> packets(3);
+    packets[0].set_version(2);
+    packets[0].add_chunks(String(1000, 'a'));
+    packets[0].add_chunks("");
+    packets[0].add_chunks("bc");
+    packets[0].add_stream_ids(1);
+    packets[0].add_stream_ids(3);
+    packets[1].set_data(String(100, 'd'));
+    packets[2].mutable_error()->set_msg("error");
+
+    disaggregated::PagesPacket pages_packet;
+    pages_packet.add_pages(String(300, 'p'));
+    pages_packet.add_chunks("chunk");
+
+    std::thread writer([&] {
+        ShmPacketWriter packet_writer(std::move(producer));
+        for (const auto & packet : packets)
+            ASSERT_TRUE(packet_writer.write(packet));
+    });
+    mpp::MPPDataPacket packet;
+    for (const auto & expected : packets)
+    {
+        ASSERT_TRUE(ShmTransport::readPacket(*consumer, packet));
+        ASSERT_EQ(packet.SerializeAsString(), expected.SerializeAsString());
+    }
+    // The writer finishes the ring buffer when destroyed.
+    ASSERT_FALSE(ShmTransport::readPacket(*consumer, packet));
+    writer.join();
+
+    consumer = ShmRingBuffer::create(64);
+    producer = ShmRingBuffer::open(consumer->getName(), consumer->getToken());
+    ASSERT_TRUE(ShmTransport::writeMessage(*producer, pages_packet));
+    producer->finishWrite();
+    disaggregated::PagesPacket received;
+    ASSERT_TRUE(ShmTransport::readMessage(*consumer, received));
+    ASSERT_EQ(received.SerializeAsString(), pages_packet.SerializeAsString());
+    ASSERT_FALSE(ShmTransport::readMessage(*consumer, received));
+}
+CATCH
+
+TEST(ShmTransportTest, SameHostPeer)
+{
+    ASSERT_TRUE(ShmTransport::isSameHostPeer("127.0.0.1:3930"));
+    ASSERT_FALSE(ShmTransport::isSameHostPeer("192.0.2.1:3930"));
+    ASSERT_FALSE(ShmTransport::isSameHostPeer("invalid"));
+    // The results are cached by host, the port does not matter.
+    ASSERT_TRUE(ShmTransport::isSameHostPeer("127.0.0.1:3930"));
+    ASSERT_TRUE(ShmTransport::isSameHostPeer("127.0.0.1:20170"));
+    ASSERT_FALSE(ShmTransport::isSameHostPeer("192.0.2.1:20170"));
+
+    ASSERT_TRUE(ShmTransport::isSameHostGrpcPeer("ipv4:127.0.0.1:3930"));
+    ASSERT_TRUE(ShmTransport::isSameHostGrpcPeer("ipv6:[::1]:3930"));
+    ASSERT_TRUE(ShmTransport::isSameHostGrpcPeer("ipv6:%5B::1%5D:3930"));
+    ASSERT_TRUE(ShmTransport::isSameHostGrpcPeer("unix:/tmp/tiflash.sock"));
+    ASSERT_FALSE(ShmTransport::isSameHostGrpcPeer("ipv4:192.0.2.1:3930"));
+    ASSERT_FALSE(ShmTransport::isSameHostGrpcPeer("127.0.0.1:3930"));
+}
+
+} // namespace DB::tests
@@ -0,0 +1,124 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Exec/AdaptiveConcurrencyController.h>
+#include <common/logger_useful.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace DB
+{
+AdaptiveConcurrencyController::AdaptiveConcurrencyController(
+    size_t running_,
+    PipelineExecGroup && parked_,
+    Spawner && spawner_,
+    const LoggerPtr & log_)
+    : running(running_)
+    , parked(std::move(parked_))
+    , parked_count(parked.size())
+    , spawner(std::move(spawner_))
+    , log(log_)
+    , initial_running(running_)
+{
+    RUNTIME_CHECK(running > 0);
+    RUNTIME_CHECK(spawner);
+}
+
+AdaptiveConcurrencyController::~AdaptiveConcurrencyController()
+{
+    LOG_DEBUG(
+        log,
+        "adaptive concurrency finished, initial_running={} max_concurrency={} spawned={} retired={} unused={}",
+        initial_running,
+        initial_running + spawned + parked.size(),
+        spawned,
+        retired,
+        parked.size());
+}
+
+bool AdaptiveConcurrencyController::isAdaptive(const PipelineExecGroup & pipeline_exec_group)
+{
+    if (pipeline_exec_group.size() <= 1)
+        return false;
+    return std::all_of(pipeline_exec_group.cbegin(), pipeline_exec_group.cend(), [](const auto & pipeline_exec) {
+        return pipeline_exec->isSharedInput();
+    });
+}
+
+size_t AdaptiveConcurrencyController::getInitialConcurrency(const PipelineExecGroup & pipeline_exec_group)
+{
+    const size_t max_concurrency = pipeline_exec_group.size();
+    // All the instances read from the same input, so any instance can give the hint.
+    const size_t hint = pipeline_exec_group.front()->getInitialConcurrencyHint();
+    return hint == 0 ? max_concurrency : std::clamp<size_t>(hint, 1, max_concurrency);
+}
+
+void AdaptiveConcurrencyController::onProgress(size_t backlog)
+{
+    const size_t prev_backlog = last_backlog.exchange(backlog);
+    if (parked_count.load() == 0)
+        return;
+    // Only spawn when the running instances can not keep up with the shared input,
+    // that is, there are more ready blocks than running instances and the backlog is not decreasing.
+    if (backlog <= running.load() || backlog < prev_backlog)
+        return;
+    spawnParked(1);
+}
+
+bool AdaptiveConcurrencyController::tryRetire(size_t idle_rounds)
+{
+    if (idle_rounds < RETIRE_IDLE_ROUNDS)
+        return false;
+    size_t cur_running = running.load();
+    while (cur_running > 1)
+    {
+        if (running.compare_exchange_weak(cur_running, cur_running - 1))
+        {
+            ++retired;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AdaptiveConcurrencyController::onInputFinish()
+{
+    --running;
+    // The shared input is drained, the parked instances will finish immediately after they are spawned.
+    spawnParked(std::numeric_limits<size_t>::max());
+}
+
+void AdaptiveConcurrencyController::spawnParked(size_t count)
+{
+    PipelineExecGroup to_spawn;
+    {
+        std::lock_guard lock(mu);
+        while (count > 0 && !parked.empty())
+        {
+            to_spawn.push_back(std::move(parked.back()));
+            parked.pop_back();
+            --count;
+        }
+        parked_count = parked.size();
+    }
+    if (to_spawn.empty())
+        return;
+
+    running += to_spawn.size();
+    spawned += to_spawn.size();
+    for (auto & pipeline_exec : to_spawn)
+        spawner(std::move(pipeline_exec));
+}
+} // namespace DB
@@ -0,0 +1,95 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Flash/Pipeline/Exec/PipelineExec.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace DB
+{
+/// AdaptiveConcurrencyController adjusts the number of running instances of a pipeline at runtime.
+/// It only works for the pipelines whose instances read from one shared input, such as the table scan of
+/// `UnorderedSourceOp`, so that any instance can read the rest of the input.
+///
+/// The concurrency decided at plan time is the upper limit, it is also the number of threads reserved by
+/// `MinTSOScheduler`. At the beginning, only a part of the instances are running and the others are parked.
+/// - A parked instance is spawned when the backlog of the shared input is more than the running instances
+///   can consume and keeps growing.
+/// - A running instance retires, i.e. finishes before the shared input is drained, when it keeps waiting for
+///   the shared input. The last running instance never retires.
+/// - When a running instance reads the end of the shared input, the parked instances are spawned so that
+///   all the operators finish normally.
+class AdaptiveConcurrencyController
+{
+public:
+    using Spawner = std::function<void(PipelineExecPtr &&)>;
+
+    // The number of blocks processed by a running instance between two backlog checks.
+    static constexpr size_t CHECK_INTERVAL = 8;
+    // The number of consecutive rounds that a running instance waits for the shared input before it retires.
+    static constexpr size_t RETIRE_IDLE_ROUNDS = 3;
+
+    AdaptiveConcurrencyController(
+        size_t running_,
+        PipelineExecGroup && parked_,
+        Spawner && spawner_,
+        const LoggerPtr & log_);
+
+    ~AdaptiveConcurrencyController();
+
+    /// Returns true if the number of running instances of the pipeline can be adjusted at runtime.
+    static bool isAdaptive(const PipelineExecGroup & pipeline_exec_group);
+
+    /// Returns the number of instances to run at the beginning, only valid if `isAdaptive` returns true.
+    static size_t getInitialConcurrency(const PipelineExecGroup & pipeline_exec_group);
+
+    /// Called by a running instance every `CHECK_INTERVAL` blocks.
+    void onProgress(size_t backlog);
+
+    /// Called by a running instance waiting for the shared input. Returns true if the instance should retire.
+    bool tryRetire(size_t idle_rounds);
+
+    /// Called by a running instance that reads the end of the shared input.
+    void onInputFinish();
+
+    size_t getRunningCount() const { return running.load(); }
+
+    size_t getParkedCount() const { return parked_count.load(); }
+
+private:
+    void spawnParked(size_t count);
+
+private:
+    std::atomic<size_t> running;
+    std::atomic<size_t> last_backlog{0};
+
+    std::mutex mu;
+    PipelineExecGroup parked;
+    std::atomic<size_t> parked_count;
+
+    Spawner spawner;
+
+    LoggerPtr log;
+
+    const size_t initial_running;
+    std::atomic<size_t> spawned{0};
+    std::atomic<size_t> retired{0};
+};
+using AdaptiveConcurrencyControllerPtr = std::unique_ptr<AdaptiveConcurrencyController>;
+} // namespace DB
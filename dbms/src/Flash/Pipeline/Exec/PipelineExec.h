@@ -45,6 +45,22 @@ public:
 
     void finalizeProfileInfo(UInt64 queuing_time, UInt64 pipeline_breaker_wait_time);
 
+    bool isSharedInput() const { return source_op->isSharedInput(); }
+
+    size_t getSourceBacklog() const { return source_op->getBacklog(); }
+
+    size_t getInitialConcurrencyHint() const { return source_op->getInitialConcurrencyHint(); }
+
+    bool isWaitingForSource() const { return waiting_for_notify == source_op.get(); }
+
+    // Stop reading the shared input when waiting for the source, the following `execute` finishes this instance.
+    void retire()
+    {
+        assert(isWaitingForSource());
+        waiting_for_notify = nullptr;
+        source_op->retire();
+    }
+
 private:
     inline OperatorStatus executeImpl();
 
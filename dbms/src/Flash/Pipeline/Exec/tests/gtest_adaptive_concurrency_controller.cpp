@@ -0,0 +1,113 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Exec/AdaptiveConcurrencyController.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+namespace DB::tests
+{
+namespace
+{
+// The controller never touches the parked instances except handing them to the spawner.
+PipelineExecGroup genParked(size_t count)
+{
+    PipelineExecGroup parked;
+    parked.resize(count);
+    return parked;
+}
+} // namespace
+
+TEST(AdaptiveConcurrencyControllerTest, SpawnOnBacklog)
+try
+{
+    size_t spawned = 0;
+    AdaptiveConcurrencyController controller(
+        2,
+        genParked(3),
+        [&](PipelineExecPtr &&) { ++spawned; },
+        Logger::get());
+    ASSERT_EQ(controller.getRunningCount(), 2);
+    ASSERT_EQ(controller.getParkedCount(), 3);
+
+    // The running instances can keep up with the backlog
+    controller.onProgress(2);
+    ASSERT_EQ(spawned, 0);
+
+    // The backlog is more than the running instances and keeps growing
+    controller.onProgress(5);
+    ASSERT_EQ(spawned, 1);
+    ASSERT_EQ(controller.getRunningCount(), 3);
+    ASSERT_EQ(controller.getParkedCount(), 2);
+
+    // The backlog is decreasing
+    controller.onProgress(4);
+    ASSERT_EQ(spawned, 1);
+
+    controller.onProgress(6);
+    controller.onProgress(7);
+    ASSERT_EQ(spawned, 3);
+    ASSERT_EQ(controller.getRunningCount(), 5);
+    ASSERT_EQ(controller.getParkedCount(), 0);
+
+    // No more parked instances
+    controller.onProgress(100);
+    ASSERT_EQ(spawned, 3);
+}
+CATCH
+
+TEST(AdaptiveConcurrencyControllerTest, Retire)
+try
+{
+    size_t spawned = 0;
+    AdaptiveConcurrencyController controller(
+        3,
+        genParked(1),
+        [&](PipelineExecPtr &&) { ++spawned; },
+        Logger::get());
+
+    ASSERT_FALSE(controller.tryRetire(AdaptiveConcurrencyController::RETIRE_IDLE_ROUNDS - 1));
+    ASSERT_TRUE(controller.tryRetire(AdaptiveConcurrencyController::RETIRE_IDLE_ROUNDS));
+    ASSERT_TRUE(controller.tryRetire(AdaptiveConcurrencyController::RETIRE_IDLE_ROUNDS));
+    ASSERT_EQ(controller.getRunningCount(), 1);
+    // The last running instance never retires
+    ASSERT_FALSE(controller.tryRetire(AdaptiveConcurrencyController::RETIRE_IDLE_ROUNDS));
+    ASSERT_EQ(controller.getRunningCount(), 1);
+    ASSERT_EQ(spawned, 0);
+}
+CATCH
+
+TEST(AdaptiveConcurrencyControllerTest, InputFinish)
+try
+{
+    size_t spawned = 0;
+    AdaptiveConcurrencyController controller(
+        2,
+        genParked(4),
+        [&](PipelineExecPtr &&) { ++spawned; },
+        Logger::get());
+
+    // All the parked instances are spawned to finish the pipeline
+    controller.onInputFinish();
+    ASSERT_EQ(spawned, 4);
+    ASSERT_EQ(controller.getParkedCount(), 0);
+    ASSERT_EQ(controller.getRunningCount(), 5);
+
+    controller.onInputFinish();
+    ASSERT_EQ(spawned, 4);
+    ASSERT_EQ(controller.getRunningCount(), 4);
+}
+CATCH
+
+} // namespace DB::tests
@@ -161,6 +161,14 @@ void Event::scheduleTasks()
     }
 }
 
+void Event::scheduleAdditionalTask(TaskPtr && task)
+{
+    assertStatus(EventStatus::SCHEDULED);
+    int32_t prev_tasks = unfinished_tasks.fetch_add(1);
+    RUNTIME_ASSERT(prev_tasks > 0, log, "unfinished_tasks must > 0, but actual value is {}", prev_tasks);
+    TaskScheduler::instance->submit(std::move(task));
+}
+
 void Event::onTaskFinish(const TaskProfileInfo & task_profile_info)
 {
     assertStatus(EventStatus::SCHEDULED);
@@ -72,6 +72,10 @@ protected:
     /// This method can only be called in finishImpl and is used to dynamically adjust the topology of events.
     void insertEvent(const EventPtr & insert_event);
 
+    /// Schedule one more task after the event is scheduled. This method can only be called by a running task
+    /// of this event, which guarantees that the event is not finished concurrently.
+    void scheduleAdditionalTask(TaskPtr && task);
+
 private:
     void scheduleTasks();
 
@@ -15,6 +15,7 @@
 #include <Flash/Pipeline/Pipeline.h>
 #include <Flash/Pipeline/Schedule/Events/Impls/PlainPipelineEvent.h>
 #include <Flash/Pipeline/Schedule/Tasks/Impls/PipelineTask.h>
+#include <Interpreters/Context.h>
 
 namespace DB
 {
@@ -23,16 +24,47 @@ void PlainPipelineEvent::scheduleImpl()
     RUNTIME_CHECK(pipeline);
     auto pipeline_exec_group = pipeline->buildExecGroup(exec_context, context, concurrency);
     RUNTIME_CHECK(!pipeline_exec_group.empty());
+
+    if (context.getSettingsRef().enable_adaptive_pipeline_concurrency
+        && AdaptiveConcurrencyController::isAdaptive(pipeline_exec_group))
+    {
+        const size_t running = AdaptiveConcurrencyController::getInitialConcurrency(pipeline_exec_group);
+        LOG_DEBUG(
+            log,
+            "adaptive concurrency is enabled, initial_running={} max_concurrency={}",
+            running,
+            pipeline_exec_group.size());
+        PipelineExecGroup parked;
+        for (size_t i = running; i < pipeline_exec_group.size(); ++i)
+            parked.push_back(std::move(pipeline_exec_group[i]));
+        pipeline_exec_group.resize(running);
+        concurrency_controller = std::make_unique<AdaptiveConcurrencyController>(
+            running,
+            std::move(parked),
+            [this](PipelineExecPtr && pipeline_exec) {
+                scheduleAdditionalTask(std::make_unique<PipelineTask>(
+                    exec_context,
+                    log->identifier(),
+                    shared_from_this(),
+                    std::move(pipeline_exec),
+                    concurrency_controller.get()));
+            },
+            log);
+    }
+
     for (auto & pipeline_exec : pipeline_exec_group)
         addTask(std::make_unique<PipelineTask>(
             exec_context,
             log->identifier(),
             shared_from_this(),
-            std::move(pipeline_exec)));
+            std::move(pipeline_exec),
+            concurrency_controller.get()));
 }
 
 void PlainPipelineEvent::finishImpl()
 {
+    // The parked instances that are never spawned hold the resources of the pipeline too.
+    concurrency_controller.reset();
     if (auto complete_event = pipeline->complete(exec_context); complete_event)
         insertEvent(complete_event);
     // Plan nodes in pipeline hold resources like hash table for join, when destruction they will operate memory tracker in MPP task. But MPP task may get destructed once `exec_context.decActiveRefCount()` is called.
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Flash/Pipeline/Exec/AdaptiveConcurrencyController.h>
 #include <Flash/Pipeline/Schedule/Events/Event.h>
 
 namespace DB
@@ -47,5 +48,6 @@ private:
     Context & context;
     PipelinePtr pipeline;
     size_t concurrency;
+    AdaptiveConcurrencyControllerPtr concurrency_controller;
 };
 } // namespace DB
@@ -0,0 +1,338 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Debug/TiFlashTestEnv.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Pipeline.h>
+#include <Flash/Pipeline/Schedule/Events/Impls/PlainPipelineEvent.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
+#include <Flash/Pipeline/Schedule/Tasks/PipeConditionVariable.h>
+#include <Flash/Planner/Plans/PhysicalLeaf.h>
+#include <Flash/ResourceControl/LocalAdmissionController.h>
+#include <Interpreters/Context.h>
+#include <Operators/Operator.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+
+namespace DB::tests
+{
+namespace
+{
+Block genHeader()
+{
+    return Block{{ColumnInt64::create(), std::make_shared<DataTypeInt64>(), "a"}};
+}
+
+struct InstanceStats
+{
+    std::atomic_size_t started{0};
+    std::atomic_size_t finished{0};
+    std::atomic_size_t retired{0};
+    std::atomic_size_t destroyed{0};
+    std::atomic_size_t rows{0};
+};
+
+/// The input shared by all the instances of a pipeline, like the `SegmentReadTaskPool` of `UnorderedSourceOp`.
+class SharedInput : public NotifyFuture
+{
+public:
+    SharedInput(size_t initial_concurrency_, bool wake_immediately_)
+        : initial_concurrency(initial_concurrency_)
+        , wake_immediately(wake_immediately_)
+    {}
+
+    // Returns false if no block is ready, an empty block means the input is drained.
+    bool tryPop(Block & block)
+    {
+        std::lock_guard lock(mu);
+        if (blocks.empty())
+            return finished;
+        block = std::move(blocks.front());
+        blocks.pop_front();
+        return true;
+    }
+
+    size_t getBacklog() const
+    {
+        std::lock_guard lock(mu);
+        return blocks.size();
+    }
+
+    // Push the last blocks together with the end of the input, so that no instance waits for the input again.
+    void finish(Blocks && last_blocks)
+    {
+        {
+            std::lock_guard lock(mu);
+            for (auto & block : last_blocks)
+                blocks.push_back(std::move(block));
+            finished = true;
+        }
+        pipe_cv.notifyAll();
+    }
+
+    void notifyAll() { pipe_cv.notifyAll(); }
+
+    void registerTask(TaskPtr && task) override
+    {
+        task->setNotifyType(NotifyType::WAIT_ON_TABLE_SCAN_READ);
+        // Simulate the read threads that keep waking the waiting tasks without producing blocks.
+        if (wake_immediately)
+        {
+            PipeConditionVariable::notifyTaskDirectly(std::move(task));
+            return;
+        }
+        pipe_cv.registerTask(std::move(task));
+        ++waiting_tasks;
+    }
+
+    const size_t initial_concurrency;
+    std::atomic_size_t waiting_tasks{0};
+
+private:
+    const bool wake_immediately;
+
+    mutable std::mutex mu;
+    std::deque<Block> blocks;
+    bool finished = false;
+
+    PipeConditionVariable pipe_cv;
+};
+using SharedInputPtr = std::shared_ptr<SharedInput>;
+
+class SharedInputSourceOp : public SourceOp
+{
+public:
+    SharedInputSourceOp(PipelineExecutorContext & exec_context_, const SharedInputPtr & input_, InstanceStats & stats_)
+        : SourceOp(exec_context_, "")
+        , input(input_)
+        , stats(stats_)
+    {
+        setHeader(genHeader());
+    }
+
+    ~SharedInputSourceOp() override { ++stats.destroyed; }
+
+    String getName() const override { return "SharedInputSourceOp"; }
+
+    bool isSharedInput() const override { return true; }
+
+    size_t getBacklog() const override { return input->getBacklog(); }
+
+    size_t getInitialConcurrencyHint() const override { return input->initial_concurrency; }
+
+    void retire() override
+    {
+        done = true;
+        ++stats.retired;
+    }
+
+protected:
+    OperatorStatus readImpl(Block & block) override
+    {
+        if (done)
+            return OperatorStatus::HAS_OUTPUT;
+        if (!input->tryPop(block))
+        {
+            setNotifyFuture(input.get());
+            return OperatorStatus::WAIT_FOR_NOTIFY;
+        }
+        done = !block;
+        return OperatorStatus::HAS_OUTPUT;
+    }
+
+private:
+    SharedInputPtr input;
+    InstanceStats & stats;
+    bool done = false;
+};
+
+class CountRowsSinkOp : public SinkOp
+{
+public:
+    CountRowsSinkOp(PipelineExecutorContext & exec_context_, InstanceStats & stats_)
+        : SinkOp(exec_context_, "")
+        , stats(stats_)
+    {
+        setHeader(genHeader());
+    }
+
+    String getName() const override { return "CountRowsSinkOp"; }
+
+protected:
+    void operatePrefixImpl() override { ++stats.started; }
+
+    void operateSuffixImpl() override { ++stats.finished; }
+
+    OperatorStatus writeImpl(Block && block) override
+    {
+        if (!block)
+            return OperatorStatus::FINISHED;
+        stats.rows += block.rows();
+        return OperatorStatus::NEED_INPUT;
+    }
+
+private:
+    InstanceStats & stats;
+};
+
+class PhysicalSharedInputScan : public PhysicalLeaf
+{
+public:
+    PhysicalSharedInputScan(const SharedInputPtr & input_, InstanceStats & stats_)
+        : PhysicalLeaf("shared_input_scan", PlanType::MockTableScan, {}, FineGrainedShuffle{}, "")
+        , input(input_)
+        , stats(stats_)
+        , sample_block(genHeader())
+    {
+        notTiDBOperator();
+    }
+
+    void finalizeImpl(const Names &) override {}
+
+    const Block & getSampleBlock() const override { return sample_block; }
+
+private:
+    void buildPipelineExecGroupImpl(
+        PipelineExecutorContext & exec_context,
+        PipelineExecGroupBuilder & group_builder,
+        Context &,
+        size_t concurrency) override
+    {
+        for (size_t i = 0; i < concurrency; ++i)
+            group_builder.addConcurrency(std::make_unique<SharedInputSourceOp>(exec_context, input, stats));
+        group_builder.transform([&](auto & builder) {
+            builder.setSinkOp(std::make_unique<CountRowsSinkOp>(exec_context, stats));
+        });
+    }
+
+    SharedInputPtr input;
+    InstanceStats & stats;
+    Block sample_block;
+};
+} // namespace
+
+class AdaptivePipelineConcurrencyTestRunner : public ::testing::Test
+{
+public:
+    static constexpr size_t max_concurrency = 4;
+
+    void schedule(PipelineExecutorContext & exec_context, const SharedInputPtr & input, InstanceStats & stats)
+    {
+        auto pipeline = std::make_shared<Pipeline>(0, "");
+        pipeline->addPlanNode(std::make_shared<PhysicalSharedInputScan>(input, stats));
+        auto event = std::make_shared<PlainPipelineEvent>(exec_context, "", *context, pipeline, max_concurrency);
+        ASSERT_TRUE(event->prepare());
+        event->schedule();
+    }
+
+    static void wait(PipelineExecutorContext & exec_context)
+    {
+        std::chrono::seconds timeout(15);
+        exec_context.waitFor(timeout);
+    }
+
+    template <typename Pred>
+    static bool waitUntil(Pred && pred)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(15);
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+protected:
+    static constexpr size_t thread_num = 5;
+
+    void SetUp() override
+    {
+        DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
+        TaskSchedulerConfig config{thread_num, thread_num};
+        assert(!TaskScheduler::instance);
+        TaskScheduler::instance = std::make_unique<TaskScheduler>(config);
+
+        context = TiFlashTestEnv::getContext();
+        context->setSetting("enable_adaptive_pipeline_concurrency", "true");
+    }
+
+    void TearDown() override
+    {
+        assert(TaskScheduler::instance);
+        TaskScheduler::instance.reset();
+    }
+
+    ContextPtr context;
+};
+
+TEST_F(AdaptivePipelineConcurrencyTestRunner, retireAndSpawn)
+try
+{
+    InstanceStats stats;
+    auto input = std::make_shared<SharedInput>(3, /*wake_immediately=*/true);
+    PipelineExecutorContext exec_context;
+    schedule(exec_context, input, stats);
+
+    // The running instances keep waiting for the empty input, so all of them except the last one retire.
+    ASSERT_TRUE(waitUntil([&] { return stats.retired == 2; }));
+    ASSERT_EQ(stats.started.load(), 3);
+
+    Blocks blocks;
+    for (size_t i = 0; i < 100; ++i)
+        blocks.push_back(Block{{ColumnInt64::create(10, 1), std::make_shared<DataTypeInt64>(), "a"}});
+    input->finish(std::move(blocks));
+    wait(exec_context);
+    ASSERT_TRUE(!exec_context.getExceptionPtr()) << exec_context.getExceptionMsg();
+
+    // The parked instance is spawned by `Event::scheduleAdditionalTask` before the pipeline finishes.
+    ASSERT_EQ(stats.rows.load(), 1000);
+    ASSERT_EQ(stats.retired.load(), 2);
+    ASSERT_EQ(stats.started.load(), max_concurrency);
+    ASSERT_EQ(stats.finished.load(), max_concurrency);
+    ASSERT_EQ(stats.destroyed.load(), max_concurrency);
+}
+CATCH
+
+TEST_F(AdaptivePipelineConcurrencyTestRunner, cancelWithParkedInstances)
+try
+{
+    InstanceStats stats;
+    auto input = std::make_shared<SharedInput>(2, /*wake_immediately=*/false);
+    PipelineExecutorContext exec_context;
+    schedule(exec_context, input, stats);
+
+    ASSERT_TRUE(waitUntil([&] { return input->waiting_tasks == 2; }));
+    ASSERT_EQ(stats.started.load(), 2);
+
+    exec_context.cancel();
+    // The cancelled tasks are woken like the ones waiting for a real read task pool.
+    input->notifyAll();
+    wait(exec_context);
+
+    // The parked instances are never started, but they are destroyed when the event finishes.
+    ASSERT_EQ(stats.started.load(), 2);
+    ASSERT_EQ(stats.retired.load(), 0);
+    ASSERT_EQ(stats.destroyed.load(), max_concurrency);
+}
+CATCH
+
+} // namespace DB::tests
@@ -0,0 +1,245 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/FairShareQueue.h>
+#include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
+#include <common/likely.h>
+
+#include <algorithm>
+
+namespace DB
+{
+FairShareQueue::~FairShareQueue()
+{
+    drainTaskQueueWithoutLock();
+}
+
+void FairShareQueue::submitTaskWithoutLock(TaskPtr && task)
+{
+    if unlikely (is_finished)
+    {
+        FINALIZE_TASK(task);
+        return;
+    }
+
+    if unlikely (cancel_query_id_cache.contains(task->getQueryId()))
+    {
+        cancel_task_queue.push_back(std::move(task));
+        return;
+    }
+
+    auto [iter, inserted] = queries.try_emplace(task->getQueryId());
+    auto & query = iter->second;
+    if (inserted)
+        query.weight = std::max<UInt64>(task->getQueryWeight(), 1);
+    if (query.tasks.empty())
+    {
+        query.vruntime = std::max(query.vruntime, min_vruntime);
+        runnable_queries.emplace(query.vruntime, iter->first);
+        runnable_query_count.store(runnable_queries.size(), std::memory_order_relaxed);
+        updateMinVruntimeWithoutLock();
+    }
+    query.tasks.push_back(std::move(task));
+}
+
+void FairShareQueue::submit(TaskPtr && task)
+{
+    {
+        std::lock_guard lock(mu);
+        submitTaskWithoutLock(std::move(task));
+    }
+    cv.notify_one();
+}
+
+void FairShareQueue::submit(std::vector<TaskPtr> & tasks)
+{
+    if (tasks.empty())
+        return;
+
+    std::lock_guard lock(mu);
+    for (auto & task : tasks)
+    {
+        submitTaskWithoutLock(std::move(task));
+        cv.notify_one();
+    }
+}
+
+bool FairShareQueue::take(TaskPtr & task)
+{
+    assert(!task);
+    std::unique_lock lock(mu);
+    while (true)
+    {
+        // Remaining tasks will be drained in destructor.
+        if unlikely (is_finished)
+            return false;
+
+        if (takeWithoutLock(task))
+            return true;
+        cv.wait(lock);
+    }
+}
+
+bool FairShareQueue::tryTake(TaskPtr & task)
+{
+    assert(!task);
+    std::lock_guard lock(mu);
+    return !is_finished && takeWithoutLock(task);
+}
+
+bool FairShareQueue::takeWithoutLock(TaskPtr & task)
+{
+    if (popTask(cancel_task_queue, task))
+        return true;
+
+    if (runnable_queries.empty())
+        return false;
+
+    auto first = runnable_queries.begin();
+    auto & query = queries.at(first->second);
+    task = std::move(query.tasks.front());
+    query.tasks.pop_front();
+    ++query.running_tasks;
+    if (query.tasks.empty())
+    {
+        runnable_queries.erase(first);
+        runnable_query_count.store(runnable_queries.size(), std::memory_order_relaxed);
+    }
+    updateMinVruntimeWithoutLock();
+    assert(task);
+    return true;
+}
+
+void FairShareQueue::updateStatistics(const TaskPtr & task, ExecTaskStatus, UInt64 inc_ns)
+{
+    assert(task);
+    std::lock_guard lock(mu);
+    auto iter = queries.find(task->getQueryId());
+    // The query is cancelled.
+    if unlikely (iter == queries.end())
+        return;
+
+    auto & query = iter->second;
+    assert(query.running_tasks > 0);
+    --query.running_tasks;
+    const UInt64 inc_vruntime = inc_ns * PipelineExecutorContext::DEFAULT_QUERY_WEIGHT / query.weight;
+    if (query.tasks.empty())
+    {
+        query.vruntime += inc_vruntime;
+    }
+    else
+    {
+        runnable_queries.erase({query.vruntime, iter->first});
+        query.vruntime += inc_vruntime;
+        runnable_queries.emplace(query.vruntime, iter->first);
+    }
+    updateMinVruntimeWithoutLock();
+
+    if (queries.size() > runnable_queries.size() + IDLE_QUERY_CLEAN_THRESHOLD)
+        removeIdleQueriesWithoutLock();
+}
+
+void FairShareQueue::updateMinVruntimeWithoutLock()
+{
+    if (!runnable_queries.empty())
+        min_vruntime = std::max(min_vruntime, runnable_queries.begin()->first);
+}
+
+void FairShareQueue::removeIdleQueriesWithoutLock()
+{
+    std::erase_if(queries, [&](const auto & item) {
+        return item.second.tasks.empty() && item.second.running_tasks == 0 && item.second.vruntime <= min_vruntime;
+    });
+}
+
+UInt64 FairShareQueue::getYieldTimeNs(const TaskPtr &) const
+{
+    const size_t runnable_count = runnable_query_count.load(std::memory_order_relaxed);
+    if (runnable_count <= 1)
+        return YIELD_MAX_TIME_SPENT_NS;
+    return std::max(TARGET_LATENCY_NS / runnable_count, MIN_GRANULARITY_NS);
+}
+
+bool FairShareQueue::empty() const
+{
+    std::lock_guard lock(mu);
+    return runnable_queries.empty() && cancel_task_queue.empty();
+}
+
+void FairShareQueue::finish()
+{
+    {
+        std::lock_guard lock(mu);
+        is_finished = true;
+    }
+    cv.notify_all();
+}
+
+void FairShareQueue::cancel(const TaskCancelInfo & cancel_info)
+{
+    if unlikely (cancel_info.query_id.empty())
+        return;
+
+    std::lock_guard lock(mu);
+    if (cancel_query_id_cache.add(cancel_info.query_id))
+    {
+        collectCancelledTasksWithoutLock(cancel_task_queue, cancel_info.query_id);
+        cv.notify_all();
+    }
+}
+
+void FairShareQueue::collectCancelledTasks(std::deque<TaskPtr> & cancel_queue, const String & query_id)
+{
+    // Unlike the other queues, `updateStatistics` is not protected by the lock of `ResourceControlQueue`.
+    std::lock_guard lock(mu);
+    collectCancelledTasksWithoutLock(cancel_queue, query_id);
+}
+
+void FairShareQueue::collectCancelledTasksWithoutLock(std::deque<TaskPtr> & cancel_queue, const String & query_id)
+{
+    auto iter = queries.find(query_id);
+    if (iter == queries.end())
+        return;
+
+    auto & query = iter->second;
+    if (!query.tasks.empty())
+    {
+        runnable_queries.erase({query.vruntime, iter->first});
+        runnable_query_count.store(runnable_queries.size(), std::memory_order_relaxed);
+    }
+    for (auto & task : query.tasks)
+        cancel_queue.push_back(std::move(task));
+    queries.erase(iter);
+}
+
+void FairShareQueue::drainTaskQueueWithoutLock()
+{
+    TaskPtr task;
+    while (popTask(cancel_task_queue, task))
+    {
+        FINALIZE_TASK(task);
+    }
+
+    for (auto & [query_id, query] : queries)
+    {
+        while (popTask(query.tasks, task))
+        {
+            FINALIZE_TASK(task);
+        }
+    }
+    queries.clear();
+    runnable_queries.clear();
+}
+} // namespace DB
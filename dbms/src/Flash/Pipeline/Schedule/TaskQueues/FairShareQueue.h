@@ -0,0 +1,110 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/TaskQueues/FIFOQueryIdCache.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/TaskQueue.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace DB
+{
+/// FairShareQueue shares the cpu time among queries in proportion to their weights, like the CFS of linux.
+/// Each query has a virtual runtime, which increases by `execute_time * DEFAULT_QUERY_WEIGHT / query_weight`
+/// when its tasks are executed, and the tasks of the query with the smallest virtual runtime are taken first.
+/// Unlike MLFQ, a long-running query does not compete evenly with the other queries once they all sink into
+/// the lowest level, it always gets its fair share.
+///
+/// A query that becomes runnable again starts from the smallest virtual runtime of the runnable queries, so
+/// it can not accumulate credits while it is idle.
+/// The time slice of a task shrinks as the number of runnable queries grows, so the tasks of a query are
+/// preempted at the operator boundaries more often when there are more queries to share the cpu.
+class FairShareQueue : public TaskQueue
+{
+public:
+    // The time slices of all the runnable queries add up to `TARGET_LATENCY_NS`,
+    // but each time slice is at least `MIN_GRANULARITY_NS`.
+    static constexpr UInt64 TARGET_LATENCY_NS = YIELD_MAX_TIME_SPENT_NS;
+    static constexpr UInt64 MIN_GRANULARITY_NS = 5'000'000L;
+
+    ~FairShareQueue() override;
+
+    void submit(TaskPtr && task) override;
+
+    void submit(std::vector<TaskPtr> & tasks) override;
+
+    bool take(TaskPtr & task) override;
+
+    bool tryTake(TaskPtr & task) override;
+
+    void updateStatistics(const TaskPtr & task, ExecTaskStatus, UInt64 inc_ns) override;
+
+    bool empty() const override;
+
+    void finish() override;
+
+    void cancel(const TaskCancelInfo & cancel_info) override;
+
+    UInt64 getYieldTimeNs(const TaskPtr & task) const override;
+
+    void collectCancelledTasks(std::deque<TaskPtr> & cancel_queue, const String & query_id);
+
+#ifndef DBMS_PUBLIC_GTEST
+private:
+#endif
+    struct QueryEntity
+    {
+        UInt64 weight = 0;
+        UInt64 vruntime = 0;
+        std::deque<TaskPtr> tasks;
+        // The tasks taken but not returned by `updateStatistics` yet.
+        size_t running_tasks = 0;
+    };
+
+    // The idle queries are only kept for their virtual runtime, and removed once it is not larger than `min_vruntime`.
+    // A query is not idle while some of its tasks are running, even if it has no pending tasks.
+    static constexpr size_t IDLE_QUERY_CLEAN_THRESHOLD = 64;
+
+    void submitTaskWithoutLock(TaskPtr && task);
+
+    bool takeWithoutLock(TaskPtr & task);
+
+    void collectCancelledTasksWithoutLock(std::deque<TaskPtr> & cancel_queue, const String & query_id);
+
+    void updateMinVruntimeWithoutLock();
+
+    void removeIdleQueriesWithoutLock();
+
+    void drainTaskQueueWithoutLock();
+
+    mutable std::mutex mu;
+    std::condition_variable cv;
+    bool is_finished = false;
+
+    std::unordered_map<String, QueryEntity> queries;
+    // <vruntime, query_id> of the queries that have pending tasks.
+    std::set<std::pair<UInt64, String>> runnable_queries;
+    std::atomic<size_t> runnable_query_count{0};
+    // Only increases.
+    UInt64 min_vruntime = 0;
+
+    FIFOQueryIdCache cancel_query_id_cache;
+    std::deque<TaskPtr> cancel_task_queue;
+};
+} // namespace DB
@@ -52,20 +52,29 @@ bool IOPriorityQueue::take(TaskPtr & task)
         if (unlikely(is_finished))
             return false;
 
-        if (popTask(cancel_task_queue, task))
-            return true;
-
-        bool io_out_first = ratio_of_out_to_in * total_io_in_time_microsecond >= total_io_out_time_microsecond;
-        auto & first_queue = io_out_first ? io_out_task_queue : io_in_task_queue;
-        auto & next_queue = io_out_first ? io_in_task_queue : io_out_task_queue;
-        if (popTask(first_queue, task))
-            return true;
-        if (popTask(next_queue, task))
+        if (takeWithoutLock(task))
             return true;
         cv.wait(lock);
     }
 }
 
+bool IOPriorityQueue::tryTake(TaskPtr & task)
+{
+    std::lock_guard lock(mu);
+    return !is_finished && takeWithoutLock(task);
+}
+
+bool IOPriorityQueue::takeWithoutLock(TaskPtr & task)
+{
+    if (popTask(cancel_task_queue, task))
+        return true;
+
+    bool io_out_first = ratio_of_out_to_in * total_io_in_time_microsecond >= total_io_out_time_microsecond;
+    auto & first_queue = io_out_first ? io_out_task_queue : io_in_task_queue;
+    auto & next_queue = io_out_first ? io_in_task_queue : io_out_task_queue;
+    return popTask(first_queue, task) || popTask(next_queue, task);
+}
+
 void IOPriorityQueue::drainTaskQueueWithoutLock()
 {
     TaskPtr task;
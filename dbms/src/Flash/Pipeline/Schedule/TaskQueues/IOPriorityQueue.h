@@ -41,6 +41,8 @@ public:
 
     bool take(TaskPtr & task) override;
 
+    bool tryTake(TaskPtr & task) override;
+
     void updateStatistics(const TaskPtr &, ExecTaskStatus exec_task_status, UInt64 inc_ns) override;
 
     bool empty() const override;
@@ -54,6 +56,8 @@ public:
 private:
     void submitTaskWithoutLock(TaskPtr && task);
 
+    bool takeWithoutLock(TaskPtr & task);
+
     void drainTaskQueueWithoutLock();
 
 private:
@@ -168,43 +168,55 @@ template <typename TimeGetter>
 bool MultiLevelFeedbackQueue<TimeGetter>::take(TaskPtr & task)
 {
     assert(!task);
+    std::unique_lock lock(mu);
+    while (true)
     {
-        // -1 means no candidates; else has candidate.
-        int queue_idx = -1;
-        double target_accu_time_microsecond = 0;
-        std::unique_lock lock(mu);
-        while (true)
-        {
-            // Remaining tasks will be drained in destructor.
-            if (unlikely(is_finished))
-                return false;
+        // Remaining tasks will be drained in destructor.
+        if (unlikely(is_finished))
+            return false;
 
-            if (popTask(cancel_task_queue, task))
-                return true;
+        if (takeWithoutLock(task))
+            return true;
+        cv.wait(lock);
+    }
+}
 
-            // Find the queue with the smallest execution time.
-            for (size_t i = 0; i < QUEUE_SIZE; ++i)
+template <typename TimeGetter>
+bool MultiLevelFeedbackQueue<TimeGetter>::tryTake(TaskPtr & task)
+{
+    assert(!task);
+    std::lock_guard lock(mu);
+    return !is_finished && takeWithoutLock(task);
+}
+
+template <typename TimeGetter>
+bool MultiLevelFeedbackQueue<TimeGetter>::takeWithoutLock(TaskPtr & task)
+{
+    if (popTask(cancel_task_queue, task))
+        return true;
+
+    // -1 means no candidates; else has candidate.
+    int queue_idx = -1;
+    double target_accu_time_microsecond = 0;
+    // Find the queue with the smallest execution time.
+    for (size_t i = 0; i < QUEUE_SIZE; ++i)
+    {
+        // we just search for queue has element
+        const auto & cur_queue = level_queues[i];
+        if (!cur_queue->empty())
+        {
+            double local_target_time_microsecond = cur_queue->normalizedTimeMicrosecond();
+            if (queue_idx < 0 || local_target_time_microsecond < target_accu_time_microsecond)
             {
-                // we just search for queue has element
-                const auto & cur_queue = level_queues[i];
-                if (!cur_queue->empty())
-                {
-                    double local_target_time_microsecond = cur_queue->normalizedTimeMicrosecond();
-                    if (queue_idx < 0 || local_target_time_microsecond < target_accu_time_microsecond)
-                    {
-                        target_accu_time_microsecond = local_target_time_microsecond;
-                        queue_idx = i;
-                    }
-                }
+                target_accu_time_microsecond = local_target_time_microsecond;
+                queue_idx = i;
             }
-
-            if (queue_idx >= 0)
-                break;
-            cv.wait(lock);
         }
-        level_queues[queue_idx]->take(task);
     }
+    if (queue_idx < 0)
+        return false;
 
+    level_queues[queue_idx]->take(task);
     assert(task);
     return true;
 }
@@ -106,6 +106,8 @@ public:
 
     bool take(TaskPtr & task) override;
 
+    bool tryTake(TaskPtr & task) override;
+
     void updateStatistics(const TaskPtr & task, ExecTaskStatus, UInt64 inc_ns) override;
 
     bool empty() const override;
@@ -129,6 +131,8 @@ public:
 private:
     void computeQueueLevel(const TaskPtr & task);
 
+    bool takeWithoutLock(TaskPtr & task);
+
     void submitTaskWithoutLock(TaskPtr && task);
 
     void drainTaskQueueWithoutLock();
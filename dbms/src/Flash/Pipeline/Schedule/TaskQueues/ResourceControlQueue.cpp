@@ -14,6 +14,7 @@
 
 #include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Executor/toRU.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/FairShareQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/IOPriorityQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/ResourceControlQueue.h>
@@ -261,6 +262,15 @@ void ResourceControlQueue<NestedTaskQueueType>::cancel(const TaskCancelInfo & ca
     cv.notify_all();
 }
 
+template <typename NestedTaskQueueType>
+UInt64 ResourceControlQueue<NestedTaskQueueType>::getYieldTimeNs(const TaskPtr & task) const
+{
+    // Only the fair share queue preempts tasks, whose yield time is decided in `mustTakeTask`.
+    if constexpr (!std::is_same_v<NestedTaskQueueType, FairShareQueue>)
+        return TaskQueue::getYieldTimeNs(task);
+    return task->yield_time_ns;
+}
+
 template <typename NestedTaskQueueType>
 void ResourceControlQueue<NestedTaskQueueType>::mustEraseResourceGroupInfoWithoutLock(
     const KeyspaceID & keyspace_id,
@@ -281,9 +291,14 @@ void ResourceControlQueue<NestedTaskQueueType>::mustTakeTask(const NestedTaskQue
     assert(!task_queue->empty());
     RUNTIME_CHECK(task_queue->take(task));
     assert(task);
+    // Decide the yield time while the nested queue is at hand, so `getYieldTimeNs` does not need to look it up
+    // under the lock.
+    if constexpr (std::is_same_v<NestedTaskQueueType, FairShareQueue>)
+        task->yield_time_ns = task_queue->getYieldTimeNs(task);
 }
 
 template class ResourceControlQueue<CPUMultiLevelFeedbackQueue>;
+template class ResourceControlQueue<FairShareQueue>;
 // For now, io_task_thread_pool is not managed by ResourceControl mechanism.
 template class ResourceControlQueue<IOPriorityQueue>;
 } // namespace DB
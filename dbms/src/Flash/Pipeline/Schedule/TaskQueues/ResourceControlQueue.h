@@ -52,6 +52,8 @@ public:
 
     void cancel(const TaskCancelInfo & cancel_info) override;
 
+    UInt64 getYieldTimeNs(const TaskPtr & task) const override;
+
 #ifndef DBMS_PUBLIC_GTEST
 private:
 #endif
@@ -16,6 +16,7 @@
 
 #include <Common/Logger.h>
 #include <Flash/Pipeline/Schedule/Tasks/Task.h>
+#include <Flash/Pipeline/Schedule/Tasks/TaskTimer.h>
 
 #include <memory>
 #include <vector>
@@ -34,6 +35,11 @@ public:
     // Will return false if finished and all remaining tasks should be drained in destructor.
     virtual bool take(TaskPtr & task) = 0;
 
+    // Take a task without waiting, returns false if the queue is empty or finished.
+    // Used by the idle threads of a NUMA node to steal the tasks of other nodes.
+    // The queues that can not be split by NUMA nodes do not support it.
+    virtual bool tryTake(TaskPtr &) { return false; }
+
     // Update the execution metrics of the task taken from the queue.
     // Used to adjust the priority of tasks within a queue.
     virtual void updateStatistics(const TaskPtr & task, ExecTaskStatus exec_task_status, UInt64 inc_ns) = 0;
@@ -46,6 +52,10 @@ public:
 
     virtual void cancel(const TaskCancelInfo & cancel_info) = 0;
 
+    // The max time that the task taken from the queue can execute before yielding.
+    // The task can only yield at the boundaries of operators.
+    virtual UInt64 getYieldTimeNs(const TaskPtr &) const { return YIELD_MAX_TIME_SPENT_NS; }
+
 protected:
     LoggerPtr logger = Logger::get();
 };
@@ -22,5 +22,7 @@ enum class TaskQueueType
     MLFQ, // multi-level feedback queue
     IO_PRIORITY, // io priority queue
     RCQ_MLFQ, // resource control queue nesting MLFQ.
+    FAIR, // fair share queue
+    RCQ_FAIR, // resource control queue nesting fair share queue.
 };
 } // namespace DB
@@ -0,0 +1,211 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/FairShareQueue.h>
+#include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+namespace DB::tests
+{
+namespace
+{
+class PlainTask : public Task
+{
+public:
+    explicit PlainTask(PipelineExecutorContext & exec_context_)
+        : Task(exec_context_)
+    {}
+
+    ExecTaskStatus executeImpl() noexcept override { return ExecTaskStatus::FINISHED; }
+};
+
+class TestQueryContext
+{
+public:
+    TestQueryContext(const String & query_id, UInt64 weight)
+        : context(query_id, "", nullptr, nullptr, nullptr, nullptr, NullspaceID, "", weight)
+    {
+        // To avoid the active ref count being returned to 0 in advance.
+        context.incActiveRefCount();
+    }
+
+    ~TestQueryContext() { context.decActiveRefCount(); }
+
+    PipelineExecutorContext context;
+};
+} // namespace
+
+class TestFairShareQueue : public ::testing::Test
+{
+};
+
+TEST_F(TestFairShareQueue, weightedShare)
+try
+{
+    TestQueryContext low("low", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+    TestQueryContext high("high", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT * 3);
+
+    FairShareQueue queue;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        queue.submit(std::make_unique<PlainTask>(low.context));
+        queue.submit(std::make_unique<PlainTask>(high.context));
+    }
+
+    // Each task runs 10ms and is submitted again, the query with 3x weight gets 3x cpu time.
+    std::unordered_map<String, size_t> taken;
+    for (size_t i = 0; i < 400; ++i)
+    {
+        TaskPtr task;
+        ASSERT_TRUE(queue.take(task));
+        ++taken[task->getQueryId()];
+        queue.updateStatistics(task, ExecTaskStatus::RUNNING, 10'000'000);
+        queue.submit(std::move(task));
+    }
+    ASSERT_NEAR(taken["high"], 300, 5);
+    ASSERT_NEAR(taken["low"], 100, 5);
+
+    queue.finish();
+}
+CATCH
+
+TEST_F(TestFairShareQueue, newQueryStartsFromMinVruntime)
+try
+{
+    TestQueryContext old_query("old", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+    TestQueryContext new_query("new", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+
+    FairShareQueue queue;
+    queue.submit(std::make_unique<PlainTask>(old_query.context));
+    for (size_t i = 0; i < 100; ++i)
+    {
+        TaskPtr task;
+        ASSERT_TRUE(queue.take(task));
+        queue.updateStatistics(task, ExecTaskStatus::RUNNING, 10'000'000);
+        queue.submit(std::move(task));
+    }
+
+    // The new query does not monopolise the queue because of the long history of the old query.
+    queue.submit(std::make_unique<PlainTask>(new_query.context));
+    std::unordered_map<String, size_t> taken;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        TaskPtr task;
+        ASSERT_TRUE(queue.take(task));
+        ++taken[task->getQueryId()];
+        queue.updateStatistics(task, ExecTaskStatus::RUNNING, 10'000'000);
+        queue.submit(std::move(task));
+    }
+    ASSERT_NEAR(taken["old"], 5, 1);
+    ASSERT_NEAR(taken["new"], 5, 1);
+
+    queue.finish();
+}
+CATCH
+
+TEST_F(TestFairShareQueue, yieldTime)
+try
+{
+    FairShareQueue queue;
+    TaskPtr task;
+    ASSERT_EQ(queue.getYieldTimeNs(task), YIELD_MAX_TIME_SPENT_NS);
+
+    std::vector<std::unique_ptr<TestQueryContext>> queries;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        queries.push_back(std::make_unique<TestQueryContext>(fmt::format("q{}", i), 1024));
+        queue.submit(std::make_unique<PlainTask>(queries.back()->context));
+    }
+    ASSERT_EQ(queue.getYieldTimeNs(task), FairShareQueue::TARGET_LATENCY_NS / 4);
+
+    for (size_t i = 4; i < 100; ++i)
+    {
+        queries.push_back(std::make_unique<TestQueryContext>(fmt::format("q{}", i), 1024));
+        queue.submit(std::make_unique<PlainTask>(queries.back()->context));
+    }
+    ASSERT_EQ(queue.getYieldTimeNs(task), FairShareQueue::MIN_GRANULARITY_NS);
+
+    queue.finish();
+}
+CATCH
+
+TEST_F(TestFairShareQueue, keepRunningQueries)
+try
+{
+    TestQueryContext q1("q1", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+    TestQueryContext q2("q2", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+
+    FairShareQueue queue;
+    queue.submit(std::make_unique<PlainTask>(q1.context));
+    TaskPtr task1;
+    ASSERT_TRUE(queue.take(task1));
+
+    // q1 has no pending tasks, but it is not idle because its task is running.
+    queue.removeIdleQueriesWithoutLock();
+    ASSERT_TRUE(queue.queries.contains("q1"));
+    queue.updateStatistics(task1, ExecTaskStatus::RUNNING, 10'000'000);
+    ASSERT_EQ(queue.queries.at("q1").vruntime, 10'000'000);
+    FINALIZE_TASK(task1);
+
+    // q1 is removed once the min vruntime catches up with it.
+    queue.submit(std::make_unique<PlainTask>(q2.context));
+    TaskPtr task2;
+    ASSERT_TRUE(queue.take(task2));
+    queue.updateStatistics(task2, ExecTaskStatus::RUNNING, 20'000'000);
+    queue.submit(std::move(task2));
+    queue.removeIdleQueriesWithoutLock();
+    ASSERT_FALSE(queue.queries.contains("q1"));
+    ASSERT_TRUE(queue.queries.contains("q2"));
+
+    queue.finish();
+}
+CATCH
+
+TEST_F(TestFairShareQueue, cancel)
+try
+{
+    TestQueryContext q1("q1", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+    TestQueryContext q2("q2", PipelineExecutorContext::DEFAULT_QUERY_WEIGHT);
+
+    FairShareQueue queue;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        queue.submit(std::make_unique<PlainTask>(q1.context));
+        queue.submit(std::make_unique<PlainTask>(q2.context));
+    }
+    queue.cancel(TaskCancelInfo{.query_id = "q1"});
+
+    // The cancelled tasks are taken first.
+    for (size_t i = 0; i < 10; ++i)
+    {
+        TaskPtr task;
+        ASSERT_TRUE(queue.take(task));
+        ASSERT_EQ(task->getQueryId(), "q1");
+        FINALIZE_TASK(task);
+    }
+    for (size_t i = 0; i < 10; ++i)
+    {
+        TaskPtr task;
+        ASSERT_TRUE(queue.take(task));
+        ASSERT_EQ(task->getQueryId(), "q2");
+        FINALIZE_TASK(task);
+    }
+    ASSERT_TRUE(queue.empty());
+    queue.finish();
+}
+CATCH
+
+} // namespace DB::tests
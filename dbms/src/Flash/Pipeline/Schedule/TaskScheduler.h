@@ -77,6 +77,9 @@ public:
 
     void cancel(const TaskCancelInfo & cancel_info);
 
+    /// for test
+    const TaskThreadPool<CPUImpl> & getCPUTaskThreadPool() const { return cpu_task_thread_pool; }
+
     static std::unique_ptr<TaskScheduler> instance;
 
 private:
@@ -14,9 +14,11 @@
 
 #pragma once
 
+#include <Flash/Pipeline/Exec/AdaptiveConcurrencyController.h>
 #include <Flash/Pipeline/Exec/PipelineExec.h>
 #include <Flash/Pipeline/Schedule/Tasks/Impls/EventTask.h>
 #include <Flash/Pipeline/Schedule/Tasks/Impls/PipelineTaskBase.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
 
 namespace DB
 {
@@ -29,13 +31,21 @@ public:
         PipelineExecutorContext & exec_context_,
         const String & req_id,
         const EventPtr & event_,
-        PipelineExecPtr && pipeline_exec_)
+        PipelineExecPtr && pipeline_exec_,
+        AdaptiveConcurrencyController * concurrency_controller_ = nullptr)
         : EventTask(exec_context_, req_id, event_, ExecTaskStatus::RUNNING)
         , PipelineTaskBase(std::move(pipeline_exec_))
+        , concurrency_controller(concurrency_controller_)
     {}
 
 protected:
-    ExecTaskStatus executeImpl() override { return runExecute(); }
+    ExecTaskStatus executeImpl() override
+    {
+        auto status = runExecute();
+        if (concurrency_controller)
+            status = adaptConcurrency(status);
+        return status;
+    }
 
     ExecTaskStatus executeIOImpl() override { return runExecuteIO(); }
 
@@ -47,5 +57,39 @@ protected:
     {
         runFinalize(profile_info.getCPUPendingTimeNs() + profile_info.getIOPendingTimeNs(), getScheduleDuration());
     }
+
+private:
+    ExecTaskStatus adaptConcurrency(ExecTaskStatus status)
+    {
+        switch (status)
+        {
+        case ExecTaskStatus::RUNNING:
+            idle_rounds = 0;
+            if (++running_rounds % AdaptiveConcurrencyController::CHECK_INTERVAL == 0)
+                concurrency_controller->onProgress(getPipelineExec().getSourceBacklog());
+            return status;
+        case ExecTaskStatus::WAIT_FOR_NOTIFY:
+            if (!getPipelineExec().isWaitingForSource() || !concurrency_controller->tryRetire(++idle_rounds))
+                return status;
+            // The source is not read after retiring, so the next `execute` finishes this instance.
+            clearNotifyFuture();
+            getPipelineExec().retire();
+            is_retired = true;
+            return ExecTaskStatus::RUNNING;
+        case ExecTaskStatus::FINISHED:
+            if (!is_retired)
+                concurrency_controller->onInputFinish();
+            return status;
+        default:
+            return status;
+        }
+    }
+
+private:
+    // Owned by the event, which outlives the tasks.
+    AdaptiveConcurrencyController * concurrency_controller;
+    size_t running_rounds = 0;
+    size_t idle_rounds = 0;
+    bool is_retired = false;
 };
 } // namespace DB
@@ -140,6 +140,12 @@ protected:
         return ExecTaskStatus::RUNNING;
     }
 
+    PipelineExec & getPipelineExec()
+    {
+        assert(pipeline_exec);
+        return *pipeline_exec;
+    }
+
 private:
     PipelineExecPtr pipeline_exec_holder;
     // To reduce the overheads of `pipeline_exec_holder.get()`
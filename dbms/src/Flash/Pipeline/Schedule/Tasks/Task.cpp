@@ -216,4 +216,19 @@ const KeyspaceID & Task::getKeyspaceID() const
 {
     return exec_context.getKeyspaceID();
 }
+
+UInt64 Task::getQueryWeight() const
+{
+    return exec_context.getQueryWeight();
+}
+
+Int32 Task::getNUMANode() const
+{
+    return exec_context.getNUMANode();
+}
+
+Int32 Task::assignNUMANode(Int32 node)
+{
+    return exec_context.assignNUMANode(node);
+}
 } // namespace DB
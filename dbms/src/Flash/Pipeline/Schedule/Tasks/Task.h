@@ -120,6 +120,12 @@ public:
 
     const KeyspaceID & getKeyspaceID() const;
 
+    UInt64 getQueryWeight() const;
+
+    Int32 getNUMANode() const;
+
+    Int32 assignNUMANode(Int32 node);
+
     const PipelineExecutorContext & getQueryExecContext() { return exec_context; }
 
     void onErrorOccurred(const String & err_msg);
@@ -150,6 +156,9 @@ public:
     // level of multi-level feedback queue.
     size_t mlfq_level{0};
 
+    // yield time decided by the nested queue of resource control queue when the task is taken.
+    UInt64 yield_time_ns{YIELD_MAX_TIME_SPENT_NS};
+
 private:
     PipelineExecutorContext & exec_context;
 
@@ -66,7 +66,12 @@ public:
             cpu_execute_max_time_ns_per_round = value;
     }
 
-    ALWAYS_INLINE void elapsedCPUPendingTime() { cpu_pending_time_ns += elapsedFromPrev(); }
+    ALWAYS_INLINE UInt64 elapsedCPUPendingTime()
+    {
+        auto elapsed = elapsedFromPrev();
+        cpu_pending_time_ns += elapsed;
+        return elapsed;
+    }
 
     ALWAYS_INLINE void addIOExecuteTime(UInt64 value)
     {
@@ -75,7 +80,12 @@ public:
             io_execute_max_time_ns_per_round = value;
     }
 
-    ALWAYS_INLINE void elapsedIOPendingTime() { io_pending_time_ns += elapsedFromPrev(); }
+    ALWAYS_INLINE UInt64 elapsedIOPendingTime()
+    {
+        auto elapsed = elapsedFromPrev();
+        io_pending_time_ns += elapsed;
+        return elapsed;
+    }
 
     ALWAYS_INLINE void elapsedAwaitTime() { await_time_ns += elapsedFromPrev(); }
 
@@ -15,6 +15,7 @@
 #include <Common/CPUAffinityManager.h>
 #include <Common/Exception.h>
 #include <Common/Stopwatch.h>
+#include <Common/TiFlashMetrics.h>
 #include <Common/setThreadName.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
@@ -29,21 +30,79 @@
 
 namespace DB
 {
+namespace ErrorCodes
+{
+extern const int INVALID_CONFIG_PARAMETER;
+} // namespace ErrorCodes
+
+namespace
+{
+template <typename Impl>
+size_t getNodeGroupCount(const ThreadPoolConfig & config)
+{
+    // Only the cpu intensive tasks benefit from NUMA locality.
+    if constexpr (!Impl::is_cpu)
+        return 1;
+
+    size_t node_count
+        = config.numa_node_count > 0 ? config.numa_node_count : CPUAffinityManager::getInstance().getNUMANodeCount();
+    node_count = std::min(node_count, config.pool_size);
+    if (node_count <= 1)
+        return 1;
+    switch (config.queue_type)
+    {
+    case TaskQueueType::DEFAULT:
+    case TaskQueueType::RCQ_MLFQ:
+    case TaskQueueType::RCQ_FAIR:
+        // The token refill callback of LocalAdmissionController can only be registered by one queue,
+        // so the resource control queues can not be split by NUMA nodes.
+        throw Exception(
+            ErrorCodes::INVALID_CONFIG_PARAMETER,
+            "NUMA aware scheduling requires pipeline_cpu_task_thread_pool_queue_type to be MLFQ or FAIR, got {}",
+            magic_enum::enum_name(config.queue_type));
+    default:
+        return node_count;
+    }
+}
+} // namespace
+
 template <typename Impl>
 TaskThreadPool<Impl>::TaskThreadPool(TaskScheduler & scheduler_, const ThreadPoolConfig & config)
-    : task_queue(Impl::newTaskQueue(config.queue_type))
-    , scheduler(scheduler_)
+    : scheduler(scheduler_)
 {
     RUNTIME_CHECK(config.pool_size > 0);
+    const size_t node_count = getNodeGroupCount<Impl>(config);
+    for (size_t node = 0; node < node_count; ++node)
+    {
+        auto group = std::make_unique<NodeGroup>();
+        group->task_queue = Impl::newTaskQueue(config.queue_type);
+        // Spread the threads evenly to the nodes.
+        group->thread_count = config.pool_size / node_count + (node < config.pool_size % node_count ? 1 : 0);
+        if (node_count > 1)
+        {
+            auto & metrics = TiFlashMetrics::instance();
+            metrics.getPipelineNUMANodeGauge(node, "thread_count").Set(group->thread_count);
+            group->pending_gauge = &metrics.getPipelineNUMANodeGauge(node, "pending_tasks");
+            group->executing_gauge = &metrics.getPipelineNUMANodeGauge(node, "executing_tasks");
+            group->utilization_gauge = &metrics.getPipelineNUMANodeGauge(node, "utilization");
+            group->stolen_counter = &metrics.getPipelineNUMANodeCounter(node, "stolen");
+            group->redirected_counter = &metrics.getPipelineNUMANodeCounter(node, "redirected");
+        }
+        node_groups.push_back(std::move(group));
+    }
+    if (node_count > 1)
+        LOG_INFO(logger, "NUMA aware scheduling is enabled with {} nodes", node_count);
+
     threads.reserve(config.pool_size);
     for (size_t i = 0; i < config.pool_size; ++i)
-        threads.emplace_back(&TaskThreadPool::loop, this, i);
+        threads.emplace_back(&TaskThreadPool::loop, this, i, i % node_count);
 }
 
 template <typename Impl>
 void TaskThreadPool<Impl>::finish()
 {
-    task_queue->finish();
+    for (auto & group : node_groups)
+        group->task_queue->finish();
 }
 
 template <typename Impl>
@@ -55,33 +114,40 @@ void TaskThreadPool<Impl>::waitForStop()
 }
 
 template <typename Impl>
-void TaskThreadPool<Impl>::loop(size_t thread_no)
+void TaskThreadPool<Impl>::loop(size_t thread_no, size_t node)
 {
     try
     {
-        CPUAffinityManager::getInstance().bindSelfQueryThread();
-        doLoop(thread_no);
+        // Bind the threads to the NUMA node, so that the memory allocated by the tasks is local to the node
+        // by the default first touch policy of Linux.
+        if (node_groups.size() > 1)
+            CPUAffinityManager::getInstance().bindSelfQueryThreadToNUMANode(node);
+        else
+            CPUAffinityManager::getInstance().bindSelfQueryThread();
+        doLoop(thread_no, node);
     }
     CATCH_AND_TERMINATE(logger)
 }
 
 template <typename Impl>
-void TaskThreadPool<Impl>::doLoop(size_t thread_no)
+void TaskThreadPool<Impl>::doLoop(size_t thread_no, size_t node)
 {
     setThreadName(Impl::NAME);
 
     metrics.incThreadCnt();
     SCOPE_EXIT({ metrics.decThreadCnt(); });
 
-    auto thread_no_str = fmt::format("thread_no={}", thread_no);
+    auto thread_no_str = node_groups.size() > 1 ? fmt::format("thread_no={} numa_node={}", thread_no, node)
+                                                : fmt::format("thread_no={}", thread_no);
     auto thread_logger = logger->getChild(thread_no_str);
     LOG_INFO(thread_logger, "start loop");
 
+    auto & group = *node_groups[node];
     TaskPtr task;
-    while (likely(task_queue->take(task)))
+    while (auto * task_queue = takeTask(node, task))
     {
         metrics.decPendingTask();
-        handleTask(task);
+        handleTask(task, group, *task_queue);
         assert(!task);
     }
 
@@ -89,7 +155,44 @@ void TaskThreadPool<Impl>::doLoop(size_t thread_no)
 }
 
 template <typename Impl>
-void TaskThreadPool<Impl>::handleTask(TaskPtr & task)
+TaskQueue * TaskThreadPool<Impl>::takeTask(size_t node, TaskPtr & task)
+{
+    auto & task_queue = *node_groups[node]->task_queue;
+    if (node_groups.size() > 1)
+    {
+        // The local tasks go first, and the idle thread only steals the tasks of other nodes before waiting.
+        // The threads already waiting do not miss the new tasks of other nodes, because the tasks submitted
+        // to a saturated node are redirected to the node with idle threads.
+        if (task_queue.tryTake(task))
+            return &task_queue;
+        if (auto * victim_queue = stealTask(node, task); victim_queue)
+            return victim_queue;
+    }
+    return task_queue.take(task) ? &task_queue : nullptr;
+}
+
+template <typename Impl>
+TaskQueue * TaskThreadPool<Impl>::stealTask(size_t node, TaskPtr & task)
+{
+    auto & group = *node_groups[node];
+    for (size_t i = 1; i < node_groups.size(); ++i)
+    {
+        auto & victim = *node_groups[(node + i) % node_groups.size()];
+        // Only the nodes with pending tasks are worth locking the queue for.
+        if (victim.load <= victim.executing || !victim.task_queue->tryTake(task))
+            continue;
+        // The stolen task is counted by the node executing it from now on.
+        ++group.load;
+        --victim.load;
+        updateNodeGroupMetrics(victim);
+        group.stolen_counter->Increment();
+        return victim.task_queue.get();
+    }
+    return nullptr;
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::handleTask(TaskPtr & task, NodeGroup & group, TaskQueue & task_queue)
 {
     assert(task);
     TaskTimer timer{task->profile_info};
@@ -97,20 +200,29 @@ void TaskThreadPool<Impl>::handleTask(TaskPtr & task)
 
     metrics.incExecutingTask();
     metrics.elapsedPendingTime(task);
+    ++group.executing;
+    updateNodeGroupMetrics(group);
 
     auto status_before_exec = task->getStatus();
     auto status_after_exec = status_before_exec;
+    const auto yield_time_ns = task_queue.getYieldTimeNs(task);
     while (true)
     {
         status_after_exec = Impl::exec(task);
         auto total_time_spent = timer.updateExecutingTime();
-        // The executing task should yield if it takes more than `YIELD_MAX_TIME_SPENT_NS`.
-        if (!Impl::isTargetStatus(status_after_exec) || total_time_spent >= YIELD_MAX_TIME_SPENT_NS)
+        // The executing task should yield if it takes more than `yield_time_ns`, which is `YIELD_MAX_TIME_SPENT_NS`
+        // unless the task queue wants to preempt the task earlier.
+        if (!Impl::isTargetStatus(status_after_exec) || total_time_spent >= yield_time_ns)
             break;
     }
-    task_queue->updateStatistics(task, status_before_exec, timer.executing_time);
+    // The statistics go to the queue the task was taken from, which is another node's queue if the task is stolen.
+    task_queue.updateStatistics(task, status_before_exec, timer.executing_time);
     metrics.addExecuteTime(task, timer.executing_time);
     metrics.decExecutingTask();
+    --group.executing;
+    // Decrease the load before the task is resubmitted, so that the task can stay on the node if it is not saturated.
+    --group.load;
+    updateNodeGroupMetrics(group);
     switch (status_after_exec)
     {
     case ExecTaskStatus::RUNNING:
@@ -144,20 +256,96 @@ template <typename Impl>
 void TaskThreadPool<Impl>::submit(TaskPtr && task)
 {
     metrics.incPendingTask(1);
-    task_queue->submit(std::move(task));
+    auto & group = *node_groups[selectNodeGroup(task)];
+    ++group.load;
+    updateNodeGroupMetrics(group);
+    group.task_queue->submit(std::move(task));
 }
 
 template <typename Impl>
 void TaskThreadPool<Impl>::submit(std::vector<TaskPtr> & tasks)
 {
     metrics.incPendingTask(tasks.size());
-    task_queue->submit(tasks);
+    if (node_groups.size() == 1)
+    {
+        node_groups[0]->load += tasks.size();
+        node_groups[0]->task_queue->submit(tasks);
+        return;
+    }
+
+    std::vector<std::vector<TaskPtr>> tasks_per_group(node_groups.size());
+    for (auto & task : tasks)
+    {
+        auto node = selectNodeGroup(task);
+        // Count the load here, so that the following tasks see the tasks selected before.
+        ++node_groups[node]->load;
+        tasks_per_group[node].push_back(std::move(task));
+    }
+    tasks.clear();
+    for (size_t node = 0; node < node_groups.size(); ++node)
+    {
+        if (tasks_per_group[node].empty())
+            continue;
+        updateNodeGroupMetrics(*node_groups[node]);
+        node_groups[node]->task_queue->submit(tasks_per_group[node]);
+    }
+}
+
+template <typename Impl>
+size_t TaskThreadPool<Impl>::selectNodeGroup(TaskPtr & task)
+{
+    if (node_groups.size() == 1)
+        return 0;
+
+    auto node = task->getNUMANode();
+    if (node < 0 || static_cast<size_t>(node) >= node_groups.size())
+        node = task->assignNUMANode(static_cast<Int32>(leastLoadedNodeGroup()));
+
+    // Cross node scheduling loses the locality of the memory allocated by the query, so only do it
+    // when the preferred node is saturated and another node has idle threads.
+    const auto & preferred = *node_groups[node];
+    if (preferred.load < preferred.thread_count)
+        return node;
+    auto target = leastLoadedNodeGroup();
+    auto & target_group = *node_groups[target];
+    if (target_group.load >= target_group.thread_count)
+        return node;
+    target_group.redirected_counter->Increment();
+    return target;
+}
+
+template <typename Impl>
+size_t TaskThreadPool<Impl>::leastLoadedNodeGroup() const
+{
+    size_t target = 0;
+    for (size_t node = 1; node < node_groups.size(); ++node)
+    {
+        // Compare load / thread_count without division.
+        const auto & group = *node_groups[node];
+        const auto & target_group = *node_groups[target];
+        if (group.load * target_group.thread_count < target_group.load * group.thread_count)
+            target = node;
+    }
+    return target;
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::updateNodeGroupMetrics(NodeGroup & group) const
+{
+    if (node_groups.size() == 1)
+        return;
+    size_t executing = group.executing;
+    size_t load = group.load;
+    group.pending_gauge->Set(load > executing ? load - executing : 0);
+    group.executing_gauge->Set(executing);
+    group.utilization_gauge->Set(static_cast<double>(executing) / group.thread_count);
 }
 
 template <typename Impl>
 void TaskThreadPool<Impl>::cancel(const TaskCancelInfo & cancel_info)
 {
-    task_queue->cancel(cancel_info);
+    for (auto & group : node_groups)
+        group->task_queue->cancel(cancel_info);
 }
 
 template class TaskThreadPool<CPUImpl>;
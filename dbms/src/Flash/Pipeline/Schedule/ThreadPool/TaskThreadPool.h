@@ -20,10 +20,17 @@
 #include <Flash/Pipeline/Schedule/Tasks/Task.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolMetrics.h>
 
+#include <atomic>
 #include <magic_enum.hpp>
 #include <thread>
 #include <vector>
 
+namespace prometheus
+{
+class Counter;
+class Gauge;
+} // namespace prometheus
+
 namespace DB
 {
 class TaskScheduler;
@@ -42,6 +49,9 @@ struct ThreadPoolConfig
 
     size_t pool_size;
     TaskQueueType queue_type = TaskQueueType::DEFAULT;
+    // The number of NUMA nodes to split the threads into, 0 means using the topology detected by
+    // CPUAffinityManager. Only the cpu task thread pool with MLFQ or FAIR queue can be split.
+    size_t numa_node_count = 0;
 
     String toString() const
     {
@@ -67,14 +77,51 @@ public:
 
     void cancel(const TaskCancelInfo & cancel_info);
 
-private:
-    void loop(size_t thread_no);
-    void doLoop(size_t thread_no);
+    /// for test
+    size_t getNodeGroupCount() const { return node_groups.size(); }
+    size_t getNodeLoad(size_t node) const { return node_groups[node]->load; }
+    size_t getNodeExecuting(size_t node) const { return node_groups[node]->executing; }
 
-    void handleTask(TaskPtr & task);
+private:
+    // The threads and the task queue of one NUMA node. If NUMA awareness is disabled, there is only one group
+    // containing all the threads.
+    struct NodeGroup
+    {
+        TaskQueuePtr task_queue;
+        size_t thread_count = 0;
+        // The number of the pending and executing tasks of this group.
+        std::atomic<size_t> load{0};
+        std::atomic<size_t> executing{0};
+
+        prometheus::Gauge * pending_gauge = nullptr;
+        prometheus::Gauge * executing_gauge = nullptr;
+        prometheus::Gauge * utilization_gauge = nullptr;
+        // The tasks taken from the queues of other nodes by the idle threads of this node.
+        prometheus::Counter * stolen_counter = nullptr;
+        // The tasks submitted to this node because their preferred node is saturated.
+        prometheus::Counter * redirected_counter = nullptr;
+    };
+
+    void loop(size_t thread_no, size_t node);
+    void doLoop(size_t thread_no, size_t node);
+
+    // Returns the queue that the task is taken from, or nullptr if the pool is finished.
+    TaskQueue * takeTask(size_t node, TaskPtr & task);
+    // Take a pending task from the queues of other nodes without waiting.
+    TaskQueue * stealTask(size_t node, TaskPtr & task);
+
+    void handleTask(TaskPtr & task, NodeGroup & group, TaskQueue & task_queue);
+
+    // All the tasks of a query prefer the NUMA node assigned when its first task is submitted. The tasks only
+    // run on other nodes when the preferred node is saturated and another node has idle threads, or when
+    // they are stolen by the idle threads of other nodes.
+    size_t selectNodeGroup(TaskPtr & task);
+    size_t leastLoadedNodeGroup() const;
+
+    void updateNodeGroupMetrics(NodeGroup & group) const;
 
 private:
-    TaskQueuePtr task_queue;
+    std::vector<std::unique_ptr<NodeGroup>> node_groups;
 
     LoggerPtr logger = Logger::get(Impl::NAME);
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/FairShareQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/IOPriorityQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/ResourceControlQueue.h>
@@ -32,6 +33,10 @@ TaskQueuePtr CPUImpl::newTaskQueue(TaskQueueType type)
         return std::make_unique<ResourceControlQueue<CPUMultiLevelFeedbackQueue>>();
     case TaskQueueType::MLFQ:
         return std::make_unique<CPUMultiLevelFeedbackQueue>();
+    case TaskQueueType::RCQ_FAIR:
+        return std::make_unique<ResourceControlQueue<FairShareQueue>>();
+    case TaskQueueType::FAIR:
+        return std::make_unique<FairShareQueue>();
     default:
         throw Exception(fmt::format("Unsupported queue type: {}", magic_enum::enum_name(type)));
     }
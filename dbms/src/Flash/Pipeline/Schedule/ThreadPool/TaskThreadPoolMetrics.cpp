@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/TiFlashMetrics.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolMetrics.h>
 
 #include <atomic>
@@ -64,6 +65,23 @@ namespace DB
         }                                                                                                 \
     } while (0)
 
+#define OBSERVE_METRIC(metric_name, value)                                                                         \
+    do                                                                                                             \
+    {                                                                                                              \
+        if constexpr (is_cpu)                                                                                      \
+        {                                                                                                          \
+            thread_local auto & metrics                                                                            \
+                = GET_METRIC(tiflash_pipeline_task_schedule_latency_seconds, type_cpu_##metric_name);              \
+            metrics.Observe(value);                                                                                \
+        }                                                                                                          \
+        else                                                                                                       \
+        {                                                                                                          \
+            thread_local auto & metrics                                                                            \
+                = GET_METRIC(tiflash_pipeline_task_schedule_latency_seconds, type_io_##metric_name);               \
+            metrics.Observe(value);                                                                                \
+        }                                                                                                          \
+    } while (0)
+
 template <bool is_cpu>
 TaskThreadPoolMetrics<is_cpu>::TaskThreadPoolMetrics()
 {
@@ -87,10 +105,21 @@ void TaskThreadPoolMetrics<is_cpu>::decPendingTask()
 template <bool is_cpu>
 void TaskThreadPoolMetrics<is_cpu>::elapsedPendingTime(TaskPtr & task)
 {
+    UInt64 pending_time_ns;
     if constexpr (is_cpu)
-        task->profile_info.elapsedCPUPendingTime();
+        pending_time_ns = task->profile_info.elapsedCPUPendingTime();
+    else
+        pending_time_ns = task->profile_info.elapsedIOPendingTime();
+
+    // The priority class is decided by the weight of the query.
+    const auto pending_time_seconds = pending_time_ns / 1'000'000'000.0;
+    const auto query_weight = task->getQueryWeight();
+    if (query_weight > PipelineExecutorContext::DEFAULT_QUERY_WEIGHT)
+        OBSERVE_METRIC(high, pending_time_seconds);
+    else if (query_weight < PipelineExecutorContext::DEFAULT_QUERY_WEIGHT)
+        OBSERVE_METRIC(low, pending_time_seconds);
     else
-        task->profile_info.elapsedIOPendingTime();
+        OBSERVE_METRIC(normal, pending_time_seconds);
 }
 
 template <bool is_cpu>
@@ -132,5 +161,6 @@ template class TaskThreadPoolMetrics<false>;
 #undef INC_METRIC
 #undef DEC_METRIC
 #undef SET_METRIC
+#undef OBSERVE_METRIC
 
 } // namespace DB
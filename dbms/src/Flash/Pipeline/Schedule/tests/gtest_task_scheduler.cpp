@@ -14,12 +14,23 @@
 
 #include <Common/Exception.h>
 #include <Common/MemoryTrackerSetter.h>
+#include <Common/TiFlashMetrics.h>
 #include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/ResourceControl/LocalAdmissionController.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <gtest/gtest.h>
 
+#include <ext/scope_guard.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int INVALID_CONFIG_PARAMETER;
+} // namespace ErrorCodes
+} // namespace DB
+
 namespace DB::tests
 {
 namespace
@@ -173,6 +184,46 @@ protected:
 
     ExecTaskStatus executeIOImpl() override { return ExecTaskStatus::RUNNING; }
 };
+
+class BlockedCPUTask : public Task
+{
+public:
+    BlockedCPUTask(PipelineExecutorContext & exec_context_, const std::atomic_bool & released_)
+        : Task(exec_context_)
+        , released(released_)
+    {}
+
+protected:
+    // Occupy the thread until released, so that the test controls how many threads of each node are busy.
+    ExecTaskStatus executeImpl() override
+    {
+        while (!released)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return ExecTaskStatus::FINISHED;
+    }
+
+private:
+    const std::atomic_bool & released;
+};
+
+class CountedTask : public Task
+{
+public:
+    CountedTask(PipelineExecutorContext & exec_context_, std::atomic_size_t & finished_count_)
+        : Task(exec_context_)
+        , finished_count(finished_count_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        ++finished_count;
+        return ExecTaskStatus::FINISHED;
+    }
+
+private:
+    std::atomic_size_t & finished_count;
+};
 } // namespace
 
 class TaskSchedulerTestRunner : public ::testing::Test
@@ -189,6 +240,33 @@ public:
         std::chrono::seconds timeout(15);
         exec_context.waitFor(timeout);
     }
+
+    // Two fake NUMA nodes with two threads each.
+    static TaskSchedulerConfig getNUMAConfig(TaskQueueType queue_type)
+    {
+        DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
+        ThreadPoolConfig cpu_config{4, queue_type};
+        cpu_config.numa_node_count = 2;
+        return TaskSchedulerConfig{cpu_config, thread_num};
+    }
+
+    static double getNUMANodeTasks(size_t node, const String & type)
+    {
+        return TiFlashMetrics::instance().getPipelineNUMANodeCounter(node, type).Value();
+    }
+
+    template <typename Pred>
+    static bool waitUntil(Pred && pred)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(15);
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
 };
 
 TEST_F(TaskSchedulerTestRunner, simpleTask)
@@ -261,4 +339,136 @@ try
 }
 CATCH
 
+TEST_F(TaskSchedulerTestRunner, numaNodeAssignment)
+try
+{
+    std::atomic_bool released = false;
+    PipelineExecutorContext query_1;
+    PipelineExecutorContext query_2;
+    {
+        TaskScheduler task_scheduler{getNUMAConfig(TaskQueueType::MLFQ)};
+        SCOPE_EXIT({ released = true; });
+        const auto & pool = task_scheduler.getCPUTaskThreadPool();
+        ASSERT_EQ(pool.getNodeGroupCount(), 2);
+        auto is_executing = [&](size_t node_0, size_t node_1) {
+            return pool.getNodeExecuting(0) == node_0 && pool.getNodeExecuting(1) == node_1;
+        };
+
+        // The first query prefers the least loaded node.
+        task_scheduler.submit(std::make_unique<BlockedCPUTask>(query_1, released));
+        ASSERT_EQ(query_1.getNUMANode(), 0);
+        ASSERT_TRUE(waitUntil([&] { return is_executing(1, 0); }));
+
+        // The second query prefers the other node, which is less loaded now.
+        task_scheduler.submit(std::make_unique<BlockedCPUTask>(query_2, released));
+        ASSERT_EQ(query_2.getNUMANode(), 1);
+
+        // The tasks of a query stay on its node while the node is not saturated.
+        task_scheduler.submit(std::make_unique<BlockedCPUTask>(query_1, released));
+        ASSERT_TRUE(waitUntil([&] { return is_executing(2, 1); }));
+        ASSERT_EQ(pool.getNodeLoad(0), 2);
+        ASSERT_EQ(pool.getNodeLoad(1), 1);
+
+        // Node 0 is saturated, so the task runs on node 1 which has an idle thread.
+        auto stolen_tasks = getNUMANodeTasks(1, "stolen");
+        auto redirected_tasks = getNUMANodeTasks(1, "redirected");
+        task_scheduler.submit(std::make_unique<BlockedCPUTask>(query_1, released));
+        ASSERT_TRUE(waitUntil([&] { return is_executing(2, 2); }));
+        ASSERT_EQ(pool.getNodeLoad(0), 2);
+        ASSERT_EQ(pool.getNodeLoad(1), 2);
+        ASSERT_EQ(getNUMANodeTasks(1, "redirected"), redirected_tasks + 1);
+        ASSERT_EQ(getNUMANodeTasks(1, "stolen"), stolen_tasks);
+        ASSERT_EQ(query_1.getNUMANode(), 0);
+
+        // Both nodes are saturated, so the task waits on its preferred node.
+        task_scheduler.submit(std::make_unique<BlockedCPUTask>(query_2, released));
+        ASSERT_EQ(pool.getNodeLoad(1), 3);
+        ASSERT_EQ(pool.getNodeExecuting(1), 2);
+
+        released = true;
+        ASSERT_TRUE(waitUntil([&] { return pool.getNodeLoad(0) == 0 && pool.getNodeLoad(1) == 0; }));
+        ASSERT_TRUE(is_executing(0, 0));
+    }
+    std::chrono::seconds timeout(15);
+    query_1.waitFor(timeout);
+    query_2.waitFor(timeout);
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, numaIdleThreadSteal)
+try
+{
+    for (auto queue_type : {TaskQueueType::MLFQ, TaskQueueType::FAIR})
+    {
+        std::atomic_bool query_1_released = false;
+        std::atomic_bool query_2_released = false;
+        std::atomic_size_t finished_count = 0;
+        PipelineExecutorContext query_1;
+        PipelineExecutorContext query_2;
+        {
+            TaskScheduler task_scheduler{getNUMAConfig(queue_type)};
+            SCOPE_EXIT({
+                query_1_released = true;
+                query_2_released = true;
+            });
+            const auto & pool = task_scheduler.getCPUTaskThreadPool();
+
+            // Occupy all the threads, query_1 on node 0 and query_2 on node 1.
+            std::vector<TaskPtr> tasks;
+            tasks.push_back(std::make_unique<BlockedCPUTask>(query_1, query_1_released));
+            tasks.push_back(std::make_unique<BlockedCPUTask>(query_1, query_1_released));
+            task_scheduler.submit(tasks);
+            tasks.push_back(std::make_unique<BlockedCPUTask>(query_2, query_2_released));
+            tasks.push_back(std::make_unique<BlockedCPUTask>(query_2, query_2_released));
+            task_scheduler.submit(tasks);
+            ASSERT_EQ(query_1.getNUMANode(), 0);
+            ASSERT_EQ(query_2.getNUMANode(), 1);
+            ASSERT_TRUE(waitUntil([&] { return pool.getNodeExecuting(0) == 2 && pool.getNodeExecuting(1) == 2; }));
+
+            // No node has idle threads, so the tasks are pending on node 0.
+            tasks.push_back(std::make_unique<CountedTask>(query_1, finished_count));
+            tasks.push_back(std::make_unique<CountedTask>(query_1, finished_count));
+            task_scheduler.submit(tasks);
+            ASSERT_EQ(pool.getNodeLoad(0), 4);
+            ASSERT_EQ(finished_count.load(), 0);
+
+            // The idle threads of node 1 steal the pending tasks of node 0, while the threads of node 0 are busy.
+            auto stolen_tasks = getNUMANodeTasks(1, "stolen");
+            auto redirected_tasks = getNUMANodeTasks(1, "redirected");
+            query_2_released = true;
+            ASSERT_TRUE(waitUntil([&] { return finished_count == 2; }));
+            ASSERT_EQ(getNUMANodeTasks(1, "stolen"), stolen_tasks + 2);
+            ASSERT_EQ(getNUMANodeTasks(1, "redirected"), redirected_tasks);
+            ASSERT_TRUE(waitUntil([&] { return pool.getNodeLoad(1) == 0 && pool.getNodeExecuting(1) == 0; }));
+            ASSERT_EQ(pool.getNodeLoad(0), 2);
+            ASSERT_EQ(pool.getNodeExecuting(0), 2);
+
+            query_1_released = true;
+            ASSERT_TRUE(waitUntil([&] { return pool.getNodeLoad(0) == 0 && pool.getNodeExecuting(0) == 0; }));
+        }
+        std::chrono::seconds timeout(15);
+        query_1.waitFor(timeout);
+        query_2.waitFor(timeout);
+    }
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, numaUnsupportedQueueType)
+try
+{
+    for (auto queue_type : {TaskQueueType::DEFAULT, TaskQueueType::RCQ_MLFQ, TaskQueueType::RCQ_FAIR})
+    {
+        try
+        {
+            TaskScheduler task_scheduler{getNUMAConfig(queue_type)};
+            FAIL() << "NUMA aware scheduling should not support " << magic_enum::enum_name(queue_type);
+        }
+        catch (const Exception & e)
+        {
+            ASSERT_EQ(e.code(), ErrorCodes::INVALID_CONFIG_PARAMETER);
+        }
+    }
+}
+CATCH
+
 } // namespace DB::tests
@@ -50,12 +50,15 @@ String PhysicalPlanNode::toString()
             ", ");
         return buffer.toString();
     };
-    return fmt::format(
+    auto str = fmt::format(
         "<{}, {}> | is_tidb_operator: {}, schema: {}",
         type.toString(),
         executor_id,
         is_tidb_operator,
         schema_to_string());
+    if (eliminated_expr_count > 0)
+        str += fmt::format(", eliminated_exprs: {}", eliminated_expr_count);
+    return str;
 }
 
 String PhysicalPlanNode::toSimpleString()
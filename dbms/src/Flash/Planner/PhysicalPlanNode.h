@@ -94,6 +94,10 @@ public:
 
     const FineGrainedShuffle & getFineGrainedShuffle() const { return fine_grained_shuffle; }
 
+    /// The number of expressions that this operator reuses from the columns computed by its child.
+    void setEliminatedExprCount(size_t count) { eliminated_expr_count = count; }
+    size_t getEliminatedExprCount() const { return eliminated_expr_count; }
+
     String toString();
 
     String toSimpleString();
@@ -132,6 +136,8 @@ protected:
     bool is_restore_concurrency = true;
     bool finalized = false;
 
+    size_t eliminated_expr_count = 0;
+
     LoggerPtr log;
 };
 } // namespace DB
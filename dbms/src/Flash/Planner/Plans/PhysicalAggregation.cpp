@@ -35,6 +35,33 @@
 
 namespace DB
 {
+namespace
+{
+// A partial aggregation in MPP task always sends its result to the final aggregation through an exchange sender,
+// passing through the rows that can not be aggregated well saves the cost of building hash table for them.
+bool canAutoPassThrough(
+    const Context & context,
+    const tipb::Aggregation & aggregation,
+    const FineGrainedShuffle & fine_grained_shuffle)
+{
+    if (!context.getSettingsRef().enable_auto_pass_through_for_partial_agg)
+        return false;
+    const auto * dag_context = context.getDAGContext();
+    if (dag_context == nullptr || !dag_context->isMPPTask())
+        return false;
+    // The partial mode is only marked on the agg funcs. An aggregation without agg funcs, e.g. the partial stage of
+    // `select distinct`, can not be told from a final one, so it is excluded unless TiDB sets the pre agg mode.
+    if (aggregation.agg_func_size() == 0)
+        return false;
+    if (fine_grained_shuffle.enabled() || AggregationInterpreterHelper::isFinalAgg(aggregation))
+        return false;
+    // The partial result of distinct aggregation can not be generated row by row.
+    return std::none_of(aggregation.agg_func().begin(), aggregation.agg_func().end(), [](const tipb::Expr & expr) {
+        return expr.has_distinct();
+    });
+}
+} // namespace
+
 PhysicalPlanNodePtr PhysicalAggregation::build(
     const Context & context,
     const String & executor_id,
@@ -91,6 +118,11 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
     auto schema = PhysicalPlanHelper::addSchemaProjectAction(expr_after_agg_actions, analyzer.getCurrentInputColumns());
 
     AutoPassThroughSwitcher auto_pass_through_switcher(aggregation);
+    if (!auto_pass_through_switcher.has_set && canAutoPassThrough(context, aggregation, fine_grained_shuffle))
+    {
+        LOG_DEBUG(log, "switch on auto pass through for partial agg");
+        auto_pass_through_switcher = AutoPassThroughSwitcher(true, ::tipb::TiFlashPreAggMode::Auto);
+    }
     if (aggregation_keys.empty())
     {
         LOG_DEBUG(log, "switch off auto pass through because agg keys_size is zero");
@@ -112,6 +144,7 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
         auto_pass_through_switcher,
         aggregate_descriptions,
         expr_after_agg_actions);
+    physical_agg->setEliminatedExprCount(analyzer.getEliminatedExprCount());
     return physical_agg;
 }
 
@@ -175,6 +208,7 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
     }
     else if (auto_pass_through_switcher.enabled())
     {
+        auto shared_sampler = newAutoPassThroughSampler(context);
         if (auto_pass_through_switcher.forceStreaming())
         {
             pipeline.transform([&](auto & stream) {
@@ -182,7 +216,8 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
                     stream,
                     params,
                     log->identifier(),
-                    context.getSettings().max_block_size);
+                    context.getSettings().max_block_size,
+                    shared_sampler);
                 stream->setExtraInfo(String(autoPassThroughAggregatingExtraInfo));
             });
         }
@@ -193,7 +228,8 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
                     stream,
                     params,
                     log->identifier(),
-                    context.getSettings().max_block_size);
+                    context.getSettings().max_block_size,
+                    shared_sampler);
                 stream->setExtraInfo(String(autoPassThroughAggregatingExtraInfo));
             });
         }
@@ -315,6 +351,7 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
     }
     else if (auto_pass_through_switcher.enabled())
     {
+        auto shared_sampler = newAutoPassThroughSampler(context);
         if (auto_pass_through_switcher.forceStreaming())
         {
             group_builder.transform([&](auto & builder) {
@@ -323,7 +360,8 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
                     exec_context,
                     params,
                     log->identifier(),
-                    context.getSettings().max_block_size));
+                    context.getSettings().max_block_size,
+                    shared_sampler));
             });
         }
         else if (auto_pass_through_switcher.isAuto())
@@ -334,7 +372,8 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
                     exec_context,
                     params,
                     log->identifier(),
-                    context.getSettings().max_block_size));
+                    context.getSettings().max_block_size,
+                    shared_sampler));
             });
         }
         else
@@ -353,6 +392,15 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
     executeExpression(exec_context, group_builder, expr_after_agg, log);
 }
 
+AutoPassThroughSharedSamplerPtr PhysicalAggregation::newAutoPassThroughSampler(Context & context) const
+{
+    // All the threads of this aggregation share the sampler.
+    auto shared_sampler = std::make_shared<AutoPassThroughSharedSampler>();
+    if (auto * dag_context = context.getDAGContext(); dag_context)
+        dag_context->getAutoPassThroughSamplerMap()[execId()] = shared_sampler;
+    return shared_sampler;
+}
+
 void PhysicalAggregation::buildPipeline(
     PipelineBuilder & builder,
     Context & context,
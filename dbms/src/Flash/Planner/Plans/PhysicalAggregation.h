@@ -75,6 +75,8 @@ private:
         Context & context,
         size_t /*concurrency*/) override;
 
+    AutoPassThroughSharedSamplerPtr newAutoPassThroughSampler(Context & context) const;
+
 private:
     ExpressionActionsPtr before_agg_actions;
     Names aggregation_keys;
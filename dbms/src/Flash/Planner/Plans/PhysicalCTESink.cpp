@@ -18,6 +18,7 @@
 #include <Interpreters/Context.h>
 #include <Operators/CTE.h>
 #include <Operators/CTESinkOp.h>
+#include <Operators/CTESpillContext.h>
 
 #include <memory>
 
@@ -47,6 +48,21 @@ void PhysicalCTESink::buildPipelineExecGroupImpl(
 
     cte->checkSinkConcurrency(group_builder.concurrency());
 
+    const auto & settings = context.getSettingsRef();
+    SpillConfig spill_config(
+        context.getTemporaryPath(),
+        fmt::format("{}_cte", log->identifier()),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider(),
+        1,
+        settings.max_block_size);
+    auto spill_context = std::make_shared<CTESpillContext>(spill_config, settings.max_bytes_before_external_cte, log);
+    // All the sink tasks share the same cte, so only the first one registers the spill context.
+    if (cte->trySetSpillContext(spill_context))
+        exec_context.registerOperatorSpillContext(spill_context);
+
     size_t id = 0;
     group_builder.transform([&](auto & builder) {
         builder.setSinkOp(std::make_unique<CTESinkOp>(exec_context, log->identifier(), cte, id));
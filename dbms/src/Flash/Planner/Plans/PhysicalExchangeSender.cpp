@@ -95,6 +95,7 @@ void PhysicalExchangeSender::buildBlockInputStreamImpl(DAGPipeline & pipeline, C
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().mpp_exchange_skew_sample_rows,
             log->identifier());
         stream
             = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
@@ -132,6 +133,7 @@ void PhysicalExchangeSender::buildPipelineExecGroupImpl(
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().mpp_exchange_skew_sample_rows,
             log->identifier(),
             /*is_async=*/true);
         builder.setSinkOp(
@@ -47,6 +47,7 @@ PhysicalPlanNodePtr PhysicalFilter::build(
         child,
         filter_column_name,
         before_filter_actions);
+    physical_filter->setEliminatedExprCount(analyzer.getEliminatedExprCount());
 
     return physical_filter;
 }
@@ -57,6 +57,7 @@ PhysicalPlanNodePtr PhysicalProjection::build(
         child,
         "projection",
         project_actions);
+    physical_projection->setEliminatedExprCount(analyzer.getEliminatedExprCount());
     return physical_projection;
 }
 
@@ -55,6 +55,7 @@ PhysicalPlanNodePtr PhysicalTopN::build(
         order_descr,
         before_sort_actions,
         top_n.limit());
+    physical_top_n->setEliminatedExprCount(analyzer.getEliminatedExprCount());
     return physical_top_n;
 }
 
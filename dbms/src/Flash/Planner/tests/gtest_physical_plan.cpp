@@ -264,6 +264,31 @@ Expression: <final projection>
 }
 CATCH
 
+TEST_F(PhysicalPlanTestRunner, ReuseChildComputedColumn)
+try
+{
+    // The projection reuses `concat(s1, s2)` computed by the filter below instead of computing it again.
+    auto request = context.receive("exchange1")
+                       .filter(eq(concat(col("s1"), col("s2")), lit(Field(String("bananabanana")))))
+                       .project({concat(col("s1"), col("s2"))})
+                       .build(context);
+
+    execute(
+        request,
+        /*expected_physical_plan=*/replaceStringName(R"(
+<Projection, project_2> | is_tidb_operator: false, schema: <project_2_tidbConcat(s1, s2)_collator_46 , Nullable({StringName})>
+ <Projection, project_2> | is_tidb_operator: true, schema: <tidbConcat(s1, s2)_collator_46 , Nullable({StringName})>, eliminated_exprs: 1
+  <Filter, selection_1> | is_tidb_operator: true, schema: <s1, Nullable({StringName})>, <s2, Nullable({StringName})>
+   <MockExchangeReceiver, exchange_receiver_0> | is_tidb_operator: true, schema: <s1, Nullable({StringName})>, <s2, Nullable({StringName})>)"),
+        /*expected_streams=*/R"(
+Expression: <final projection>
+ Expression: <projection>
+  Filter
+   MockExchangeReceiver)",
+        {toNullableVec<String>({"bananabanana"})});
+}
+CATCH
+
 TEST_F(PhysicalPlanTestRunner, MockExchangeSender)
 try
 {
@@ -0,0 +1,38 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Statistics/AggImpl.h>
+
+namespace DB
+{
+void AggStatistics::appendExtraJson(FmtBuffer & fmt_buffer) const
+{
+    if (auto_pass_through_sampler)
+        auto_pass_through_sampler->appendJson(fmt_buffer);
+    else
+        fmt_buffer.append(R"("auto_pass_through":null)");
+}
+
+void AggStatistics::collectExtraRuntimeDetail()
+{
+    const auto & sampler_map = dag_context.getAutoPassThroughSamplerMap();
+    if (auto it = sampler_map.find(executor_id); it != sampler_map.end())
+        auto_pass_through_sampler = it->second;
+}
+
+AggStatistics::AggStatistics(const tipb::Executor * executor, DAGContext & dag_context_)
+    : AggStatisticsBase(executor, dag_context_)
+{}
+} // namespace DB
@@ -19,18 +19,6 @@
 
 namespace DB
 {
-struct AggImpl
-{
-    static constexpr bool has_extra_info = false;
-
-    static constexpr auto type = "Agg";
-
-    static bool isMatch(const tipb::Executor * executor) { return executor->has_aggregation(); }
-
-    static bool isSourceExecutor() { return false; }
-};
-using AggStatistics = ExecutorStatistics<AggImpl>;
-
 struct WindowImpl
 {
     static constexpr bool has_extra_info = false;
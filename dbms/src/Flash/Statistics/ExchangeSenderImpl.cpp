@@ -24,14 +24,15 @@ namespace DB
 String MPPTunnelDetail::toJson() const
 {
     return fmt::format(
-        R"({{"tunnel_id":"{}","sender_target_task_id":{},"sender_target_host":"{}","is_local":{},"conn_type":"{}","packets":{},"bytes":{}}})",
+        R"({{"tunnel_id":"{}","sender_target_task_id":{},"sender_target_host":"{}","is_local":{},"conn_type":"{}","packets":{},"bytes":{},"rows":{}}})",
         tunnel_id,
         sender_target_task_id,
         sender_target_host,
         is_local,
         conn_profile_info.getTypeString(),
         conn_profile_info.packets,
-        conn_profile_info.bytes);
+        conn_profile_info.bytes,
+        rows);
 }
 
 void ExchangeSenderStatistics::appendExtraJson(FmtBuffer & fmt_buffer) const
@@ -57,6 +58,7 @@ void ExchangeSenderStatistics::collectExtraRuntimeDetail()
         const auto & connection_profile_info = mpp_tunnels[i]->getConnectionProfileInfo();
         mpp_tunnel_details[i].conn_profile_info.packets += connection_profile_info.packets;
         mpp_tunnel_details[i].conn_profile_info.bytes += connection_profile_info.bytes;
+        mpp_tunnel_details[i].rows += mpp_tunnels[i]->getSentRows();
         base.updateSendConnectionInfo(connection_profile_info);
     }
 }
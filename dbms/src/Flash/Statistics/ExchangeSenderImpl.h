@@ -27,6 +27,7 @@ struct MPPTunnelDetail
     String sender_target_host;
     bool is_local;
     ConnectionProfileInfo conn_profile_info;
+    Int64 rows = 0;
 
     MPPTunnelDetail(
         const ConnectionProfileInfo & conn_profile_info_,
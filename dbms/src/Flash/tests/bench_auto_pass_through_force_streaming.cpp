@@ -20,6 +20,7 @@
 #include <DataTypes/DataTypesNumber.h>
 #include <Functions/FunctionHelpers.h>
 #include <Operators/AutoPassThroughHashAggContext.h>
+#include <Operators/AutoPassThroughSharedSampler.h>
 #include <TestUtils/ColumnGenerator.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <benchmark/benchmark.h>
@@ -220,5 +221,29 @@ DEFINE_FAST_BENCH(fast_sum_nullable, sum_nullable_desc, sum_nullable_header, chi
 
 #undef DEFINE_GENERIC_BENCH
 #undef DEFINE_FAST_BENCH
+
+// The overhead of sharing the observations of auto pass through hash agg between threads, every thread
+// reports the rows of each block and samples the hit rate once per `sample_interval` blocks.
+static void sharedSampler(benchmark::State & state)
+{
+    static AutoPassThroughSharedSampler sampler;
+    const size_t block_size = 65536;
+    const size_t sample_interval = 5;
+    size_t block_idx = 0;
+    for (const auto & _ : state)
+    {
+        if (++block_idx % sample_interval == 0)
+        {
+            auto decision = sampler.addSample(block_size, block_idx % 3 == 0 ? block_size : 0);
+            benchmark::DoNotOptimize(decision);
+        }
+        else
+        {
+            sampler.addPassThroughRows(block_size);
+        }
+        benchmark::DoNotOptimize(sampler.getPreHashAggEpoch());
+    }
+}
+BENCHMARK(sharedSampler)->Threads(1)->Threads(8)->Threads(32);
 } // namespace tests
 } // namespace DB
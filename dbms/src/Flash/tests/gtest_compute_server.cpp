@@ -203,7 +203,9 @@ public:
                     context.context->getSettingsRef().group_by_two_level_threshold = 1;
                     context.context->getSettingsRef().group_by_two_level_threshold_bytes = 1;
                 }
-                else if (test_case_name == "stateSwitchMediumNDV" || test_case_name == "autoPassThroughIntegrationTest")
+                else if (
+                    test_case_name == "stateSwitchMediumNDV" || test_case_name == "autoPassThroughIntegrationTest"
+                    || test_case_name == "stateSwitchBackBySharedSampler")
                 {
                     context.context->getSettingsRef().max_block_size = block_size;
                 }
@@ -1971,6 +1973,98 @@ try
 }
 CATCH
 
+// The partial aggregations without pre agg mode run as auto pass through hashagg when the setting is on.
+TEST_F(ComputeServerRunner, autoPassThroughForPartialAgg)
+try
+{
+    auto workloads = std::vector{
+        auto_pass_through_test_data.low_ndv_tbl_name,
+        auto_pass_through_test_data.high_ndv_tbl_name,
+        auto_pass_through_test_data.medium_ndv_tbl_name,
+        auto_pass_through_test_data.nullable_high_ndv_tbl_name,
+    };
+    for (const auto & tbl_name : workloads)
+    {
+        auto builder = context.scan(auto_pass_through_test_data.db_name, tbl_name)
+                           .aggregation(
+                               auto_pass_through_test_data.agg_func_asts,
+                               {col(auto_pass_through_test_data.col1_name)},
+                               0,
+                               nullptr);
+        // The mock servers copy the settings when they start.
+        context.context->setSetting("enable_auto_pass_through_for_partial_agg", "false");
+        startServers(2);
+        auto res_pre_agg = getResultBlocks(context, builder, serverNum());
+
+        context.context->setSetting("enable_auto_pass_through_for_partial_agg", "true");
+        startServers(2);
+        WRAP_FOR_SERVER_TEST_BEGIN
+        ASSERT_COLUMNS_EQ_UR(res_pre_agg, getResultBlocks(context, builder, serverNum()));
+        WRAP_FOR_SERVER_TEST_END
+    }
+    context.context->setSetting("enable_auto_pass_through_for_partial_agg", "false");
+}
+CATCH
+
+// A thread in pass through state samples again once another thread finds the data is worth aggregating.
+TEST_F(ComputeServerRunner, stateSwitchBackBySharedSampler)
+try
+{
+    auto & high_ndv_blocks = auto_pass_through_test_data.high_ndv_blocks;
+    auto & random_blocks = auto_pass_through_test_data.random_blocks;
+    auto & low_ndv_blocks = auto_pass_through_test_data.low_ndv_blocks;
+
+    auto shared_sampler = std::make_shared<AutoPassThroughSharedSampler>();
+    auto pass_through_context = auto_pass_through_test_data.buildAutoPassHashAggThroughContext(context);
+    auto pre_hashagg_context = auto_pass_through_test_data.buildAutoPassHashAggThroughContext(context);
+    for (auto * ctx : {pass_through_context.get(), pre_hashagg_context.get()})
+    {
+        ctx->setSharedSampler(shared_sampler);
+        // 1 block for adjust state
+        ctx->updateAdjustStateRowLimitUnitNum(1);
+    }
+    // Without the shared sampler, the first thread stays in pass through state for 10 blocks.
+    pass_through_context->updateDynamicRowLimitUnitNum(10);
+    pre_hashagg_context->updateDynamicRowLimitUnitNum(1);
+    const auto dynamic_row_limit = pass_through_context->getDynamicRowLimit();
+
+    auto consume = [](AutoPassThroughHashAggContext & ctx, BlocksList & blocks) {
+        if (blocks.empty())
+            return false;
+        ctx.onBlock<false>(blocks.front());
+        blocks.pop_front();
+        return true;
+    };
+    using State = AutoPassThroughHashAggContext::State;
+
+    // Every row of the high ndv blocks is distinct, so the first thread switches to pass through state.
+    while (pass_through_context->getCurState() == State::Init)
+        ASSERT_TRUE(consume(*pass_through_context, high_ndv_blocks));
+    ASSERT_EQ(pass_through_context->getCurState(), State::Adjust);
+    ASSERT_TRUE(consume(*pass_through_context, high_ndv_blocks));
+    ASSERT_EQ(pass_through_context->getCurState(), State::PassThrough);
+    ASSERT_TRUE(consume(*pass_through_context, high_ndv_blocks));
+    ASSERT_EQ(pass_through_context->getCurState(), State::PassThrough);
+
+    // The other thread sees the low ndv blocks, the merged hit rate grows until it decides to aggregate.
+    while (pre_hashagg_context->getCurState() == State::Init)
+        ASSERT_TRUE(consume(*pre_hashagg_context, random_blocks));
+    while (shared_sampler->getPreHashAggEpoch() == 0)
+        ASSERT_TRUE(consume(*pre_hashagg_context, low_ndv_blocks));
+    ASSERT_EQ(pre_hashagg_context->getCurState(), State::PreHashAgg);
+
+    // The first thread samples again before reaching its row limit.
+    ASSERT_TRUE(consume(*pass_through_context, high_ndv_blocks));
+    ASSERT_EQ(pass_through_context->getCurState(), State::Adjust);
+    ASSERT_EQ(pass_through_context->getDynamicRowLimit(), dynamic_row_limit);
+
+    FmtBuffer fmt_buffer;
+    shared_sampler->appendJson(fmt_buffer);
+    auto json = fmt_buffer.toString();
+    ASSERT_NE(json.find(R"("switch_back_count":1)"), String::npos) << json;
+}
+CATCH
+
 TEST_F(ComputeServerRunner, autoPassThroughEmptyTable)
 try
 {
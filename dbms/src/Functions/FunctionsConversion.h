@@ -1838,6 +1838,23 @@ public:
             auto format = col_const->getValue<String>();
             ColumnString::Chars_t & data_to = col_to->getChars();
             ColumnString::Offsets & offsets_to = col_to->getOffsets();
+            if (auto packed_formatter = MyDateTimePackedFormatter::tryCreate(format); packed_formatter)
+            {
+                // Every result has the same length, format the packed values into the chars directly.
+                const size_t length = packed_formatter->length();
+                data_to.resize(size * (length + 1));
+                offsets_to.resize(size);
+                auto * pos = reinterpret_cast<char *>(data_to.data());
+                for (size_t i = 0; i < size; i++)
+                {
+                    packed_formatter->format(vec_from[i], pos);
+                    pos[length] = 0;
+                    pos += length + 1;
+                    offsets_to[i] = (i + 1) * (length + 1);
+                }
+                block.getByPosition(result).column = std::move(col_to);
+                return;
+            }
             auto max_length = maxFormattedDateTimeStringLength(format);
             data_to.resize(size * max_length);
             offsets_to.resize(size);
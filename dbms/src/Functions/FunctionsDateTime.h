@@ -1985,11 +1985,12 @@ private:
         }
         else
         {
+            const Int64 days_y = dayNum(y);
             for (size_t i = 0, size = x.size(); i < size; ++i)
             {
                 result_null_map[i] = (x_data[i] == 0);
                 if (!result_null_map[i])
-                    result[i] = calculate(x_data[i], y);
+                    result[i] = dayNum(x_data[i]) - days_y;
             }
         }
     }
@@ -2008,24 +2009,27 @@ private:
         }
         else
         {
+            const Int64 days_x = dayNum(x);
             for (size_t i = 0, size = y.size(); i < size; ++i)
             {
                 result_null_map[i] = (y_data[i] == 0);
                 if (!result_null_map[i])
-                    result[i] = calculate(x, y_data[i]);
+                    result[i] = days_x - dayNum(y_data[i]);
             }
         }
     }
 
-    static Int64 calculate(UInt64 x_packed, UInt64 y_packed)
+    static Int64 dayNum(UInt64 packed)
     {
-        MyDateTime x(x_packed);
-        MyDateTime y(y_packed);
-
-        Int64 days_x = calcDayNum(x.year, x.month, x.day);
-        Int64 days_y = calcDayNum(y.year, y.month, y.day);
+        return calcDayNum(MyTimePacked::year(packed), MyTimePacked::month(packed), MyTimePacked::day(packed));
+    }
 
-        return days_x - days_y;
+    static Int64 calculate(UInt64 x_packed, UInt64 y_packed)
+    {
+        // Rows of the same day are common in time-bucketed data, skip computing the day numbers.
+        if ((x_packed >> MyTimePacked::YMD_OFFSET) == (y_packed >> MyTimePacked::YMD_OFFSET))
+            return 0;
+        return dayNum(x_packed) - dayNum(y_packed);
     }
 };
 
@@ -2381,6 +2385,8 @@ public:
             const auto offset = offset_col->getInt(0);
             for (size_t i = 0; i < size; ++i)
             {
+                if (tryConvertTimeZoneByOffsetWithinDay(vec_from[i], vec_to[i], convert_from_utc, offset))
+                    continue;
                 UInt64 result_time = vec_from[i] + offset;
                 // todo maybe affected by daytime saving, need double check
                 if constexpr (convert_from_utc)
@@ -2770,38 +2776,34 @@ struct ExtractMyDateTimeImpl
 
     static Int64 extractDayMicrosecond(UInt64 packed)
     {
-        MyDateTime datetime(packed);
-        Int64 day = datetime.day;
-        Int64 h = datetime.hour;
-        Int64 m = datetime.minute;
-        Int64 s = datetime.second;
-        return (day * 1000000 + h * 10000 + m * 100 + s) * 1000000 + datetime.micro_second;
+        Int64 day = MyTimePacked::day(packed);
+        Int64 h = MyTimePacked::hour(packed);
+        Int64 m = MyTimePacked::minute(packed);
+        Int64 s = MyTimePacked::second(packed);
+        return (day * 1000000 + h * 10000 + m * 100 + s) * 1000000 + MyTimePacked::microSecond(packed);
     }
 
     static Int64 extractDaySecond(UInt64 packed)
     {
-        MyDateTime datetime(packed);
-        Int64 day = datetime.day;
-        Int64 h = datetime.hour;
-        Int64 m = datetime.minute;
-        Int64 s = datetime.second;
+        Int64 day = MyTimePacked::day(packed);
+        Int64 h = MyTimePacked::hour(packed);
+        Int64 m = MyTimePacked::minute(packed);
+        Int64 s = MyTimePacked::second(packed);
         return day * 1000000 + h * 10000 + m * 100 + s;
     }
 
     static Int64 extractDayMinute(UInt64 packed)
     {
-        MyDateTime datetime(packed);
-        Int64 day = datetime.day;
-        Int64 h = datetime.hour;
-        Int64 m = datetime.minute;
+        Int64 day = MyTimePacked::day(packed);
+        Int64 h = MyTimePacked::hour(packed);
+        Int64 m = MyTimePacked::minute(packed);
         return day * 10000 + h * 100 + m;
     }
 
     static Int64 extractDayHour(UInt64 packed)
     {
-        MyDateTime datetime(packed);
-        Int64 day = datetime.day;
-        Int64 h = datetime.hour;
+        Int64 day = MyTimePacked::day(packed);
+        Int64 h = MyTimePacked::hour(packed);
         return day * 100 + h;
     }
 
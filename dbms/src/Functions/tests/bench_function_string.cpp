@@ -306,6 +306,58 @@ BENCH_LIKE_COLLATOR(ASCII_BIN);
 BENCH_LIKE_COLLATOR(BINARY);
 BENCH_LIKE_COLLATOR(LATIN1_BIN);
 
+class CollationSortKeyBench : public benchmark::Fixture
+{
+public:
+    using ColStringType = typename TypeTraits<String>::FieldType;
+
+    ColumnWithTypeAndName data;
+
+    void SetUp(const benchmark::State &) override
+    {
+        std::vector<ColStringType> strs;
+        strs.reserve(data_num);
+        for (size_t i = 0; i < data_num; ++i)
+            strs.push_back(fmt::format("Tenant-{:08}-abcdefg", (i * 2654435761) % data_num));
+        data = toVec<String>("col", strs);
+    }
+};
+
+#define BENCH_SORT_KEY_COLLATOR(collator)                                                                 \
+    BENCHMARK_DEFINE_F(CollationSortKeyBench, compare_##collator)                                         \
+    (benchmark::State & state)                                                                            \
+    try                                                                                                   \
+    {                                                                                                     \
+        TiDB::TiDBCollatorPtr collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::collator); \
+        IColumn::Permutation perm;                                                                        \
+        for (auto _ : state)                                                                              \
+        {                                                                                                 \
+            data.column->getPermutation(*collator, false, 0, 0, perm);                                    \
+        }                                                                                                 \
+    }                                                                                                     \
+    CATCH                                                                                                 \
+    BENCHMARK_REGISTER_F(CollationSortKeyBench, compare_##collator)->Iterations(10);                      \
+    BENCHMARK_DEFINE_F(CollationSortKeyBench, materialize_##collator)                                     \
+    (benchmark::State & state)                                                                            \
+    try                                                                                                   \
+    {                                                                                                     \
+        TiDB::TiDBCollatorPtr collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::collator); \
+        TiDB::TiDBCollatorPtr binary = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::BINARY);     \
+        IColumn::Permutation perm;                                                                        \
+        for (auto _ : state)                                                                              \
+        {                                                                                                 \
+            const auto & col = assert_cast<const ColumnString &>(*data.column);                           \
+            auto sort_keys = col.materializeSortKeys(*collator);                                          \
+            sort_keys->getPermutation(*binary, false, 0, 0, perm);                                        \
+        }                                                                                                 \
+    }                                                                                                     \
+    CATCH                                                                                                 \
+    BENCHMARK_REGISTER_F(CollationSortKeyBench, materialize_##collator)->Iterations(10);
+
+BENCH_SORT_KEY_COLLATOR(UTF8MB4_GENERAL_CI);
+BENCH_SORT_KEY_COLLATOR(UTF8MB4_UNICODE_CI);
+BENCH_SORT_KEY_COLLATOR(UTF8MB4_0900_AI_CI);
+
 class LengthBench : public benchmark::Fixture
 {
 public:
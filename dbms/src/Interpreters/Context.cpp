@@ -31,6 +31,7 @@
 #include <Debug/DBGInvoker.h>
 #include <Debug/MockStorage.h>
 #include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Mpp/MPPResultCache.h>
 #include <IO/BaseFile/fwd.h>
 #include <IO/Buffer/ReadBufferFromFile.h>
 #include <IO/FileProvider/FileProvider.h>
@@ -56,6 +57,7 @@
 #include <Storages/DeltaMerge/ColumnFile/ColumnFileSchema.h>
 #include <Storages/DeltaMerge/DeltaIndex/DeltaIndexManager.h>
 #include <Storages/DeltaMerge/File/ColumnCacheLongTerm.h>
+#include <Storages/DeltaMerge/File/ColumnPackCacheLongTerm.h>
 #include <Storages/DeltaMerge/Index/LocalIndexCache.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 #include <Storages/DeltaMerge/LocalIndexerScheduler.h>
@@ -155,6 +157,8 @@ struct ContextShared
     mutable DM::LocalIndexCachePtr
         heavy_local_index_cache; // Cache of local index reader which memory usage is large > 1MB.
     mutable DM::ColumnCacheLongTermPtr column_cache_long_term;
+    mutable DM::ColumnPackCacheLongTermPtr column_pack_cache_long_term;
+    mutable MPPResultCachePtr mpp_result_cache; /// Cache of the results of leaf MPP tasks.
     mutable DM::DeltaIndexManagerPtr delta_index_manager; /// Manage the Delta Indies of Segments.
     ProcessList process_list; /// Executing queries at the moment.
     ConfigurationPtr users_config; /// Config with the users, profiles and quotas sections.
@@ -1315,6 +1319,50 @@ void Context::dropColumnCacheLongTerm() const
         shared->column_cache_long_term.reset();
 }
 
+void Context::setColumnPackCacheLongTerm(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    RUNTIME_CHECK(!shared->column_pack_cache_long_term);
+
+    shared->column_pack_cache_long_term = std::make_shared<DM::ColumnPackCacheLongTerm>(cache_size_in_bytes);
+}
+
+DM::ColumnPackCacheLongTermPtr Context::getColumnPackCacheLongTerm() const
+{
+    auto lock = getLock();
+    return shared->column_pack_cache_long_term;
+}
+
+void Context::dropColumnPackCacheLongTerm() const
+{
+    auto lock = getLock();
+    if (shared->column_pack_cache_long_term)
+        shared->column_pack_cache_long_term.reset();
+}
+
+void Context::setMPPResultCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    RUNTIME_CHECK(!shared->mpp_result_cache);
+
+    shared->mpp_result_cache = std::make_shared<MPPResultCache>(cache_size_in_bytes);
+}
+
+MPPResultCachePtr Context::getMPPResultCache() const
+{
+    auto lock = getLock();
+    return shared->mpp_result_cache;
+}
+
+void Context::dropMPPResultCache() const
+{
+    auto lock = getLock();
+    if (shared->mpp_result_cache)
+        shared->mpp_result_cache.reset();
+}
+
 bool Context::isDeltaIndexLimited() const
 {
     // Don't need to use a lock here, as delta_index_manager should be set at starting up.
@@ -105,6 +105,7 @@ class MockStorage;
 class JointThreadInfoJeallocMap;
 using JointThreadInfoJeallocMapPtr = std::shared_ptr<JointThreadInfoJeallocMap>;
 class CTEManager;
+class MPPResultCache;
 
 enum class PageStorageRunMode : UInt8;
 namespace DM
@@ -112,6 +113,7 @@ namespace DM
 class MinMaxIndexCache;
 class LocalIndexCache;
 class ColumnCacheLongTerm;
+class ColumnPackCacheLongTerm;
 class DeltaIndexManager;
 class GlobalStoragePool;
 class SharedBlockSchemas;
@@ -412,6 +414,14 @@ public:
     std::shared_ptr<DM::ColumnCacheLongTerm> getColumnCacheLongTerm() const;
     void dropColumnCacheLongTerm() const;
 
+    void setColumnPackCacheLongTerm(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::ColumnPackCacheLongTerm> getColumnPackCacheLongTerm() const;
+    void dropColumnPackCacheLongTerm() const;
+
+    void setMPPResultCache(size_t cache_size_in_bytes);
+    std::shared_ptr<MPPResultCache> getMPPResultCache() const;
+    void dropMPPResultCache() const;
+
     bool isDeltaIndexLimited() const;
     void setDeltaIndexManager(size_t cache_size_in_bytes);
     std::shared_ptr<DM::DeltaIndexManager> getDeltaIndexManager() const;
@@ -72,6 +72,42 @@ ALWAYS_INLINE static inline bool NeedCollation(const IColumn * column, const Sor
     return true;
 }
 
+/// Sorting by a ci collation compares the same row O(log n) times and every comparison re-computes the weights
+/// of both strings. For blocks that are not tiny, materialize the sort keys once and sort them in binary instead.
+static constexpr size_t min_rows_to_materialize_sort_keys = 64;
+
+ALWAYS_INLINE static inline bool NeedMaterializeSortKeys(
+    const IColumn * column,
+    const SortColumnDescription & description)
+{
+    return NeedCollation(column, description) && description.collator->isCI()
+        && column->size() >= min_rows_to_materialize_sort_keys;
+}
+
+static ColumnPtr materializeSortKeys(const IColumn * column, const TiDB::ITiDBCollator & collator)
+{
+    if (const auto * nullable_column = typeid_cast<const ColumnNullable *>(column))
+    {
+        auto nested = materializeSortKeys(&nullable_column->getNestedColumn(), collator);
+        return ColumnNullable::create(nested, nullable_column->getNullMapColumnPtr());
+    }
+    return static_cast<const ColumnString *>(column)->materializeSortKeys(collator);
+}
+
+/// Replace the ci collation string columns by their sort keys, which are compared by the binary collator.
+/// The materialized columns are held by `holder` and are dropped once the permutation is computed.
+static void materializeSortKeys(ColumnsWithSortDescriptions & columns_with_sort_desc, Columns & holder)
+{
+    for (auto & [column, desc] : columns_with_sort_desc)
+    {
+        if (!NeedMaterializeSortKeys(column, desc))
+            continue;
+        holder.push_back(materializeSortKeys(column, *desc.collator));
+        column = holder.back().get();
+        desc.collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::BINARY);
+    }
+}
+
 #define APPLY_FOR_TYPE(M) \
     M(UInt64)             \
     M(Int64)              \
@@ -414,7 +450,17 @@ void sortBlock(Block & block, const SortDescription & description, size_t limit)
             : block.safeGetByPosition(description[0].column_number).column.get();
 
         IColumn::Permutation perm;
-        if (NeedCollation(column, description[0]))
+        if (NeedMaterializeSortKeys(column, description[0]))
+        {
+            auto sort_keys = materializeSortKeys(column, *description[0].collator);
+            sort_keys->getPermutation(
+                *TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::BINARY),
+                reverse,
+                limit,
+                description[0].nulls_direction,
+                perm);
+        }
+        else if (NeedCollation(column, description[0]))
             column->getPermutation(*description[0].collator, reverse, limit, description[0].nulls_direction, perm);
         else
             column->getPermutation(reverse, limit, description[0].nulls_direction, perm);
@@ -434,6 +480,8 @@ void sortBlock(Block & block, const SortDescription & description, size_t limit)
             limit = 0;
 
         ColumnsWithSortDescriptions columns_with_sort_desc = getColumnsWithSortDescription(block, description);
+        Columns materialized_sort_keys;
+        materializeSortKeys(columns_with_sort_desc, materialized_sort_keys);
         const auto collator_desc = FastSortDesc{columns_with_sort_desc};
         if (collator_desc.can_use_fast_path)
         {
@@ -143,5 +143,57 @@ try
 }
 CATCH
 
+TEST_F(BlockSort, CIMaterializedSortKeys)
+try
+{
+    // Large enough to materialize the sort keys of ci collation columns before sorting.
+    const size_t rows = 300;
+    const std::vector<String> candidates{"abc", "ABC  ", "aBd", "Ab", "ß", "ss", "啊a", "啊A ", "", " ", "zZ", "Zz"};
+    ColumnWithString str_data;
+    ColumnWithInt64 int_data;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        str_data.push_back(candidates[(i * 7) % candidates.size()]);
+        int_data.push_back(static_cast<Int64>(i % 5));
+    }
+
+    for (auto collator_id : {
+             TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI,
+             TiDB::ITiDBCollator::UTF8MB4_UNICODE_CI,
+             TiDB::ITiDBCollator::UTF8MB4_0900_AI_CI,
+         })
+    {
+        const auto * collator = TiDB::ITiDBCollator::getCollator(collator_id);
+        for (int direction : {-1, 1})
+        {
+            for (bool multi_columns : {false, true})
+            {
+                const ColumnsWithTypeAndName ori_col
+                    = {toVec<String>(col_name[1], str_data), toVec<Int64>(col_name[0], int_data)};
+                Block block(ori_col);
+                SortDescription description;
+                description.emplace_back(ori_col[0].name, direction, 0, collator);
+                if (multi_columns)
+                    description.emplace_back(ori_col[1].name, direction, 0, nullptr);
+                sortBlock(block, description, 0);
+
+                const auto & sorted_str = block.getByName(col_name[1]).column;
+                const auto & sorted_int = block.getByName(col_name[0]).column;
+                ASSERT_EQ(sorted_str->size(), rows);
+                for (size_t i = 1; i < rows; ++i)
+                {
+                    auto prev = sorted_str->getDataAt(i - 1);
+                    auto cur = sorted_str->getDataAt(i);
+                    int res = collator->compare(prev.data, prev.size, cur.data, cur.size) * direction;
+                    ASSERT_LE(res, 0);
+                    if (multi_columns && res == 0)
+                        ASSERT_LE(sorted_int->compareAt(i - 1, i, *sorted_int, 0) * direction, 0);
+                }
+            }
+        }
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
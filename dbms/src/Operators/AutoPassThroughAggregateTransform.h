@@ -29,7 +29,8 @@ public:
         PipelineExecutorContext & exec_context_,
         const Aggregator::Params & params_,
         const String & req_id_,
-        UInt64 row_limit_unit)
+        UInt64 row_limit_unit,
+        const AutoPassThroughSharedSamplerPtr & shared_sampler = nullptr)
         : TransformOp(exec_context_, req_id_)
         , status(Status::building_hash_map)
     {
@@ -39,6 +40,7 @@ public:
             [&]() { return exec_context.isCancelled(); },
             req_id_,
             row_limit_unit);
+        auto_pass_through_context->setSharedSampler(shared_sampler);
     }
 
     String getName() const override { return "AutoPassThroughAggregateTransform"; }
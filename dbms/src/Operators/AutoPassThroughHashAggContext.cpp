@@ -151,19 +151,39 @@ void AutoPassThroughHashAggContext::trySwitchFromAdjustState(size_t total_rows,
     if (adjust_processed_rows < normal_row_limit)
         return;
 
-    double hit_rate = static_cast<double>(adjust_hit_rows) / adjust_processed_rows;
-    RUNTIME_CHECK(std::isnormal(hit_rate) || hit_rate == 0.0);
-    if (hit_rate >= PreHashAggRateLimit)
+    if (shared_sampler)
     {
-        state = State::PreHashAgg;
-    }
-    else if (hit_rate <= PassThroughRateLimit)
-    {
-        state = State::PassThrough;
+        // Decide by the hit rate sampled by all the threads.
+        switch (shared_sampler->addSample(adjust_processed_rows, adjust_hit_rows))
+        {
+        case AutoPassThroughSharedSampler::Decision::PreHashAgg:
+            state = State::PreHashAgg;
+            break;
+        case AutoPassThroughSharedSampler::Decision::PassThrough:
+            state = State::PassThrough;
+            break;
+        case AutoPassThroughSharedSampler::Decision::Selective:
+            state = State::Selective;
+            break;
+        }
+        seen_pre_hashagg_epoch = shared_sampler->getPreHashAggEpoch();
     }
     else
     {
-        state = State::Selective;
+        double hit_rate = static_cast<double>(adjust_hit_rows) / adjust_processed_rows;
+        RUNTIME_CHECK(std::isnormal(hit_rate) || hit_rate == 0.0);
+        if (hit_rate >= PreHashAggRateLimit)
+        {
+            state = State::PreHashAgg;
+        }
+        else if (hit_rate <= PassThroughRateLimit)
+        {
+            state = State::PassThrough;
+        }
+        else
+        {
+            state = State::Selective;
+        }
     }
 
     LOG_DEBUG(
@@ -181,6 +201,22 @@ void AutoPassThroughHashAggContext::trySwitchFromAdjustState(size_t total_rows,
 void AutoPassThroughHashAggContext::trySwitchBackAdjustState(size_t block_rows)
 {
     state_processed_rows += block_rows;
+    if (shared_sampler && needSwitchBackBySharedSampler())
+    {
+        // Another thread finds that the data is worth aggregating now, e.g. the cardinality of the input sorted by
+        // time drops, sample again without waiting for the grown dynamic row limit.
+        LOG_DEBUG(
+            log,
+            "other state back to adjust state by shared sampler: state: {}, processed: {}, limit: {}",
+            magic_enum::enum_name(state),
+            state_processed_rows,
+            dynamic_row_limit);
+        dynamic_row_limit = row_limit_unit * dynamic_unit_num;
+        shared_sampler->addSwitchBack();
+        state = State::Adjust;
+        state_processed_rows = 0;
+        return;
+    }
     size_t row_limit = 0;
 
     switch (state)
@@ -223,6 +259,35 @@ void AutoPassThroughHashAggContext::trySwitchBackAdjustState(size_t block_rows)
     state_processed_rows = 0;
 }
 
+bool AutoPassThroughHashAggContext::needSwitchBackBySharedSampler()
+{
+    if (state != State::PassThrough && state != State::Selective)
+        return false;
+    const auto epoch = shared_sampler->getPreHashAggEpoch();
+    if (epoch == seen_pre_hashagg_epoch)
+        return false;
+    seen_pre_hashagg_epoch = epoch;
+    return true;
+}
+
+void AutoPassThroughHashAggContext::updateSharedSampler(size_t rows)
+{
+    switch (state)
+    {
+    case State::Init:
+    case State::Adjust:
+    case State::PreHashAgg:
+        shared_sampler->addAggregatedRows(rows);
+        break;
+    case State::Selective:
+        shared_sampler->addSelectiveRows(rows);
+        break;
+    case State::PassThrough:
+        shared_sampler->addPassThroughRows(rows);
+        break;
+    }
+}
+
 void AutoPassThroughHashAggContext::pushPassThroughBuffer(const Block & block)
 {
     pass_through_block_buffer.push_back(block);
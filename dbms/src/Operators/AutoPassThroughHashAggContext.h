@@ -16,6 +16,7 @@
 
 #include <Interpreters/Aggregator.h>
 #include <Operators/AutoPassThroughHashAggHelper.h>
+#include <Operators/AutoPassThroughSharedSampler.h>
 #include <tipb/executor.pb.h>
 
 namespace DB
@@ -63,6 +64,7 @@ public:
         , normal_row_limit(row_limit_unit_ * normal_unit_num_)
         , dynamic_row_limit(row_limit_unit_ * dynamic_unit_num_)
         , row_limit_unit(row_limit_unit_)
+        , dynamic_unit_num(dynamic_unit_num_)
         , max_dynamic_row_limit(row_limit_unit_ * MAX_DYNAMIC_UNIT_LIMIT)
         , log(Logger::get(req_id_))
     {
@@ -94,12 +96,16 @@ public:
         if constexpr (force_streaming)
         {
             statistics.update(State::PassThrough, block.rows());
+            if (shared_sampler)
+                shared_sampler->addPassThroughRows(block.rows());
             onBlockForceStreaming(block);
         }
         else
         {
             forceState();
             statistics.update(state, block.rows());
+            if (shared_sampler)
+                updateSharedSampler(block.rows());
             onBlockAuto(block);
         }
     }
@@ -109,6 +115,14 @@ public:
 
     Block getHeader() { return aggregator->getHeader(/*final=*/true); }
 
+    /// Share the sampled hit rate with the other threads of the same aggregation.
+    void setSharedSampler(const AutoPassThroughSharedSamplerPtr & shared_sampler_)
+    {
+        shared_sampler = shared_sampler_;
+        if (shared_sampler)
+            seen_pre_hashagg_epoch = shared_sampler->getPreHashAggEpoch();
+    }
+
     // TODO: Stop insert new rows into HashTable when start converting HashTable to two level
     enum class State
     {
@@ -123,7 +137,11 @@ public:
 
     size_t getAdjustRowLimit() const { return normal_row_limit; }
     size_t getDynamicRowLimit() const { return dynamic_row_limit; }
-    void updateDynamicRowLimitUnitNum(UInt64 u) { dynamic_row_limit = row_limit_unit * u; }
+    void updateDynamicRowLimitUnitNum(UInt64 u)
+    {
+        dynamic_unit_num = u;
+        dynamic_row_limit = row_limit_unit * u;
+    }
     void updateAdjustStateRowLimitUnitNum(UInt64 u) { normal_row_limit = row_limit_unit * u; }
 
 private:
@@ -133,6 +151,8 @@ private:
     void trySwitchFromInitState();
     void trySwitchFromAdjustState(size_t total_rows, size_t hit_rows);
     void trySwitchBackAdjustState(size_t block_rows);
+    bool needSwitchBackBySharedSampler();
+    void updateSharedSampler(size_t rows);
 
     void pushPassThroughBuffer(const Block & block);
     Block getPassThroughBlock(const Block & block);
@@ -147,8 +167,8 @@ private:
         return res;
     }
 
-    static constexpr double PassThroughRateLimit = 0.2;
-    static constexpr double PreHashAggRateLimit = 0.9;
+    static constexpr double PassThroughRateLimit = AutoPassThroughSharedSampler::PassThroughRateLimit;
+    static constexpr double PreHashAggRateLimit = AutoPassThroughSharedSampler::PreHashAggRateLimit;
 
     State state;
     // Make sure data variants after aggregator because it needs aggregator in dtor.
@@ -224,8 +244,12 @@ private:
     // Row limit for selective and pass through. It will get larger in runtime.
     size_t dynamic_row_limit;
     size_t row_limit_unit;
+    size_t dynamic_unit_num;
     const size_t max_dynamic_row_limit;
 
+    AutoPassThroughSharedSamplerPtr shared_sampler;
+    UInt64 seen_pre_hashagg_epoch = 0;
+
     LoggerPtr log;
 
     static constexpr size_t INIT_STATE_HASHMAP_THRESHOLD = 2 * 1024 * 1024;
@@ -399,6 +399,8 @@ ColumnPtr genPassThroughColumnGeneric(const AggregateDescription & desc, const B
         desc.function->create(place);
         desc.function->add(place, argument_columns.data(), row_idx, &arena);
         desc.function->insertResultInto(place, *new_col, &arena);
+        // The state of functions like group_concat holds memory out of the arena.
+        desc.function->destroy(place);
     }
     return new_col;
 }
@@ -0,0 +1,58 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Operators/AutoPassThroughSharedSampler.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+AutoPassThroughSharedSampler::Decision AutoPassThroughSharedSampler::addSample(size_t rows, size_t hit_rows)
+{
+    std::lock_guard lock(mu);
+    decayed_rows = decayed_rows * DECAY + rows;
+    decayed_hit_rows = decayed_hit_rows * DECAY + hit_rows;
+    last_hit_rate = decayed_rows > 0 ? decayed_hit_rows / decayed_rows : 0;
+
+    Decision decision = Decision::Selective;
+    if (last_hit_rate >= PreHashAggRateLimit)
+        decision = Decision::PreHashAgg;
+    else if (last_hit_rate <= PassThroughRateLimit)
+        decision = Decision::PassThrough;
+
+    if (decision == Decision::PreHashAgg && last_decision != Decision::PreHashAgg)
+        pre_hashagg_epoch.fetch_add(1, std::memory_order_relaxed);
+    last_decision = decision;
+    ++decision_count[static_cast<size_t>(decision)];
+    return decision;
+}
+
+void AutoPassThroughSharedSampler::appendJson(FmtBuffer & fmt_buffer) const
+{
+    std::lock_guard lock(mu);
+    fmt_buffer.fmtAppend(
+        R"("auto_pass_through":{{"last_decision":"{}","last_hit_rate":{:.3f},"pre_hashagg_decisions":{},)"
+        R"("selective_decisions":{},"pass_through_decisions":{},"switch_back_count":{},"aggregated_rows":{},)"
+        R"("selective_rows":{},"pass_through_rows":{}}})",
+        magic_enum::enum_name(last_decision),
+        last_hit_rate,
+        decision_count[static_cast<size_t>(Decision::PreHashAgg)],
+        decision_count[static_cast<size_t>(Decision::Selective)],
+        decision_count[static_cast<size_t>(Decision::PassThrough)],
+        switch_back_count.load(std::memory_order_relaxed),
+        aggregated_rows.load(std::memory_order_relaxed),
+        selective_rows.load(std::memory_order_relaxed),
+        pass_through_rows.load(std::memory_order_relaxed));
+}
+} // namespace DB
@@ -0,0 +1,80 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/FmtUtils.h>
+#include <common/types.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace DB
+{
+/// AutoPassThroughSharedSampler is shared by all the AutoPassThroughHashAggContexts of one aggregation executor
+/// in a query. Each context only sees the rows of its own thread, so the hit rate sampled by a single thread is
+/// noisy and a thread that has switched to pass through never notices that the cardinality drops (e.g. the input
+/// is sorted by time). The sampler merges the hit rates sampled by all the threads, with the older samples decayed,
+/// and tells the threads in pass through or selective state to sample again once any thread finds the data is
+/// worth aggregating.
+class AutoPassThroughSharedSampler
+{
+public:
+    enum class Decision
+    {
+        PreHashAgg,
+        Selective,
+        PassThrough,
+    };
+
+    static constexpr double PassThroughRateLimit = 0.2;
+    static constexpr double PreHashAggRateLimit = 0.9;
+
+    /// Merge the rows sampled by a thread in adjust state and returns the decision made by the merged hit rate.
+    Decision addSample(size_t rows, size_t hit_rows);
+
+    /// Returns the number of times that the decision changes to PreHashAgg, a context that has seen a smaller
+    /// number should sample again if it is in pass through or selective state.
+    UInt64 getPreHashAggEpoch() const { return pre_hashagg_epoch.load(std::memory_order_relaxed); }
+
+    void addPassThroughRows(size_t rows) { pass_through_rows.fetch_add(rows, std::memory_order_relaxed); }
+    void addSelectiveRows(size_t rows) { selective_rows.fetch_add(rows, std::memory_order_relaxed); }
+    void addAggregatedRows(size_t rows) { aggregated_rows.fetch_add(rows, std::memory_order_relaxed); }
+    void addSwitchBack() { switch_back_count.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Used by the execution summary.
+    void appendJson(FmtBuffer & fmt_buffer) const;
+
+private:
+    // The weight of the merged samples when a new sample comes.
+    static constexpr double DECAY = 0.5;
+
+    mutable std::mutex mu;
+    double decayed_rows = 0;
+    double decayed_hit_rows = 0;
+    Decision last_decision = Decision::PreHashAgg;
+    double last_hit_rate = 0;
+    size_t decision_count[3] = {0, 0, 0};
+
+    std::atomic<UInt64> pre_hashagg_epoch{0};
+
+    std::atomic<size_t> pass_through_rows{0};
+    std::atomic<size_t> selective_rows{0};
+    std::atomic<size_t> aggregated_rows{0};
+    std::atomic<size_t> switch_back_count{0};
+};
+
+using AutoPassThroughSharedSamplerPtr = std::shared_ptr<AutoPassThroughSharedSampler>;
+} // namespace DB
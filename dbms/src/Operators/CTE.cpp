@@ -15,6 +15,7 @@
 #include <Operators/CTE.h>
 #include <Operators/CTEPartition.h>
 
+#include <algorithm>
 #include <cassert>
 #include <mutex>
 #include <shared_mutex>
@@ -34,13 +35,129 @@ CTEOpStatus CTE::tryGetBlockAt(size_t cte_reader_id, size_t partition_id, Block
     if (status != CTEOpStatus::OK)
         return status;
 
-    auto idx = this->partitions[partition_id].fetch_block_idxs[cte_reader_id]++;
-    block = this->partitions[partition_id].blocks[idx].block;
-    if ((--this->partitions[partition_id].blocks[idx].counter) == 0)
-        this->partitions[partition_id].blocks[idx].block.clear();
+    auto & partition = this->partitions[partition_id];
+    const auto & block_with_counter = partition.getBlock(partition.fetch_block_idxs[cte_reader_id]);
+    if (block_with_counter.spiller)
+        return CTEOpStatus::IO_IN;
+
+    block = block_with_counter.block;
+    this->moveToNextBlockNoLock(cte_reader_id, partition_id);
     return status;
 }
 
+CTEOpStatus CTE::readSpilledBlock(size_t cte_reader_id, size_t partition_id, Block & block)
+{
+    auto & partition = this->partitions[partition_id];
+    auto & restore_stream = partition.restore_streams[cte_reader_id];
+    if (!restore_stream)
+    {
+        std::shared_ptr<Spiller> spiller;
+        {
+            std::shared_lock<std::shared_mutex> rw_lock(this->rw_lock);
+            if unlikely (this->is_cancelled)
+                return CTEOpStatus::CANCELLED;
+            std::lock_guard<std::mutex> lock(*partition.mu);
+            spiller = partition.getBlock(partition.fetch_block_idxs[cte_reader_id]).spiller;
+        }
+        RUNTIME_CHECK(spiller);
+        // Restore in one stream to read the spilled files one by one.
+        auto restore_streams = spiller->restoreBlocks(0, 1);
+        RUNTIME_CHECK(restore_streams.size() <= 1);
+        if (!restore_streams.empty())
+        {
+            restore_stream = restore_streams.back();
+            restore_stream->readPrefix();
+        }
+    }
+
+    if (restore_stream)
+    {
+        block = restore_stream->read();
+        if (block)
+            return CTEOpStatus::OK;
+        restore_stream->readSuffix();
+        restore_stream.reset();
+    }
+
+    std::shared_lock<std::shared_mutex> rw_lock(this->rw_lock);
+    std::lock_guard<std::mutex> lock(*partition.mu);
+    this->moveToNextBlockNoLock(cte_reader_id, partition_id);
+    return CTEOpStatus::OK;
+}
+
+void CTE::moveToNextBlockNoLock(size_t cte_reader_id, size_t partition_id)
+{
+    auto & partition = this->partitions[partition_id];
+    auto idx = partition.fetch_block_idxs[cte_reader_id]++;
+    auto & block_with_counter = partition.getBlock(idx);
+    if (idx == partition.max_fetch_block_idx)
+    {
+        // The first reader reaches this block, it can not be spilled any more.
+        ++partition.max_fetch_block_idx;
+        partition.unread_memory_usages -= block_with_counter.bytes;
+        this->unread_memory_usages -= block_with_counter.bytes;
+    }
+
+    if ((--block_with_counter.counter) == 0)
+    {
+        partition.memory_usages -= block_with_counter.bytes;
+        block_with_counter.block.clear();
+        block_with_counter.spiller.reset();
+    }
+    while (!partition.blocks.empty() && partition.blocks.front().counter == 0)
+    {
+        partition.blocks.pop_front();
+        ++partition.popped_block_num;
+    }
+}
+
+void CTE::spillBlocks()
+{
+    CTESpillContextPtr cur_spill_context;
+    {
+        std::shared_lock<std::shared_mutex> rw_lock(this->rw_lock);
+        cur_spill_context = this->spill_context;
+    }
+    RUNTIME_CHECK(cur_spill_context);
+    cur_spill_context->markSpilled();
+    for (size_t i = 0; i < this->partition_num; ++i)
+        this->spillPartition(i, cur_spill_context);
+    cur_spill_context->finishOneSpill();
+}
+
+void CTE::spillPartition(size_t partition_id, const CTESpillContextPtr & cur_spill_context)
+{
+    auto & partition = this->partitions[partition_id];
+    Blocks blocks;
+    size_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(*partition.mu);
+        // Take the blocks that are not read by any reader from the back, these blocks are invisible to the readers
+        // until the spilled blocks are pushed back, so the order of the blocks in this partition may change.
+        while (partition.getBlockNum() > partition.max_fetch_block_idx && !partition.blocks.back().spiller)
+        {
+            auto & block_with_counter = partition.blocks.back();
+            bytes += block_with_counter.bytes;
+            blocks.push_back(std::move(block_with_counter.block));
+            partition.blocks.pop_back();
+        }
+    }
+    if (blocks.empty())
+        return;
+
+    std::reverse(blocks.begin(), blocks.end());
+    std::shared_ptr<Spiller> spiller = cur_spill_context->buildSpiller(blocks.back().cloneEmpty());
+    spiller->spillBlocks(std::move(blocks), 0);
+    spiller->finishSpill();
+
+    std::lock_guard<std::mutex> lock(*partition.mu);
+    partition.blocks.emplace_back(std::move(spiller), static_cast<Int16>(this->expected_source_num));
+    partition.memory_usages -= bytes;
+    partition.unread_memory_usages -= bytes;
+    this->unread_memory_usages -= bytes;
+    partition.pipe_cv->notifyAll();
+}
+
 template <bool for_test>
 bool CTE::pushBlock(size_t partition_id, const Block & block)
 {
@@ -54,7 +171,10 @@ bool CTE::pushBlock(size_t partition_id, const Block & block)
         return true;
 
     std::lock_guard<std::mutex> lock(*this->partitions[partition_id].mu);
-    this->partitions[partition_id].memory_usages += block.bytes();
+    const auto bytes = block.bytes();
+    this->partitions[partition_id].memory_usages += bytes;
+    this->partitions[partition_id].unread_memory_usages += bytes;
+    this->unread_memory_usages += bytes;
     this->partitions[partition_id].blocks.push_back(
         BlockWithCounter(block, static_cast<Int16>(this->expected_source_num)));
     if constexpr (for_test)
@@ -18,6 +18,7 @@
 #include <Common/RWLock.h>
 #include <Core/Block.h>
 #include <Operators/CTEPartition.h>
+#include <Operators/CTESpillContext.h>
 #include <tipb/select.pb.h>
 
 #include <condition_variable>
@@ -40,6 +41,7 @@ public:
         {
             this->partitions.push_back(CTEPartition());
             this->partitions.back().fetch_block_idxs.resize(this->expected_source_num, 0);
+            this->partitions.back().restore_streams.resize(this->expected_source_num);
             this->partitions.back().mu = std::make_unique<std::mutex>();
             this->partitions.back().pipe_cv = std::make_unique<PipeConditionVariable>();
         }
@@ -70,6 +72,31 @@ public:
 
     CTEOpStatus tryGetBlockAt(size_t cte_reader_id, size_t partition_id, Block & block);
 
+    /// Called after `tryGetBlockAt` returns IO_IN. An empty block with OK means the spilled blocks are all read
+    /// and the reader should call `tryGetBlockAt` again.
+    CTEOpStatus readSpilledBlock(size_t cte_reader_id, size_t partition_id, Block & block);
+
+    /// Returns true if the spill context is set by this call. The spill context is only set by the first sink task,
+    /// so that the memory of the CTE is only counted once.
+    bool trySetSpillContext(const CTESpillContextPtr & spill_context_)
+    {
+        std::unique_lock<std::shared_mutex> lock(this->rw_lock);
+        if (this->spill_context)
+            return false;
+        this->spill_context = spill_context_;
+        return true;
+    }
+
+    /// Called by the sinks after pushing a block.
+    bool needSpill()
+    {
+        std::shared_lock<std::shared_mutex> lock(this->rw_lock);
+        return this->spill_context && this->spill_context->updateRevocableMemory(this->unread_memory_usages.load());
+    }
+
+    /// Spill the blocks that are not read by any reader in all the partitions.
+    void spillBlocks();
+
     template <bool for_test>
     bool pushBlock(size_t partition_id, const Block & block);
     template <bool for_test>
@@ -207,13 +234,18 @@ private:
         if unlikely (this->is_cancelled)
             return CTEOpStatus::CANCELLED;
 
-        if (this->partitions[partition_id].blocks.size()
+        if (this->partitions[partition_id].getBlockNum()
             <= this->partitions[partition_id].fetch_block_idxs[cte_reader_id])
             return this->is_eof ? CTEOpStatus::END_OF_FILE : CTEOpStatus::BLOCK_NOT_AVAILABLE;
 
         return CTEOpStatus::OK;
     }
 
+    // Move the reader to the next block, and release the blocks that have been read by all the readers.
+    void moveToNextBlockNoLock(size_t cte_reader_id, size_t partition_id);
+
+    void spillPartition(size_t partition_id, const CTESpillContextPtr & cur_spill_context);
+
     Int32 getTotalExitNumNoLock() const noexcept { return this->sink_exit_num + this->source_exit_num; }
     Int32 getSinkExitNumNoLock() const noexcept { return this->sink_exit_num; }
     Int32 getExpectedSinkNum() const noexcept { return this->expected_sink_num; }
@@ -233,6 +265,9 @@ private:
             this->is_cancelled = true;
             this->err_msg = msg;
         }
+        // No more blocks will be pushed, so nothing can be spilled.
+        if (this->spill_context)
+            this->spill_context->finishSpillableStage();
 
         for (auto & partition : this->partitions)
         {
@@ -249,10 +284,11 @@ private:
 
     const size_t partition_num;
     std::vector<CTEPartition> partitions;
+    std::atomic<Int64> unread_memory_usages{0};
 
     // Protect fields:
     //   next_cte_reader_id, is_eof, is_cancelled, get_resp, resp, err_msg,
-    //   sink_exit_num, source_exit_num, registered_sink_num
+    //   sink_exit_num, source_exit_num, registered_sink_num, spill_context
     std::shared_mutex rw_lock;
     size_t next_cte_reader_id = 0;
     bool is_eof = false;
@@ -269,5 +305,7 @@ private:
 
     Int32 sink_exit_num = 0;
     Int32 source_exit_num = 0;
+
+    CTESpillContextPtr spill_context;
 };
 } // namespace DB
@@ -14,10 +14,13 @@
 
 #pragma once
 
+#include <Core/Spiller.h>
+#include <DataStreams/IBlockInputStream.h>
 #include <Flash/Pipeline/Schedule/Tasks/PipeConditionVariable.h>
 #include <Flash/Pipeline/Schedule/Tasks/Task.h>
 
 #include <condition_variable>
+#include <deque>
 #include <memory>
 
 namespace DB
@@ -28,27 +31,49 @@ enum class CTEOpStatus
     BLOCK_NOT_AVAILABLE,
     END_OF_FILE,
     CANCELLED,
-    SINK_NOT_REGISTERED
+    SINK_NOT_REGISTERED,
+    // The next blocks are spilled, the reader should restore them by `CTE::readSpilledBlock`.
+    IO_IN,
 };
 
 struct BlockWithCounter
 {
     BlockWithCounter(const Block & block_, Int16 counter_)
         : block(block_)
+        , bytes(block_.bytes())
+        , counter(counter_)
+    {}
+    BlockWithCounter(std::shared_ptr<Spiller> && spiller_, Int16 counter_)
+        : spiller(std::move(spiller_))
         , counter(counter_)
     {}
     Block block;
+    // Not null if this is a batch of spilled blocks.
+    std::shared_ptr<Spiller> spiller;
+    size_t bytes = 0;
+    // The number of readers that have not read the block(s).
     Int16 counter;
 };
 
 struct CTEPartition
 {
     std::unique_ptr<std::mutex> mu;
-    std::vector<BlockWithCounter> blocks;
+    // The blocks that have been read by all the readers are popped from the front.
+    std::deque<BlockWithCounter> blocks;
+    size_t popped_block_num = 0;
+    // The index of the next block to read for each reader, including the popped blocks.
     std::vector<size_t> fetch_block_idxs;
+    // The blocks from this index are not read by any reader, so they can be spilled.
+    size_t max_fetch_block_idx = 0;
     size_t memory_usages = 0;
+    size_t unread_memory_usages = 0;
+    // The streams restoring the spilled blocks for each reader, only accessed by the reader itself.
+    std::vector<BlockInputStreamPtr> restore_streams;
     std::unique_ptr<PipeConditionVariable> pipe_cv;
 
+    size_t getBlockNum() const { return popped_block_num + blocks.size(); }
+    BlockWithCounter & getBlock(size_t idx) { return blocks[idx - popped_block_num]; }
+
 #ifndef NDEBUG
     std::unique_ptr<std::condition_variable> cv_for_test;
 #endif
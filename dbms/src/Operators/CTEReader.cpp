@@ -53,6 +53,7 @@ CTEOpStatus CTEReader::waitForBlockAvailableForTest(size_t partition_idx)
         case CTEOpStatus::OK:
         case CTEOpStatus::CANCELLED:
         case CTEOpStatus::END_OF_FILE:
+        case CTEOpStatus::IO_IN:
             return status;
         default:
             throw Exception("Should not reach here");
@@ -55,6 +55,11 @@ public:
 
     CTEOpStatus fetchNextBlock(size_t source_id, Block & block);
 
+    CTEOpStatus fetchSpilledBlock(size_t source_id, Block & block)
+    {
+        return this->cte->readSpilledBlock(this->cte_reader_id, source_id, block);
+    }
+
     bool getResp(tipb::SelectResponse & resp)
     {
         std::lock_guard<std::mutex> lock(this->mu);
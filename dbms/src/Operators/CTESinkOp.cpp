@@ -28,8 +28,14 @@ OperatorStatus CTESinkOp::writeImpl(Block && block)
         return OperatorStatus::FINISHED;
 
     this->total_rows += block.rows();
-    if (this->cte->pushBlock<false>(this->id, block))
-        return OperatorStatus::NEED_INPUT;
-    return OperatorStatus::CANCELLED;
+    if (!this->cte->pushBlock<false>(this->id, block))
+        return OperatorStatus::CANCELLED;
+    return this->cte->needSpill() ? OperatorStatus::IO_OUT : OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus CTESinkOp::executeIOImpl()
+{
+    this->cte->spillBlocks();
+    return OperatorStatus::NEED_INPUT;
 }
 } // namespace DB
@@ -34,6 +34,7 @@ public:
 protected:
     void operateSuffixImpl() override;
     OperatorStatus writeImpl(Block && block) override;
+    OperatorStatus executeIOImpl() override;
 
 private:
     std::shared_ptr<CTE> cte;
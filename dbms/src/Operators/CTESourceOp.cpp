@@ -18,6 +18,8 @@
 #include <Operators/CTESourceOp.h>
 #include <Operators/Operator.h>
 
+#include <magic_enum.hpp>
+
 namespace DB
 {
 void CTESourceOp::operateSuffixImpl()
@@ -27,6 +29,14 @@ void CTESourceOp::operateSuffixImpl()
 
 OperatorStatus CTESourceOp::readImpl(Block & block)
 {
+    if (t_block.has_value())
+    {
+        std::swap(block, t_block.value());
+        t_block.reset();
+        this->total_rows += block.rows();
+        return OperatorStatus::HAS_OUTPUT;
+    }
+
     auto ret = this->cte_reader->fetchNextBlock(this->id, block);
     switch (ret)
     {
@@ -42,8 +52,29 @@ OperatorStatus CTESourceOp::readImpl(Block & block)
     case CTEOpStatus::SINK_NOT_REGISTERED:
         this->sw.start();
         return OperatorStatus::WAITING;
+    case CTEOpStatus::IO_IN:
+        return OperatorStatus::IO_IN;
+    case CTEOpStatus::CANCELLED:
+        throw Exception(this->cte_reader->getCTE()->getError());
+    }
+}
+
+OperatorStatus CTESourceOp::executeIOImpl()
+{
+    Block block;
+    auto ret = this->cte_reader->fetchSpilledBlock(this->id, block);
+    switch (ret)
+    {
+    case CTEOpStatus::OK:
+        // An empty block means the spilled blocks are all read, then go on reading the cte in `readImpl`.
+        if (block)
+            t_block.emplace(std::move(block));
+        return OperatorStatus::HAS_OUTPUT;
     case CTEOpStatus::CANCELLED:
         throw Exception(this->cte_reader->getCTE()->getError());
+    default:
+        throw Exception(
+            fmt::format("Unexpected cte status {} when reading spilled blocks", magic_enum::enum_name(ret)));
     }
 }
 } // namespace DB
@@ -24,6 +24,7 @@
 #include <Operators/Operator.h>
 
 #include <memory>
+#include <optional>
 
 namespace DB
 {
@@ -75,6 +76,8 @@ protected:
 
     OperatorStatus readImpl(Block & block) override;
 
+    OperatorStatus executeIOImpl() override;
+
     OperatorStatus awaitImpl() override
     {
         if (this->cte_reader->areAllSinksRegistered())
@@ -94,6 +97,8 @@ private:
     tipb::SelectResponse resp;
     size_t id;
     CTESourceNotifyFuture notifier;
+    // The block restored from the spilled blocks of the cte.
+    std::optional<Block> t_block;
     Stopwatch sw;
     String query_id_and_cte_id;
 };
@@ -0,0 +1,69 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Operators/CTESpillContext.h>
+
+namespace DB
+{
+CTESpillContext::CTESpillContext(
+    const SpillConfig & spill_config_,
+    UInt64 operator_spill_threshold_,
+    const LoggerPtr & log)
+    : OperatorSpillContext(operator_spill_threshold_, "cte", log)
+    , spill_config(spill_config_)
+{}
+
+SpillerPtr CTESpillContext::buildSpiller(const Block & input_schema) const
+{
+    return std::make_unique<Spiller>(
+        spill_config,
+        false,
+        1,
+        input_schema,
+        log,
+        /*spill_version=*/1,
+        /*release_spilled_file_on_restore=*/false);
+}
+
+bool CTESpillContext::updateRevocableMemory(Int64 new_value)
+{
+    if (!in_spillable_stage || !isSpillEnabled())
+        return false;
+    revocable_memory = new_value;
+    if (new_value == 0)
+        return false;
+    if (auto_spill_mode)
+    {
+        AutoSpillStatus old_value = AutoSpillStatus::NEED_AUTO_SPILL;
+        return auto_spill_status.compare_exchange_strong(old_value, AutoSpillStatus::WAIT_SPILL_FINISH);
+    }
+    return operator_spill_threshold > 0 && revocable_memory > static_cast<Int64>(operator_spill_threshold);
+}
+
+Int64 CTESpillContext::triggerSpillImpl(Int64 expected_released_memories)
+{
+    if (revocable_memory >= MIN_SPILL_THRESHOLD)
+    {
+        AutoSpillStatus old_value = AutoSpillStatus::NO_NEED_AUTO_SPILL;
+        auto_spill_status.compare_exchange_strong(old_value, AutoSpillStatus::NEED_AUTO_SPILL);
+        expected_released_memories = std::max(expected_released_memories - revocable_memory, 0);
+    }
+    return expected_released_memories;
+}
+
+void CTESpillContext::finishOneSpill()
+{
+    auto_spill_status = AutoSpillStatus::NO_NEED_AUTO_SPILL;
+}
+} // namespace DB
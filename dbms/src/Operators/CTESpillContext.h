@@ -0,0 +1,46 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/OperatorSpillContext.h>
+#include <Core/Spiller.h>
+
+namespace DB
+{
+/// CTESpillContext decides when the blocks of a CTE that are not read by any reader yet should be spilled.
+/// A CTE is shared by all the sink and source tasks of it, so the context is registered to the spill contexts
+/// of only one sink task, and the revocable memory is the memory usage of the whole CTE.
+class CTESpillContext final : public OperatorSpillContext
+{
+private:
+    std::atomic<Int64> revocable_memory{0};
+    std::atomic<AutoSpillStatus> auto_spill_status{AutoSpillStatus::NO_NEED_AUTO_SPILL};
+    SpillConfig spill_config;
+
+public:
+    CTESpillContext(const SpillConfig & spill_config_, UInt64 operator_spill_threshold_, const LoggerPtr & log);
+    /// Each batch of spilled blocks has its own spiller, so that the readers can restore the batch
+    /// before the CTE is complete. The spilled files are kept until the spiller is released because
+    /// every reader restores the batch once.
+    SpillerPtr buildSpiller(const Block & input_schema) const;
+    bool updateRevocableMemory(Int64 new_value);
+    Int64 getTotalRevocableMemoryImpl() override { return revocable_memory; }
+    Int64 triggerSpillImpl(Int64 expected_released_memories) override;
+    void finishOneSpill();
+    bool supportAutoTriggerSpill() const override { return true; }
+};
+
+using CTESpillContextPtr = std::shared_ptr<CTESpillContext>;
+} // namespace DB
@@ -127,6 +127,17 @@ public:
     // because there are many operators that need an empty block as input, such as JoinProbe and WindowFunction.
     OperatorStatus read(Block & block);
     virtual OperatorStatus readImpl(Block & block) = 0;
+
+    // The following methods are used to adjust the number of running pipeline instances at runtime.
+    // Return true if all the instances of this source read from one shared input, so that any instance
+    // can read the rest of the input.
+    virtual bool isSharedInput() const { return false; }
+    // The number of blocks that are ready to be read from the shared input.
+    virtual size_t getBacklog() const { return 0; }
+    // The number of instances that the shared input can keep busy at the beginning, 0 means unknown.
+    virtual size_t getInitialConcurrencyHint() const { return 0; }
+    // Stop reading the shared input, the following `read` returns an empty block to finish this instance.
+    virtual void retire() {}
 };
 using SourceOpPtr = std::unique_ptr<SourceOp>;
 using SourceOps = std::vector<SourceOpPtr>;
@@ -53,6 +53,15 @@ public:
 
     IOProfileInfoPtr getIOProfileInfo() const override { return io_profile_info; }
 
+    bool isSharedInput() const override { return true; }
+
+    size_t getBacklog() const override { return std::max<Int64>(task_pool->getPendingBlockCount(), 0); }
+
+    // Usually the blocks of one segment are read by one read thread.
+    size_t getInitialConcurrencyHint() const override { return task_pool->getTotalReadTasks(); }
+
+    void retire() override { done = true; }
+
     // only for unit test
     // The logic order of unit test is error, it will build source_op firstly and register rf secondly.
     // It causes source_op could not get RF list in constructor.
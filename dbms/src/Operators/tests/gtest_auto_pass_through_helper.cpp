@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/IAggregateFunction.h>
 #include <AggregateFunctions/registerAggregateFunctions.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/assert_cast.h>
 #include <Core/ColumnWithTypeAndName.h>
 #include <DataTypes/DataTypeDecimal.h>
 #include <DataTypes/DataTypeNullable.h>
@@ -30,6 +33,49 @@ namespace DB
 {
 namespace tests
 {
+namespace
+{
+std::atomic<Int64> live_states{0};
+
+// The state holds memory out of the arena like group_concat, and counts the states that are not destroyed.
+struct OwningData
+{
+    OwningData() { ++live_states; }
+    ~OwningData() { --live_states; }
+
+    std::vector<UInt64> values;
+};
+
+class AggregateFunctionOwningCount final : public IAggregateFunctionDataHelper<OwningData, AggregateFunctionOwningCount>
+{
+public:
+    String getName() const override { return "owning_count"; }
+
+    DataTypePtr getReturnType() const override { return std::make_shared<DataTypeUInt64>(); }
+
+    void add(AggregateDataPtr __restrict place, const IColumn **, size_t row_num, Arena *) const override
+    {
+        data(place).values.push_back(row_num);
+    }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena *) const override
+    {
+        const auto & rhs_values = data(rhs).values;
+        data(place).values.insert(data(place).values.end(), rhs_values.begin(), rhs_values.end());
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict, WriteBuffer &) const override {}
+
+    void deserialize(AggregateDataPtr __restrict, ReadBuffer &, Arena *) const override {}
+
+    void insertResultInto(ConstAggregateDataPtr __restrict place, IColumn & to, Arena *) const override
+    {
+        assert_cast<ColumnUInt64 &>(to).getData().push_back(data(place).values.size());
+    }
+
+    const char * getHeaderFilePath() const override { return __FILE__; }
+};
+} // namespace
 
 class TestAutoPassThroughHelper : public ::testing::Test
 {
@@ -142,5 +188,42 @@ try
 }
 CATCH
 
+TEST_F(TestAutoPassThroughHelper, genericDestroyState)
+try
+{
+    // select owning_count(col_uint8) from t group by col_test;
+    // The function is not handled specially, so the pass through column is generated row by row.
+    auto data_type_uint8 = std::make_shared<DataTypeUInt8>();
+    ColumnsWithTypeAndName child_header{{data_type_uint8, "col_uint8"}};
+    AggregateDescriptions agg_descs{
+        {.function = std::make_shared<AggregateFunctionOwningCount>(),
+         .parameters = {},
+         .arguments = {0},
+         .argument_names = {"col_uint8"},
+         .column_name = "owning_count(col_uint8)"},
+    };
+    Block header{{agg_descs[0].function->getReturnType(), agg_descs[0].column_name}};
+
+    auto generators = setupAutoPassThroughColumnGenerator(
+        header,
+        Block(child_header),
+        agg_descs,
+        Logger::get("gtest AutoPassThroughHashAggHelper"));
+    ASSERT_EQ(generators.size(), 1);
+
+    const size_t block_size = 1024;
+    Block child_block{
+        ColumnGenerator::instance().generate({block_size, data_type_uint8->getName(), RANDOM, "col_uint8"})};
+
+    live_states = 0;
+    auto res_col = generators[0](child_block);
+    ASSERT_EQ(res_col->size(), block_size);
+    for (size_t i = 0; i < block_size; ++i)
+        ASSERT_EQ(res_col->getUInt(i), 1);
+    // Every per row state is destroyed, otherwise the memory it owns leaks.
+    ASSERT_EQ(live_states.load(), 0);
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
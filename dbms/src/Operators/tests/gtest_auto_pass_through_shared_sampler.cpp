@@ -0,0 +1,62 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Operators/AutoPassThroughSharedSampler.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+namespace DB::tests
+{
+TEST(AutoPassThroughSharedSamplerTest, Decision)
+try
+{
+    using Decision = AutoPassThroughSharedSampler::Decision;
+    AutoPassThroughSharedSampler sampler;
+    ASSERT_EQ(sampler.getPreHashAggEpoch(), 0);
+
+    // Low hit rate from one thread
+    ASSERT_EQ(sampler.addSample(1000, 100), Decision::PassThrough);
+    // The other thread sees a higher hit rate, the merged rate is in the middle
+    ASSERT_EQ(sampler.addSample(1000, 900), Decision::Selective);
+    ASSERT_EQ(sampler.getPreHashAggEpoch(), 0);
+
+    // The cardinality drops, the old samples are decayed
+    ASSERT_EQ(sampler.addSample(1000, 1000), Decision::Selective);
+    ASSERT_EQ(sampler.addSample(1000, 1000), Decision::PreHashAgg);
+    ASSERT_EQ(sampler.getPreHashAggEpoch(), 1);
+    ASSERT_EQ(sampler.addSample(1000, 1000), Decision::PreHashAgg);
+    ASSERT_EQ(sampler.getPreHashAggEpoch(), 1);
+
+    // The cardinality grows again
+    ASSERT_EQ(sampler.addSample(10000, 0), Decision::PassThrough);
+    ASSERT_EQ(sampler.addSample(10000, 10000), Decision::Selective);
+    ASSERT_EQ(sampler.addSample(10000, 10000), Decision::Selective);
+    ASSERT_EQ(sampler.addSample(10000, 10000), Decision::PreHashAgg);
+    ASSERT_EQ(sampler.getPreHashAggEpoch(), 2);
+
+    sampler.addPassThroughRows(10);
+    sampler.addAggregatedRows(20);
+    sampler.addSwitchBack();
+    FmtBuffer fmt_buffer;
+    sampler.appendJson(fmt_buffer);
+    auto json = fmt_buffer.toString();
+    ASSERT_NE(json.find(R"("last_decision":"PreHashAgg")"), String::npos) << json;
+    ASSERT_NE(json.find(R"("pre_hashagg_decisions":3)"), String::npos) << json;
+    ASSERT_NE(json.find(R"("switch_back_count":1)"), String::npos) << json;
+    ASSERT_NE(json.find(R"("aggregated_rows":20)"), String::npos) << json;
+    ASSERT_NE(json.find(R"("pass_through_rows":10)"), String::npos) << json;
+}
+CATCH
+
+} // namespace DB::tests
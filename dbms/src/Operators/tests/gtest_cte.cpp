@@ -15,9 +15,13 @@
 #include <Columns/ColumnVector.h>
 #include <DataTypes/DataTypesNumber.h>
 #include <Flash/Mpp/CTEManager.h>
+#include <IO/Encryption/MockKeyManager.h>
+#include <IO/FileProvider/FileProvider.h>
 #include <Operators/CTE.h>
 #include <Operators/CTEPartition.h>
 #include <Operators/CTEReader.h>
+#include <Operators/CTESpillContext.h>
+#include <Poco/File.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <common/types.h>
 #include <gtest/gtest.h>
@@ -327,5 +331,79 @@ try
 }
 CATCH
 
+TEST_F(TestCTE, Spill)
+try
+{
+    String spill_dir = TiFlashTestEnv::getTemporaryPath("cte_spill_test");
+    Poco::File spill_dir_file(spill_dir);
+    if (spill_dir_file.exists())
+        spill_dir_file.remove(true);
+    spill_dir_file.createDirectories();
+    auto file_provider = std::make_shared<FileProvider>(std::make_shared<MockKeyManager>(false), false);
+    SpillConfig spill_config(spill_dir, "cte_spill_test", 0, 0, 0, file_provider);
+
+    String query_id_and_cte_id("pingcap");
+    CTEManager manager;
+    auto cte = manager.getOrCreateCTE(query_id_and_cte_id, PARTITION_NUM, EXPECTED_SINK_NUM, EXPECTED_SOURCE_NUM);
+    cte->initForTest();
+    auto spill_context = std::make_shared<CTESpillContext>(spill_config, 1, Logger::get());
+    ASSERT_TRUE(cte->trySetSpillContext(spill_context));
+    ASSERT_FALSE(cte->trySetSpillContext(std::make_shared<CTESpillContext>(spill_config, 1, Logger::get())));
+
+    std::vector<std::unique_ptr<CTEReader>> readers;
+    for (size_t i = 0; i < EXPECTED_SOURCE_NUM; i++)
+        readers.push_back(std::make_unique<CTEReader>(query_id_and_cte_id, &manager, cte));
+    for (size_t i = 0; i < EXPECTED_SINK_NUM; i++)
+        cte->registerSink();
+
+    const size_t row_num = 1000;
+    Blocks sink_blocks = generateBlocks(0, row_num);
+    const size_t half = sink_blocks.size() / 2;
+    // The first half is spilled before any reader reads it, the second half stays in memory.
+    for (size_t i = 0; i < half; i++)
+        ASSERT_TRUE(cte->pushBlock<true>(i % PARTITION_NUM, sink_blocks[i]));
+    ASSERT_TRUE(cte->needSpill());
+    cte->spillBlocks();
+    ASSERT_FALSE(cte->needSpill());
+    for (size_t i = half; i < sink_blocks.size(); i++)
+        ASSERT_TRUE(cte->pushBlock<true>(i % PARTITION_NUM, sink_blocks[i]));
+    for (size_t i = 0; i < EXPECTED_SINK_NUM; i++)
+        cte->sinkExit<true>();
+    ASSERT_FALSE(spill_context->supportFurtherSpill());
+
+    Block block;
+    for (auto & reader : readers)
+    {
+        std::vector<Int64> received_results;
+        for (size_t i = 0; i < PARTITION_NUM; i++)
+        {
+            while (true)
+            {
+                auto status = reader->fetchNextBlock(i, block);
+                if (status == CTEOpStatus::IO_IN)
+                {
+                    ASSERT_EQ(reader->fetchSpilledBlock(i, block), CTEOpStatus::OK);
+                    if (!block)
+                        continue;
+                }
+                else if (status != CTEOpStatus::OK)
+                {
+                    ASSERT_EQ(status, CTEOpStatus::END_OF_FILE);
+                    break;
+                }
+                const auto * col = static_cast<const ColumnVector<Int32> *>(block.getByPosition(0).column.get());
+                for (size_t j = 0; j < col->size(); j++)
+                    received_results.push_back(col->get64(j));
+            }
+        }
+
+        ASSERT_EQ(received_results.size(), row_num);
+        std::sort(received_results.begin(), received_results.end());
+        for (size_t i = 0; i < row_num; i++)
+            ASSERT_EQ(received_results[i], i);
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
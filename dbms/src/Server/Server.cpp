@@ -543,6 +543,17 @@ void Server::initCaches(bool is_disagg_compute_mode, bool is_disagg_storage_mode
     if (column_cache_long_term_size)
         global_context->setColumnCacheLongTerm(column_cache_long_term_size);
 
+    /// Size of cache for the decompressed packs of DMFile columns, 0 means disabled.
+    size_t column_pack_cache_long_term_size = config().getUInt64("column_pack_cache_long_term_size", 0);
+    if (column_pack_cache_long_term_size)
+        global_context->setColumnPackCacheLongTerm(column_pack_cache_long_term_size);
+
+    /// Size of cache for the results of leaf MPP tasks, 0 means disabled. The compute node does not
+    /// know when the data is changed, so the cache is not available in disaggregated compute mode.
+    size_t mpp_result_cache_size = config().getUInt64("mpp_result_cache_size", 0);
+    if (mpp_result_cache_size && !is_disagg_compute_mode)
+        global_context->setMPPResultCache(mpp_result_cache_size);
+
     /// Size of max memory usage of DeltaIndex, used by DeltaMerge engine.
     /// - In non-disaggregated mode, its default value is 0, means unlimited, and it
     ///   controls the number of total bytes keep in the memory.
@@ -12,12 +12,67 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/countBytesInFilter.h>
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 
+#if __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace DB::DM
 {
 
+namespace
+{
+// The loops below are written without branches so that they can be vectorized by the compiler.
+// Note the values in filter may be any non-zero value for true.
+
+void andFilter(UInt8 * __restrict dst, const UInt8 * __restrict src, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        dst[i] = static_cast<UInt8>(dst[i] != 0) & static_cast<UInt8>(src[i] != 0);
+}
+
+void orFilter(UInt8 * __restrict dst, const UInt8 * __restrict src, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        dst[i] = static_cast<UInt8>((dst[i] | src[i]) != 0);
+}
+
+void andNotFilter(UInt8 * __restrict dst, const UInt8 * __restrict src, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        dst[i] = static_cast<UInt8>(dst[i] != 0) & static_cast<UInt8>(src[i] == 0);
+}
+
+// Returns the first position in [start, end) that `(data[pos] != 0) == value`, or `end` if not found.
+template <bool value>
+size_t findFirst(const UInt8 * data, size_t start, size_t end)
+{
+    size_t pos = start;
+#if __SSE2__
+    constexpr size_t bytes_sse = sizeof(__m128i);
+    const auto zero16 = _mm_setzero_si128();
+    for (; pos + bytes_sse <= end; pos += bytes_sse)
+    {
+        // The i-th bit of mask is set if data[pos + i] is zero
+        const UInt32 mask = _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos)), zero16));
+        const UInt32 matched = value ? (~mask & 0xFFFF) : mask;
+        if (matched != 0)
+            return pos + __builtin_ctz(matched);
+    }
+#endif
+    for (; pos < end; ++pos)
+    {
+        if ((data[pos] != 0) == value)
+            return pos;
+    }
+    return end;
+}
+} // namespace
+
 BitmapFilter::BitmapFilter(UInt32 size_, bool default_value)
     : filter(size_, static_cast<UInt8>(default_value))
     , all_match(default_value)
@@ -82,15 +137,13 @@ void BitmapFilter::set(UInt32 start, UInt32 limit, bool value)
 bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
     RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    auto begin = filter.cbegin() + start;
-    auto end = filter.cbegin() + start + limit;
-    if (all_match || std::find(begin, end, static_cast<UInt8>(false)) == end)
+    if (all_match || findNextUnset(start, start + limit) == start + limit)
     {
         return true;
     }
     else
     {
-        std::copy(begin, end, f.begin());
+        std::copy(filter.cbegin() + start, filter.cbegin() + start + limit, f.begin());
         return false;
     }
 }
@@ -98,10 +151,9 @@ bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 void BitmapFilter::rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
     RUNTIME_CHECK(start + limit <= filter.size() && f.size() == limit);
-    auto begin = filter.cbegin() + start;
     if (!all_match)
     {
-        std::transform(f.begin(), f.end(), begin, f.begin(), [](const auto a, const auto b) { return a && b; });
+        andFilter(f.data(), filter.data() + start, limit);
     }
 }
 
@@ -118,11 +170,7 @@ void BitmapFilter::logicalOr(const BitmapFilter & other)
         all_match = true;
         return;
     }
-    for (UInt32 i = 0; i < filter.size(); ++i)
-    {
-        filter[i] = filter[i] || other.filter[i];
-    }
-    all_match = all_match || other.all_match;
+    orFilter(filter.data(), other.filter.data(), filter.size());
 }
 
 void BitmapFilter::logicalAnd(const BitmapFilter & other)
@@ -136,11 +184,20 @@ void BitmapFilter::logicalAnd(const BitmapFilter & other)
         all_match = other.all_match;
         return;
     }
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    andFilter(filter.data(), other.filter.data(), filter.size());
+}
+
+void BitmapFilter::logicalAndNot(const BitmapFilter & other)
+{
+    RUNTIME_CHECK(filter.size() == other.filter.size());
+    if (other.all_match)
     {
-        filter[i] = filter[i] && other.filter[i];
+        filter.assign(filter.size(), static_cast<UInt8>(false));
+        all_match = false;
+        return;
     }
-    all_match = all_match && other.all_match;
+    andNotFilter(filter.data(), other.filter.data(), filter.size());
+    all_match = false;
 }
 
 void BitmapFilter::append(const BitmapFilter & other)
@@ -156,12 +213,24 @@ bool BitmapFilter::isAllNotMatch(size_t start, size_t limit) const
         return false;
     }
     assert(start + limit <= filter.size());
-    return std::all_of(filter.cbegin() + start, filter.cbegin() + start + limit, [](const auto a) { return !a; });
+    return findNextSet(start, start + limit) == start + limit;
+}
+
+size_t BitmapFilter::findNextSet(size_t start, size_t end) const
+{
+    assert(start <= end && end <= filter.size());
+    return findFirst<true>(filter.data(), start, end);
+}
+
+size_t BitmapFilter::findNextUnset(size_t start, size_t end) const
+{
+    assert(start <= end && end <= filter.size());
+    return findFirst<false>(filter.data(), start, end);
 }
 
 void BitmapFilter::runOptimize()
 {
-    all_match = std::find(filter.begin(), filter.end(), static_cast<UInt8>(false)) == filter.end();
+    all_match = findNextUnset(0, filter.size()) == filter.size();
 }
 
 String BitmapFilter::toDebugString() const
@@ -179,6 +248,6 @@ String BitmapFilter::toDebugString() const
 
 size_t BitmapFilter::count() const
 {
-    return std::count(filter.cbegin(), filter.cend(), static_cast<UInt8>(true));
+    return countBytesInFilter(filter);
 }
 } // namespace DB::DM
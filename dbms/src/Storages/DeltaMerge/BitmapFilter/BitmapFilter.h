@@ -45,11 +45,30 @@ public:
     void logicalOr(const BitmapFilter & other);
     // f = f & other
     void logicalAnd(const BitmapFilter & other);
+    // f = f & ~other
+    void logicalAndNot(const BitmapFilter & other);
     // f = f + other
     void append(const BitmapFilter & other);
     // all_of(filter[start, start+limit), false)
     bool isAllNotMatch(size_t start, size_t limit) const;
 
+    // Returns the first position in [start, end) that filter[pos] is true, or `end` if not found.
+    size_t findNextSet(size_t start, size_t end) const;
+    // Returns the first position in [start, end) that filter[pos] is false, or `end` if not found.
+    size_t findNextUnset(size_t start, size_t end) const;
+    // Call `f(begin, end)` for each continuous range [begin, end) of true in filter[start, start+limit).
+    template <typename F>
+    void forEachSetRange(size_t start, size_t limit, F && f) const
+    {
+        const size_t end = start + limit;
+        for (size_t pos = findNextSet(start, end); pos < end; /**/)
+        {
+            const size_t range_end = findNextUnset(pos, end);
+            f(pos, range_end);
+            pos = findNextSet(range_end, end);
+        }
+    }
+
     void runOptimize();
     void setAllMatch(bool all_match_) { all_match = all_match_; }
     bool isAllMatch() const { return all_match; }
@@ -63,6 +63,22 @@ public:
     // Caller should ensure n in [0, size).
     inline bool get(UInt32 n) const { return filter->get(filter_offset + n); }
 
+    // Call `f(begin, end)` for each continuous range [begin, end) of true in the view.
+    // `begin` and `end` are the positions in the view.
+    template <typename F>
+    void forEachSetRange(F && f) const
+    {
+        filter->forEachSetRange(filter_offset, filter_size, [&](size_t begin, size_t end) {
+            f(begin - filter_offset, end - filter_offset);
+        });
+    }
+
+    // Returns the first position >= n that is true in the view, or `size()` if not found.
+    inline UInt32 findNextSet(UInt32 n) const
+    {
+        return filter->findNextSet(filter_offset + n, filter_offset + filter_size) - filter_offset;
+    }
+
     inline bool operator[](UInt32 n) const { return get(n); }
     inline UInt32 size() const { return filter_size; }
 
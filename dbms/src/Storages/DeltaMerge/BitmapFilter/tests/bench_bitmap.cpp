@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Core/Defines.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <benchmark/benchmark.h>
 
 #include <random>
@@ -155,6 +156,73 @@ static void bitmapGetRangeUInt8(benchmark::State & state)
     bitmapGetRange<UInt8>(state);
 }
 
+DM::BitmapFilter genSparseBitmapFilter(size_t rowid_count)
+{
+    DM::BitmapFilter filter(TEST_BITMAP_SIZE, false);
+    for (auto id : genRandomRowIDs(rowid_count, TEST_BITMAP_SIZE))
+        filter[id] = 1;
+    filter.runOptimize();
+    return filter;
+}
+
+static void bitmapFilterAnd(benchmark::State & state)
+{
+    const auto a = genSparseBitmapFilter(TEST_BITMAP_SIZE / 2);
+    const auto b = genSparseBitmapFilter(TEST_BITMAP_SIZE / 2);
+    for (auto _ : state)
+    {
+        auto c = a;
+        c.logicalAnd(b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+static void bitmapFilterAndNot(benchmark::State & state)
+{
+    const auto a = genSparseBitmapFilter(TEST_BITMAP_SIZE / 2);
+    const auto b = genSparseBitmapFilter(TEST_BITMAP_SIZE / 2);
+    for (auto _ : state)
+    {
+        auto c = a;
+        c.logicalAndNot(b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+static void bitmapFilterCount(benchmark::State & state)
+{
+    const auto a = genSparseBitmapFilter(TEST_BITMAP_SIZE / 2);
+    for (auto _ : state)
+    {
+        auto n = a.count();
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+// Iterate the set rows of a sparse bitmap, the arg is the number of set rows.
+static void bitmapFilterForEachSetRange(benchmark::State & state)
+{
+    const auto a = genSparseBitmapFilter(state.range(0));
+    for (auto _ : state)
+    {
+        size_t rows = 0;
+        a.forEachSetRange(0, a.size(), [&](size_t begin, size_t end) { rows += end - begin; });
+        benchmark::DoNotOptimize(rows);
+    }
+}
+
+static void bitmapFilterForEachSetRow(benchmark::State & state)
+{
+    const auto a = genSparseBitmapFilter(state.range(0));
+    for (auto _ : state)
+    {
+        size_t rows = 0;
+        for (UInt32 i = 0; i < a.size(); ++i)
+            rows += a.get(i);
+        benchmark::DoNotOptimize(rows);
+    }
+}
+
 BENCHMARK(bitmapAndBool);
 BENCHMARK(bitmapAndUInt8);
 BENCHMARK(bitmapSetRowIDBool);
@@ -163,4 +231,9 @@ BENCHMARK(bitmapSetRangeBool);
 BENCHMARK(bitmapSetRangeUInt8);
 BENCHMARK(bitmapGetRangeBool);
 BENCHMARK(bitmapGetRangeUInt8);
+BENCHMARK(bitmapFilterAnd);
+BENCHMARK(bitmapFilterAndNot);
+BENCHMARK(bitmapFilterCount);
+BENCHMARK(bitmapFilterForEachSetRange)->Arg(16)->Arg(1024)->Arg(TEST_BITMAP_SIZE / 2);
+BENCHMARK(bitmapFilterForEachSetRow)->Arg(16)->Arg(1024)->Arg(TEST_BITMAP_SIZE / 2);
 } // namespace DB::bench
@@ -0,0 +1,135 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilterView.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace DB::DM::tests
+{
+
+namespace
+{
+BitmapFilter genRandomFilter(UInt32 size, double set_ratio, std::mt19937 & gen)
+{
+    BitmapFilter filter(size, false);
+    std::bernoulli_distribution dist(set_ratio);
+    for (UInt32 i = 0; i < size; ++i)
+        filter[i] = dist(gen);
+    filter.runOptimize();
+    return filter;
+}
+} // namespace
+
+TEST(BitmapFilterTest, LogicalOps)
+try
+{
+    std::mt19937 gen(42);
+    // Test sizes that are not multiples of the SIMD width
+    for (UInt32 size : {1, 15, 16, 17, 1000, 8193})
+    {
+        auto a = genRandomFilter(size, 0.5, gen);
+        auto b = genRandomFilter(size, 0.5, gen);
+
+        auto and_res = a;
+        and_res.logicalAnd(b);
+        auto or_res = a;
+        or_res.logicalOr(b);
+        auto and_not_res = a;
+        and_not_res.logicalAndNot(b);
+        for (UInt32 i = 0; i < size; ++i)
+        {
+            ASSERT_EQ(and_res.get(i), a.get(i) && b.get(i)) << i;
+            ASSERT_EQ(or_res.get(i), a.get(i) || b.get(i)) << i;
+            ASSERT_EQ(and_not_res.get(i), a.get(i) && !b.get(i)) << i;
+        }
+
+        IColumn::Filter f(size, 1);
+        a.rangeAnd(f, 0, size);
+        for (UInt32 i = 0; i < size; ++i)
+            ASSERT_EQ(f[i], a.get(i)) << i;
+    }
+
+    // All match
+    BitmapFilter all(100, true);
+    auto none = all;
+    none.logicalAndNot(all);
+    ASSERT_FALSE(none.isAllMatch());
+    ASSERT_EQ(none.count(), 0);
+    ASSERT_TRUE(none.isAllNotMatch(0, 100));
+}
+CATCH
+
+TEST(BitmapFilterTest, SetRanges)
+try
+{
+    BitmapFilter filter(100, false);
+    filter.set(3, 5);
+    filter.set(20, 30);
+    filter.set(99, 1);
+    ASSERT_EQ(filter.count(), 36);
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+    filter.forEachSetRange(0, 100, [&](size_t begin, size_t end) { ranges.emplace_back(begin, end); });
+    std::vector<std::pair<size_t, size_t>> expected{{3, 8}, {20, 50}, {99, 100}};
+    ASSERT_EQ(ranges, expected);
+
+    ranges.clear();
+    filter.forEachSetRange(5, 40, [&](size_t begin, size_t end) { ranges.emplace_back(begin, end); });
+    expected = {{5, 8}, {20, 45}};
+    ASSERT_EQ(ranges, expected);
+
+    ASSERT_EQ(filter.findNextSet(0, 100), 3);
+    ASSERT_EQ(filter.findNextSet(8, 100), 20);
+    ASSERT_EQ(filter.findNextSet(50, 99), 99);
+    ASSERT_EQ(filter.findNextUnset(20, 100), 50);
+    ASSERT_TRUE(filter.isAllNotMatch(50, 49));
+    ASSERT_FALSE(filter.isAllNotMatch(50, 50));
+
+    auto view = BitmapFilterView(std::make_shared<BitmapFilter>(filter), 10, 80);
+    ranges.clear();
+    view.forEachSetRange([&](size_t begin, size_t end) { ranges.emplace_back(begin, end); });
+    expected = {{10, 40}};
+    ASSERT_EQ(ranges, expected);
+    ASSERT_EQ(view.findNextSet(0), 10);
+    ASSERT_EQ(view.findNextSet(40), 80);
+}
+CATCH
+
+TEST(BitmapFilterTest, RandomSetRanges)
+try
+{
+    std::mt19937 gen(42);
+    for (double ratio : {0.001, 0.1, 0.5, 0.9, 0.999})
+    {
+        auto filter = genRandomFilter(10000, ratio, gen);
+        BitmapFilter rebuilt(10000, false);
+        size_t last_end = 0;
+        filter.forEachSetRange(0, 10000, [&](size_t begin, size_t end) {
+            ASSERT_LT(begin, end);
+            // The ranges are ordered and not adjacent
+            ASSERT_TRUE(last_end == 0 || last_end < begin);
+            rebuilt.set(begin, end - begin);
+            last_end = end;
+        });
+        rebuilt.runOptimize();
+        ASSERT_EQ(rebuilt, filter);
+    }
+}
+CATCH
+
+} // namespace DB::DM::tests
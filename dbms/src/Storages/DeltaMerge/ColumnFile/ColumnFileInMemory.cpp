@@ -101,12 +101,15 @@ ColumnFile::AppendResult ColumnFileInMemory::append(
         new_alloc_block_bytes += mutable_cache_col->allocatedBytes() - alloc_bytes;
     }
 
+    if (limit > 0)
+        cache->run_ends.push_back(cache->block.rows());
+
     rows += limit;
     bytes += data_bytes;
     return AppendResult{true, new_alloc_block_bytes};
 }
 
-Block ColumnFileInMemory::readDataForFlush() const
+std::pair<Block, std::vector<size_t>> ColumnFileInMemory::readDataForFlush() const
 {
     std::scoped_lock lock(cache->mutex);
 
@@ -114,7 +117,19 @@ Block ColumnFileInMemory::readDataForFlush() const
     MutableColumns columns = cache_block.cloneEmptyColumns();
     for (size_t i = 0; i < cache_block.columns(); ++i)
         columns[i]->insertRangeFrom(*cache_block.getByPosition(i).column, 0, rows);
-    return cache_block.cloneWithColumns(std::move(columns));
+
+    // The cache may be shared with other instances that have appended more rows, only return the runs
+    // within `rows`. A prefix of a sorted run is still sorted.
+    std::vector<size_t> run_ends;
+    for (auto run_end : cache->run_ends)
+    {
+        if (run_end >= rows)
+            break;
+        run_ends.push_back(run_end);
+    }
+    if (rows > 0)
+        run_ends.push_back(rows);
+    return {cache_block.cloneWithColumns(std::move(columns)), std::move(run_ends)};
 }
 
 std::pair<ColumnPtr, ColumnPtr> ColumnFileInMemoryReader::getPKAndVersionColumns()
@@ -37,10 +37,17 @@ class ColumnFileInMemory : public ColumnFile
         {}
         explicit Cache(Block && block)
             : block(std::move(block))
-        {}
+        {
+            if (this->block.rows() > 0)
+                run_ends.push_back(this->block.rows());
+        }
 
         std::mutex mutex;
         Block block;
+        // The end row of each `append`. The written blocks are sorted by <handle, version>, so the rows of each
+        // `append` are likely a sorted run, and the first/last row of a run is its min/max pk. They are only
+        // checked when flushing, to keep the write path cheap.
+        std::vector<size_t> run_ends;
     };
     using CachePtr = std::shared_ptr<Cache>;
 
@@ -105,7 +112,8 @@ public:
         size_t limit,
         size_t data_bytes) override;
 
-    Block readDataForFlush() const;
+    // Return the data to be flushed and the end rows of the runs that are likely sorted, see `Cache::run_ends`.
+    std::pair<Block, std::vector<size_t>> readDataForFlush() const;
 
     bool mayBeFlushedFrom(ColumnFile *) const override { return false; }
 
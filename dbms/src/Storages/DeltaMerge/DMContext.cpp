@@ -62,11 +62,13 @@ DMContext::DMContext(
     , delta_small_column_file_rows(settings.dt_segment_delta_small_column_file_rows)
     , delta_small_column_file_bytes(settings.dt_segment_delta_small_column_file_size)
     , stable_pack_rows(settings.dt_segment_stable_pack_rows)
+    , stable_pack_bytes(settings.dt_segment_stable_pack_bytes)
     , enable_logical_split(settings.dt_enable_logical_split)
     , read_delta_only(settings.dt_read_delta_only)
     , read_stable_only(settings.dt_read_stable_only)
     , enable_relevant_place(settings.dt_enable_relevant_place)
     , enable_skippable_place(settings.dt_enable_skippable_place)
+    , lm_eager_read_selectivity(settings.dt_late_materialization_eager_read_selectivity)
     , tracing_id(tracing_id_)
     , scan_context(scan_context_ ? scan_context_ : std::make_shared<ScanContext>())
 {}
@@ -90,6 +90,8 @@ struct DMContext : private boost::noncopyable
     const size_t delta_small_column_file_bytes;
     // The expected stable pack rows.
     const size_t stable_pack_rows;
+    // The expected stable pack bytes, 0 means the stable pack rows is not adjusted by the row size.
+    const size_t stable_pack_bytes;
 
     // The number of points to check for calculating region split.
     const size_t region_split_check_points = 128;
@@ -99,6 +101,9 @@ struct DMContext : private boost::noncopyable
     const bool read_stable_only;
     const bool enable_relevant_place;
     const bool enable_skippable_place;
+    // Read all columns eagerly instead of late materialization when the observed selectivity
+    // of the pushed down filter is not less than it. 0 means disabled.
+    const Float64 lm_eager_read_selectivity;
 
     String tracing_id;
 
@@ -52,7 +52,12 @@ DeltaIndex::Updates ColumnFileFlushTask::prepare(WriteBatches & wbs)
         if (!context.isVersionChainEnabled())
         {
             IColumn::Permutation perm;
-            task.sorted = sortBlockByPk(getExtraHandleColumnDefine(context.is_common_handle), task.block_data, perm);
+            // Merging the sorted runs is cheaper than sorting the whole block
+            task.sorted = sortBlockByPk(
+                getExtraHandleColumnDefine(context.is_common_handle),
+                task.block_data,
+                task.run_ends,
+                perm);
             if (task.sorted)
                 delta_index_updates.emplace_back(task.deletes_offset, task.rows_offset, perm);
         }
@@ -46,6 +46,8 @@ public:
         ColumnFilePtr column_file;
 
         Block block_data;
+        // The end rows of the runs in `block_data` that are likely sorted by pk
+        std::vector<size_t> run_ends;
         PageIdU64 data_page = 0;
 
         bool sorted = false;
@@ -383,7 +383,7 @@ ColumnFileFlushTaskPtr MemTableSet::buildFlushTask(
             // In this case, let's write the block data in the flush process as well.
             task.rows_offset = cur_rows_offset;
             task.deletes_offset = cur_deletes_offset;
-            task.block_data = m_file->readDataForFlush();
+            std::tie(task.block_data, task.run_ends) = m_file->readDataForFlush();
         }
         cur_rows_offset += column_file->getRows();
         cur_deletes_offset += column_file->getDeletes();
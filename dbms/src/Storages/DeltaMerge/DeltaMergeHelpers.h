@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <Columns/ColumnString.h>
 #include <Columns/ColumnVector.h>
+#include <Common/Exception.h>
 #include <Common/assert_cast.h>
+#include <Common/typeid_cast.h>
 #include <Core/Block.h>
 #include <Core/SortDescription.h>
 #include <DataStreams/IBlockInputStream.h>
@@ -25,6 +28,7 @@
 #include <Storages/ColumnsDescription.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 
+#include <queue>
 #include <utility>
 
 namespace DB
@@ -99,6 +103,118 @@ inline bool sortBlockByPk(const ColumnDefine & handle, Block & block, IColumn::P
     return true;
 }
 
+namespace details
+{
+/// Generate the permutation that k-way merges the runs of rows, the i-th run ends at row `run_ends[i]`.
+/// `less` must order the rows of the same <handle, version> by row id, like the stable sort.
+/// Return false if some run is not sorted actually.
+template <typename Less>
+bool mergeSortedRuns(const std::vector<size_t> & run_ends, Less && less, IColumn::Permutation & perm)
+{
+    size_t run_begin = 0;
+    for (auto run_end : run_ends)
+    {
+        for (size_t row = run_begin + 1; row < run_end; ++row)
+        {
+            if (less(row, row - 1))
+                return false;
+        }
+        run_begin = run_end;
+    }
+
+    // <current row, end row> of each run
+    using RunCursor = std::pair<size_t, size_t>;
+    auto greater = [&](const RunCursor & lhs, const RunCursor & rhs) {
+        return less(rhs.first, lhs.first);
+    };
+    std::priority_queue<RunCursor, std::vector<RunCursor>, decltype(greater)> runs(greater);
+    run_begin = 0;
+    for (auto run_end : run_ends)
+    {
+        if (run_begin < run_end)
+            runs.emplace(run_begin, run_end);
+        run_begin = run_end;
+    }
+
+    perm.resize(run_ends.back());
+    size_t pos = 0;
+    while (!runs.empty())
+    {
+        auto [row, run_end] = runs.top();
+        runs.pop();
+        perm[pos++] = row;
+        if (++row < run_end)
+            runs.emplace(row, run_end);
+    }
+    return true;
+}
+} // namespace details
+
+/// Same as `sortBlockByPk`, but `block` is likely composed of runs that are already sorted by <handle, version>,
+/// the i-th run ends at row `run_ends[i]`. If all runs are sorted, they are k-way merged instead of sorting the
+/// whole block, otherwise the whole block is sorted. The generated permutation is the same as `sortBlockByPk`.
+inline bool sortBlockByPk(
+    const ColumnDefine & handle,
+    Block & block,
+    const std::vector<size_t> & run_ends,
+    IColumn::Permutation & perm)
+{
+    if (run_ends.size() <= 1)
+        return sortBlockByPk(handle, block, perm);
+    RUNTIME_CHECK(run_ends.back() == block.rows(), run_ends.back(), block.rows());
+
+    // Access the columns directly instead of the virtual `IColumn::compareAt`, the comparison is in the hot loop
+    const auto & versions = assert_cast<const ColumnUInt64 &>(*block.getByName(MutSup::version_column_name).column)
+                                .getData();
+    const auto & handle_col = *block.getByName(handle.name).column;
+    bool merged = false;
+    if (const auto * int_handle_col = typeid_cast<const ColumnInt64 *>(&handle_col))
+    {
+        const auto & handles = int_handle_col->getData();
+        merged = details::mergeSortedRuns(
+            run_ends,
+            [&](size_t lhs, size_t rhs) {
+                if (handles[lhs] != handles[rhs])
+                    return handles[lhs] < handles[rhs];
+                if (versions[lhs] != versions[rhs])
+                    return versions[lhs] < versions[rhs];
+                return lhs < rhs;
+            },
+            perm);
+    }
+    else
+    {
+        const auto & str_handle_col = assert_cast<const ColumnString &>(handle_col);
+        merged = details::mergeSortedRuns(
+            run_ends,
+            [&](size_t lhs, size_t rhs) {
+                // Same as `ColumnString::compareAt`, `ColumnString` is final so the calls are not virtual
+                const auto lhs_handle = str_handle_col.getDataAtWithTerminatingZero(lhs);
+                if (auto res = lhs_handle.compare(str_handle_col.getDataAtWithTerminatingZero(rhs)); res != 0)
+                    return res < 0;
+                if (versions[lhs] != versions[rhs])
+                    return versions[lhs] < versions[rhs];
+                return lhs < rhs;
+            },
+            perm);
+    }
+    if (!merged)
+        return sortBlockByPk(handle, block, perm);
+
+    bool already_sorted = true;
+    for (size_t i = 0; i < perm.size() && already_sorted; ++i)
+        already_sorted = perm[i] == i;
+    if (already_sorted)
+        return false;
+
+    for (size_t i = 0; i < block.columns(); ++i)
+    {
+        auto & c = block.getByPosition(i);
+        c.column = c.column->permute(perm, 0);
+    }
+    return true;
+}
+
 template <typename T>
 inline PaddedPODArray<T> const * toColumnVectorDataPtr(const ColumnPtr & column)
 {
@@ -61,6 +61,7 @@
 #include <common/logger_useful.h>
 
 #include <atomic>
+#include <cmath>
 #include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 #include <memory>
@@ -115,6 +116,63 @@ extern const char disable_flush_cache[];
 
 namespace DM
 {
+namespace
+{
+void atomicUpdateMax(std::atomic<UInt64> & target, UInt64 value)
+{
+    auto current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_acq_rel)) {}
+}
+
+/// Each store counts its data version from a distinct base, so that a store re-created with the same
+/// table id never reuses the data versions of the old one.
+UInt64 nextDataVersionBase()
+{
+    static std::atomic<UInt64> store_seq{0};
+    return (store_seq.fetch_add(1, std::memory_order_relaxed) + 1) << 32;
+}
+
+// A queued heavy task gains one more priority for each `HEAVY_TASK_AGING_SECONDS` it waits, so that
+// the tasks of low priority are not starved by the tasks that keep coming.
+constexpr Float64 HEAVY_TASK_AGING_SECONDS = 60;
+// Evaluating the priorities needs to check every queued segment, so do it at most once in this interval
+// when picking. The new tasks are evaluated when they are added.
+constexpr auto HEAVY_TASK_RESCORE_INTERVAL = std::chrono::seconds(1);
+
+// The heavy background tasks of the segments with higher read amplification, more recent reads
+// and higher risk of stalling the writes go first. A split is ranked by how much the segment
+// exceeds the segment size limit, which is what the split fixes.
+Float64 getHeavyTaskPriority(
+    const DMContext & dm_context,
+    DeltaMergeStore::TaskType type,
+    const SegmentPtr & segment)
+{
+    if (type == DeltaMergeStore::TaskType::Split)
+    {
+        const auto segment_bytes = static_cast<Float64>(segment->getEstimatedBytes());
+        return segment_bytes / std::max<size_t>(dm_context.segment_limit_bytes, 1);
+    }
+    const auto delta_rows = static_cast<Float64>(segment->getDelta()->getRows());
+    const auto stable_rows = static_cast<Float64>(segment->getStable()->getRows());
+    // The delta rows need to be merged for each stable row when reading
+    const Float64 read_amplification = delta_rows / std::max(stable_rows, 1.0);
+    const Float64 read_weight = std::log2(2.0 + segment->getReadHeat());
+    // The writes are stalled when delta rows reach `dt_segment_stop_write_delta_rows`
+    const size_t stop_write_delta_rows = dm_context.global_context.getSettingsRef().dt_segment_stop_write_delta_rows;
+    const Float64 write_stall_risk = stop_write_delta_rows == 0 ? 0 : delta_rows / stop_write_delta_rows;
+    return read_amplification * read_weight + write_stall_risk;
+}
+
+Float64 getAgedPriority(
+    Float64 priority,
+    std::chrono::steady_clock::time_point enqueue_time,
+    std::chrono::steady_clock::time_point now)
+{
+    const auto waited_seconds = std::chrono::duration<Float64>(now - enqueue_time).count();
+    return priority + std::max(waited_seconds, 0.0) / HEAVY_TASK_AGING_SECONDS;
+}
+} // namespace
+
 // ================================================
 //   MergeDeltaTaskPool
 // ================================================
@@ -138,7 +196,8 @@ std::pair<bool, bool> DeltaMergeStore::MergeDeltaTaskPool::tryAddTask(
         // reserve some task space for light tasks
         if (max_task_num > 1 && heavy_tasks.size() >= static_cast<size_t>(max_task_num * 0.9))
             return std::make_pair(false, is_heavy);
-        heavy_tasks.push(task);
+        heavy_tasks.push_back(task);
+        heavy_tasks.back().enqueue_time = std::chrono::steady_clock::now();
         break;
     case TaskType::Compact:
     case TaskType::Flush:
@@ -148,7 +207,7 @@ std::pair<bool, bool> DeltaMergeStore::MergeDeltaTaskPool::tryAddTask(
         // reserve some task space for heavy tasks
         if (max_task_num > 1 && light_tasks.size() >= static_cast<size_t>(max_task_num * 0.9))
             return std::make_pair(false, is_heavy);
-        light_tasks.push(task);
+        light_tasks.push_back(task);
         break;
     default:
         throw Exception(fmt::format("Unsupported task type: {}", magic_enum::enum_name(task.type)));
@@ -167,39 +226,86 @@ DeltaMergeStore::BackgroundTask DeltaMergeStore::MergeDeltaTaskPool::nextTask(bo
 {
     std::scoped_lock lock(mutex);
 
-    auto & tasks = is_heavy ? heavy_tasks : light_tasks;
-    if (tasks.empty())
-        return {};
-    auto task = tasks.front();
-    tasks.pop();
+    BackgroundTask task;
+    if (is_heavy)
+    {
+        if (heavy_tasks.empty())
+            return {};
+        // The segments keep changing while the tasks are queued, so evaluate the priorities again when picking
+        const auto now = std::chrono::steady_clock::now();
+        if (now - heavy_tasks_rescore_time >= HEAVY_TASK_RESCORE_INTERVAL)
+        {
+            for (auto & heavy_task : heavy_tasks)
+                heavy_task.priority
+                    = getHeavyTaskPriority(*heavy_task.dm_context, heavy_task.type, heavy_task.segment);
+            heavy_tasks_rescore_time = now;
+        }
+        // `max_element` returns the first one of the highest priority, so it is FIFO for the same priority
+        auto iter = std::max_element(heavy_tasks.begin(), heavy_tasks.end(), [&](const auto & lhs, const auto & rhs) {
+            return getAgedPriority(lhs.priority, lhs.enqueue_time, now)
+                < getAgedPriority(rhs.priority, rhs.enqueue_time, now);
+        });
+        task = std::move(*iter);
+        heavy_tasks.erase(iter);
+    }
+    else
+    {
+        if (light_tasks.empty())
+            return {};
+        task = std::move(light_tasks.front());
+        light_tasks.pop_front();
+    }
 
     LOG_DEBUG(
         log_,
-        "Segment task pop from background task pool, segment={} task={}",
+        "Segment task pop from background task pool, segment={} task={} priority={:.3f}",
         task.segment->simpleInfo(),
-        magic_enum::enum_name(task.type));
+        magic_enum::enum_name(task.type),
+        task.priority);
 
     return task;
 }
 
 std::pair<size_t, size_t> DeltaMergeStore::MergeDeltaTaskPool::clearTasks()
 {
-    size_t num_light_stopped = 0;
-    size_t num_heavy_stopped = 0;
     std::scoped_lock lock(mutex);
-    while (!light_tasks.empty())
-    {
-        num_light_stopped++;
-        light_tasks.pop();
-    }
-    while (!heavy_tasks.empty())
-    {
-        num_heavy_stopped++;
-        heavy_tasks.pop();
-    }
+    size_t num_light_stopped = light_tasks.size();
+    size_t num_heavy_stopped = heavy_tasks.size();
+    light_tasks.clear();
+    heavy_tasks.clear();
     return {num_light_stopped, num_heavy_stopped};
 }
 
+BackgroundTasksStats DeltaMergeStore::MergeDeltaTaskPool::getTasksStats()
+{
+    std::scoped_lock lock(mutex);
+    const auto now = std::chrono::steady_clock::now();
+    BackgroundTasksStats stats;
+    stats.reserve(light_tasks.size() + heavy_tasks.size());
+    auto add_stat = [&stats, now](const BackgroundTask & task, bool is_heavy) {
+        Float64 priority = 0;
+        if (is_heavy)
+        {
+            priority = getAgedPriority(
+                getHeavyTaskPriority(*task.dm_context, task.type, task.segment),
+                task.enqueue_time,
+                now);
+        }
+        stats.emplace_back(BackgroundTaskStats{
+            .type = String(magic_enum::enum_name(task.type)),
+            .is_heavy = is_heavy,
+            .segment_id = task.segment->segmentId(),
+            .segment_epoch = task.segment->segmentEpoch(),
+            .priority = priority,
+        });
+    };
+    for (const auto & task : light_tasks)
+        add_stat(task, false);
+    for (const auto & task : heavy_tasks)
+        add_stat(task, true);
+    return stats;
+}
+
 // ================================================
 //   DeltaMergeStore
 // ================================================
@@ -284,6 +390,8 @@ DeltaMergeStore::DeltaMergeStore(
     }
 
     replica_exist.store(has_replica);
+    track_data_version = global_context.getMPPResultCache() != nullptr;
+    data_version.store(nextDataVersionBase());
     // for mock test, table_id_ should be DB::InvalidTableID
     TableID tbl_id = physical_table_id == DB::InvalidTableID ? TEST_NAMESPACE_ID : physical_table_id;
 
@@ -318,21 +426,18 @@ DeltaMergeStore::DeltaMergeStore(
         if (const auto first_segment_entry = storage_pool->metaReader()->getPageEntry(DELTA_MERGE_FIRST_SEGMENT_ID);
             first_segment_entry.isValid())
         {
-            // Restore all existing segments
-            auto segment_id = DELTA_MERGE_FIRST_SEGMENT_ID;
+            // Restore all existing segments.
+            // Walk the segment chain once, so that every segment meta page is only read once during restore.
+            const auto segment_infos = Segment::readAllSegmentsMetaInfo(*dm_context, DELTA_MERGE_FIRST_SEGMENT_ID);
+            Segments restored_segments(segment_infos.size());
             if (thread_pool)
             {
                 // parallel restore segment to speed up
                 auto wait_group = thread_pool->waitGroup();
-                auto segment_ids = Segment::getAllSegmentIds(*dm_context, segment_id);
-                for (auto & segment_id : segment_ids)
+                for (size_t i = 0; i < segment_infos.size(); ++i)
                 {
-                    auto task = [this, dm_context, segment_id] {
-                        auto segment = Segment::restoreSegment(log, *dm_context, segment_id);
-                        {
-                            std::unique_lock lock(read_write_mutex);
-                            addSegment(lock, segment);
-                        }
+                    auto task = [this, dm_context, &segment_infos, &restored_segments, i] {
+                        restored_segments[i] = Segment::restoreSegment(log, *dm_context, segment_infos[i]);
                     };
                     wait_group->schedule(task);
                 }
@@ -342,16 +447,13 @@ DeltaMergeStore::DeltaMergeStore(
             else
             {
                 // restore segment one by one
-                while (segment_id != 0)
-                {
-                    auto segment = Segment::restoreSegment(log, *dm_context, segment_id);
-                    {
-                        std::unique_lock lock(read_write_mutex);
-                        addSegment(lock, segment);
-                    }
-                    segment_id = segment->nextSegmentId();
-                }
+                for (size_t i = 0; i < segment_infos.size(); ++i)
+                    restored_segments[i] = Segment::restoreSegment(log, *dm_context, segment_infos[i]);
             }
+
+            std::unique_lock lock(read_write_mutex);
+            for (const auto & segment : restored_segments)
+                addSegment(lock, segment);
         }
     }
     catch (...)
@@ -690,6 +792,11 @@ DM::WriteResult DeltaMergeStore::write(
 
     Segments updated_segments;
 
+    const auto & versions = toColumnVectorData<UInt64>(block.getByName(MutSup::version_column_name).column);
+    const auto written_max_version = *std::max_element(versions.begin(), versions.end());
+    beginDataChange();
+    SCOPE_EXIT({ endDataChange(written_max_version); });
+
     size_t offset = 0;
     size_t limit;
     const auto handle_column = block.getByName(MutSup::extra_handle_column_name).column;
@@ -809,6 +916,47 @@ DM::WriteResult DeltaMergeStore::write(
         InputType::RaftLog);
 }
 
+DeltaMergeStore::DataVersion DeltaMergeStore::getDataVersion() const
+{
+    DataVersion res;
+    res.tracked = track_data_version;
+    // Load `data_version` before `data_changing`, so a change that has increased `data_version` before it is
+    // visible is either seen as in progress here, or done before the data is read.
+    res.version = data_version.load();
+    res.changing = data_changing.load() > 0;
+    auto unknown_seq = unknown_version_seq.load(std::memory_order_acquire);
+    auto resolved_seq = resolved_version_seq.load(std::memory_order_acquire);
+    res.unresolved_seq = unknown_seq > resolved_seq ? unknown_seq : 0;
+    res.max_write_version = max_write_version.load(std::memory_order_acquire);
+    return res;
+}
+
+void DeltaMergeStore::resolveMaxWriteVersion(UInt64 unresolved_seq, UInt64 ts)
+{
+    atomicUpdateMax(max_write_version, ts);
+    atomicUpdateMax(resolved_version_seq, unresolved_seq);
+}
+
+void DeltaMergeStore::beginDataChange()
+{
+    if (!track_data_version)
+        return;
+    data_changing.fetch_add(1);
+    data_version.fetch_add(1);
+}
+
+void DeltaMergeStore::endDataChange(std::optional<UInt64> written_max_version)
+{
+    if (!track_data_version)
+        return;
+    if (written_max_version)
+        atomicUpdateMax(max_write_version, *written_max_version);
+    else
+        unknown_version_seq.fetch_add(1, std::memory_order_acq_rel);
+    data_version.fetch_add(1);
+    data_changing.fetch_sub(1);
+}
+
 void DeltaMergeStore::deleteRange(
     const Context & db_context,
     const DB::Settings & db_settings,
@@ -825,6 +973,10 @@ void DeltaMergeStore::deleteRange(
 
     Segments updated_segments;
 
+    beginDataChange();
+    // The deleted rows have no new version.
+    SCOPE_EXIT({ endDataChange(0); });
+
     RowKeyRange cur_range = delete_range;
 
     while (!cur_range.none())
@@ -854,7 +1006,6 @@ void DeltaMergeStore::deleteRange(
         cur_range.setStart(segment_range.end);
         cur_range.setEnd(delete_range.end);
     }
-
     // TODO: Update the tracing_id before checkSegmentUpdate?
     for (auto & segment : updated_segments)
         // We don't handle delete range from raft, the delete range is for dm's purpose only.
@@ -1645,6 +1796,8 @@ bool DeltaMergeStore::checkSegmentUpdate(
 
     if (segment->hasAbandoned())
         return false;
+    if (thread_type == ThreadType::Read)
+        segment->addReadHit();
     const auto & delta = segment->getDelta();
 
     size_t delta_saved_rows = delta->getRows(/* use_unsaved */ false);
@@ -1740,10 +1893,13 @@ bool DeltaMergeStore::checkSegmentUpdate(
         }
     });
 
-    auto try_add_background_task = [&](const BackgroundTask & task) {
+    auto try_add_background_task = [&](BackgroundTask task) {
         if (shutdown_called.load(std::memory_order_relaxed))
             return;
 
+        if (task.type == TaskType::MergeDelta || task.type == TaskType::Split)
+            task.priority = getHeavyTaskPriority(*dm_context, task.type, task.segment);
+
         size_t max_task_num = 0;
         {
             std::shared_lock lock(read_write_mutex); // protect `id_to_segment`
@@ -43,6 +43,7 @@
 #include <Storages/TableNameMeta.h>
 #include <TiDB/Schema/TiDB_fwd.h>
 
+#include <chrono>
 #include <queue>
 
 namespace DB
@@ -158,6 +159,11 @@ public:
         DMContextPtr dm_context;
         SegmentPtr segment;
 
+        // Higher is more urgent. The heavy tasks are picked by priority instead of FIFO.
+        Float64 priority = 0;
+        // When the task is added to the pool, a heavy task gets more urgent as it waits.
+        std::chrono::steady_clock::time_point enqueue_time{};
+
         explicit operator bool() const { return segment != nullptr; }
     };
 
@@ -169,9 +175,13 @@ public:
     public:
 #endif
 
-        using TaskQueue = std::queue<BackgroundTask, std::list<BackgroundTask>>;
+        using TaskQueue = std::list<BackgroundTask>;
+        // The light tasks are picked by FIFO
         TaskQueue light_tasks;
+        // The heavy tasks are picked by the highest priority, FIFO for the same priority
         TaskQueue heavy_tasks;
+        // When the priorities of `heavy_tasks` were evaluated last time
+        std::chrono::steady_clock::time_point heavy_tasks_rescore_time{};
 
         std::mutex mutex;
 
@@ -194,6 +204,8 @@ public:
 
         // num of stopped light_tasks and heavy_tasks
         std::pair<size_t, size_t> clearTasks();
+
+        BackgroundTasksStats getTasksStats();
     };
 
 private:
@@ -466,6 +478,13 @@ public:
      */
     SegmentPtr gcTrySegmentMerge(const DMContextPtr & dm_context, const SegmentPtr & segment);
 
+    /**
+     * Try to merge the segment with its adjacent segments if it is empty.
+     * This function may be blocking, and should be called in the background thread. A failure of merging is logged
+     * and returns nullptr instead of throwing.
+     */
+    SegmentPtr tryMergeEmptySegment(const DMContextPtr & dm_context, const SegmentPtr & segment);
+
     /**
      * Try to merge delta in the current thread as the GC operation.
      * This function may be blocking, and should be called in the GC background thread.
@@ -478,9 +497,11 @@ public:
         DB::Timestamp gc_safe_point);
 
     /**
-     * Starting from the given base segment, find continuous segments that could be merged.
+     * Find continuous segments containing the given base segment that could be merged.
+     * The adjacent segments before and after the base segment are considered, and the continuous segments
+     * that merge the most segments under the size limits and `gc_mergeable_segments_cap` are chosen.
      *
-     * When there are mergeable segments, the baseSegment is returned in index 0 and mergeable segments are then placed in order.
+     * When there are mergeable segments, they are returned in order (by segment start key).
      *   It is ensured that there are at least 2 elements in the returned vector.
      * When there is no mergeable segment, the returned vector will be empty.
      */
@@ -506,6 +527,7 @@ public:
 
     StoreStats getStoreStats();
     SegmentsStats getSegmentsStats();
+    BackgroundTasksStats getBackgroundTasksStats() { return background_tasks.getTasksStats(); }
 
     LocalIndexesStats getLocalIndexStats();
     // Generate local index stats for non inited DeltaMergeStore
@@ -514,6 +536,28 @@ public:
     bool isCommonHandle() const { return is_common_handle; }
     size_t getRowKeyColumnSize() const { return rowkey_column_size; }
 
+    struct DataVersion
+    {
+        /// Increased both before and after the data is changed by write, delete range or ingest.
+        UInt64 version = 0;
+        /// True if some changes are in progress, the data visible to the readers may be changed without
+        /// increasing `version` again until the changes are done.
+        bool changing = false;
+        /// An upper bound of the versions of all the rows in this store, only valid when `unresolved_seq` is 0.
+        UInt64 max_write_version = 0;
+        /// Not 0 if some rows of unknown versions are restored or ingested since the last `resolveMaxWriteVersion`.
+        UInt64 unresolved_seq = 0;
+        /// False if the data version is not maintained, see `track_data_version`.
+        bool tracked = false;
+
+        bool operator==(const DataVersion &) const = default;
+    };
+    /// Used by MPPResultCache to check whether the data visible to a read ts has been changed.
+    DataVersion getDataVersion() const;
+    /// `ts` must be allocated by PD after `unresolved_seq` is returned by `getDataVersion`, so all the rows
+    /// restored or ingested before are committed before `ts`.
+    void resolveMaxWriteVersion(UInt64 unresolved_seq, UInt64 ts);
+
     static ReadMode getReadMode(
         const Context & db_context,
         bool is_fast_scan,
@@ -558,6 +602,12 @@ private:
 
     void waitForDeleteRange(const DMContextPtr & context, const SegmentPtr & segment);
 
+    /// `beginDataChange` should be called before the changed data is visible to the readers, and `endDataChange`
+    /// after that, even if the change fails. `written_max_version` is the max version of the written rows,
+    /// std::nullopt means the versions are unknown.
+    void beginDataChange();
+    void endDataChange(std::optional<UInt64> written_max_version);
+
     void reduceGcMergeableSegmentsCap(std::string_view reason);
     void recoverGcMergeableSegmentsCap(std::string_view reason);
 
@@ -640,6 +690,7 @@ private:
     enum class SegmentMergeReason
     {
         BackgroundGCThread,
+        BackgroundEmptySegment,
     };
 
     /**
@@ -917,6 +968,19 @@ public:
     std::atomic<bool> shutdown_called{false};
     std::atomic<bool> replica_exist{true};
 
+    /// The data version is only used by MPPResultCache, so it is not maintained by the writes if the cache is
+    /// disabled when the store is created. The cache is created before the stores are restored.
+    bool track_data_version = false;
+    /// See `DataVersion`. `max_write_version` and `unknown_version_seq` are updated before `data_version` is
+    /// increased, so a reader that sees the new `data_version` also sees them.
+    std::atomic<UInt64> data_version{0};
+    /// The count of the changes between `beginDataChange` and `endDataChange`.
+    std::atomic<UInt64> data_changing{0};
+    std::atomic<UInt64> max_write_version{0};
+    /// The rows restored from disk are of unknown versions too.
+    std::atomic<UInt64> unknown_version_seq{1};
+    std::atomic<UInt64> resolved_version_seq{0};
+
     BackgroundProcessingPool & background_pool;
     BackgroundProcessingPool::TaskHandle background_task_handle;
 
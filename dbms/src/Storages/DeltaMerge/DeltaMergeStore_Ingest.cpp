@@ -32,6 +32,7 @@
 #include <Storages/PathPool.h>
 #include <common/logger_useful.h>
 
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 
 namespace CurrentMetrics
@@ -801,6 +802,10 @@ UInt64 DeltaMergeStore::ingestFiles(
         ingest_wbs.setRollback(); // rollback if exception thrown
     }
 
+    // The versions of the ingested rows are not tracked, they are resolved lazily by the readers if needed.
+    beginDataChange();
+    SCOPE_EXIT({ endDataChange(std::nullopt); });
+
     Segments updated_segments;
     if (!range.none())
     {
@@ -1318,6 +1323,9 @@ UInt64 DeltaMergeStore::ingestSegmentsFromCheckpointInfo(
         return 0;
     }
 
+    beginDataChange();
+    SCOPE_EXIT({ endDataChange(std::nullopt); });
+
     auto restored_segments = checkpoint_info->getRestoredSegments();
     auto updated_segments = ingestSegmentsUsingSplit(dm_context, range, restored_segments);
 
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Exception.h>
 #include <Common/FailPoint.h>
 #include <Common/SyncPoint/SyncPoint.h>
 #include <Common/TiFlashMetrics.h>
@@ -334,57 +335,91 @@ std::vector<SegmentPtr> DeltaMergeStore::getMergeableSegments(
     const DMContextPtr & context,
     const SegmentPtr & base_segment)
 {
-    // Last segment cannot be merged.
-    if (base_segment->getRowKeyRange().isEndInfinite())
-        return {};
-
     // We only merge small segments into a larger one.
-    // Note: it is possible that there is a very small segment close to a very large segment.
-    // In this case, the small segment will not get merged. It is possible that we can allow
-    // segment merging for this case in future.
     auto max_total_rows = context->segment_limit_rows;
     auto max_total_bytes = context->segment_limit_bytes;
-    const auto max_mergeable_segments = gc_mergeable_segments_cap.load(std::memory_order_relaxed);
+    size_t max_mergeable_segments = gc_mergeable_segments_cap.load(std::memory_order_relaxed);
+#if defined(THREAD_SANITIZER)
+    // Limit the segments to be merged less than 30, or thread sanitizer will fail
+    // https://github.com/pingcap/tiflash/issues/9257
+    max_mergeable_segments = std::min<size_t>(max_mergeable_segments, 31);
+#endif
 
-    std::vector<SegmentPtr> results;
+    // The adjacent segments around `base_segment` that can be merged with it, ordered by the start key.
+    std::vector<SegmentPtr> candidates;
+    size_t base_pos = 0;
     {
         std::shared_lock lock(read_write_mutex);
 
         if (!isSegmentValid(lock, base_segment))
             return {};
 
-        results.reserve(4); // In most cases we will only find <= 4 segments to merge.
-        results.emplace_back(base_segment);
-        auto accumulated_rows = base_segment->getEstimatedRows();
-        auto accumulated_bytes = base_segment->getEstimatedBytes();
+        const auto base_rows = base_segment->getEstimatedRows();
+        const auto base_bytes = base_segment->getEstimatedBytes();
+        auto collect = [&](auto begin, auto end) {
+            std::vector<SegmentPtr> results;
+            auto accumulated_rows = base_rows;
+            auto accumulated_bytes = base_bytes;
+            for (auto it = begin; it != end && results.size() + 1 < max_mergeable_segments; ++it)
+            {
+                const auto & this_seg = it->second;
+                const auto this_rows = this_seg->getEstimatedRows();
+                const auto this_bytes = this_seg->getEstimatedBytes();
+                if (accumulated_rows + this_rows >= max_total_rows || accumulated_bytes + this_bytes >= max_total_bytes)
+                    break;
+                results.emplace_back(this_seg);
+                accumulated_rows += this_rows;
+                accumulated_bytes += this_bytes;
+            }
+            return results;
+        };
+
+        auto next_it = segments.upper_bound(base_segment->getRowKeyRange().getEnd());
+        auto base_it = std::prev(next_it);
+        auto prev_segments = collect(std::make_reverse_iterator(base_it), segments.rend());
+        auto next_segments = collect(next_it, segments.end());
+
+        candidates.reserve(prev_segments.size() + 1 + next_segments.size());
+        candidates.insert(candidates.end(), prev_segments.rbegin(), prev_segments.rend());
+        base_pos = candidates.size();
+        candidates.emplace_back(base_segment);
+        candidates.insert(candidates.end(), next_segments.begin(), next_segments.end());
+    }
 
-        auto it = segments.upper_bound(base_segment->getRowKeyRange().getEnd());
-        while (it != segments.end())
+    // Choose the continuous segments [begin, end) containing `base_segment` under the limits.
+    // Prefer merging more segments to reduce the number of segments, then prefer the one
+    // with less rows to rewrite, then prefer the one starting from `base_segment`.
+    std::vector<size_t> acc_rows(candidates.size() + 1, 0);
+    std::vector<size_t> acc_bytes(candidates.size() + 1, 0);
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        acc_rows[i + 1] = acc_rows[i] + candidates[i]->getEstimatedRows();
+        acc_bytes[i + 1] = acc_bytes[i] + candidates[i]->getEstimatedBytes();
+    }
+    size_t best_begin = base_pos;
+    size_t best_end = base_pos + 1;
+    for (size_t begin = base_pos + 1; begin-- > 0;)
+    {
+        for (size_t end = base_pos + 1; end <= candidates.size() && end - begin <= max_mergeable_segments; ++end)
         {
-            if (results.size() >= max_mergeable_segments)
-                break;
-            const auto & this_seg = it->second;
-            const auto this_rows = this_seg->getEstimatedRows();
-            const auto this_bytes = this_seg->getEstimatedBytes();
-            if (accumulated_rows + this_rows >= max_total_rows || accumulated_bytes + this_bytes >= max_total_bytes)
+            const auto rows = acc_rows[end] - acc_rows[begin];
+            const auto bytes = acc_bytes[end] - acc_bytes[begin];
+            if (end - begin > 1 && (rows >= max_total_rows || bytes >= max_total_bytes))
                 break;
-#if defined(THREAD_SANITIZER)
-            // Limit the segments to be merged less than 30, or thread sanitizer will fail
-            // https://github.com/pingcap/tiflash/issues/9257
-            if (results.size() > 30)
-                break;
-#endif
-            results.emplace_back(this_seg);
-            accumulated_rows += this_rows;
-            accumulated_bytes += this_bytes;
-            it++;
+            const auto best_count = best_end - best_begin;
+            if (end - begin > best_count
+                || (end - begin == best_count && rows < acc_rows[best_end] - acc_rows[best_begin]))
+            {
+                best_begin = begin;
+                best_end = end;
+            }
         }
     }
 
-    if (results.size() < 2)
+    if (best_end - best_begin < 2)
         return {};
 
-    return results;
+    return std::vector<SegmentPtr>(candidates.begin() + best_begin, candidates.begin() + best_end);
 }
 
 void DeltaMergeStore::reduceGcMergeableSegmentsCap(std::string_view reason)
@@ -484,6 +519,13 @@ bool DeltaMergeStore::handleBackgroundTask(bool heavy)
             FAIL_POINT_PAUSE(FailPoints::pause_before_dt_background_delta_merge);
             left = segmentMergeDelta(*task.dm_context, task.segment, MergeDeltaReason::BackgroundThreadPool);
             type = ThreadType::BG_MergeDelta;
+            // The segment becomes empty after the delete ranges are applied, merge it with the adjacent
+            // segments now instead of waiting for the GC thread to reduce the overhead of reading it.
+            if (left)
+            {
+                if (auto merged = tryMergeEmptySegment(task.dm_context, left); merged)
+                    left = merged;
+            }
             // Wake up all waiting threads if failpoint is enabled
             FailPointHelper::disableFailPoint(FailPoints::pause_until_dt_background_delta_merge);
             break;
@@ -824,6 +866,33 @@ SegmentPtr DeltaMergeStore::gcTrySegmentMerge(const DMContextPtr & dm_context, c
     return new_segment;
 }
 
+SegmentPtr DeltaMergeStore::tryMergeEmptySegment(const DMContextPtr & dm_context, const SegmentPtr & segment)
+{
+    if (segment->getEstimatedRows() != 0)
+        return {};
+
+    auto segments_to_merge = getMergeableSegments(dm_context, segment);
+    if (segments_to_merge.size() < 2)
+        return {};
+
+    LOG_INFO(log, "Trigger Merge for empty segment, segment={}", segment->simpleInfo());
+    // The delta merge has already been done and applied, the failure of merging the empty segment
+    // should not make the MergeDelta task fail. The GC thread will try to merge it later.
+    try
+    {
+        return segmentMerge(*dm_context, segments_to_merge, SegmentMergeReason::BackgroundEmptySegment);
+    }
+    catch (...)
+    {
+        LOG_WARNING(
+            log,
+            "Merge empty segment failed, segment={} err={}",
+            segment->simpleInfo(),
+            getCurrentExceptionMessage(false, false));
+        return {};
+    }
+}
+
 SegmentPtr DeltaMergeStore::gcTrySegmentMergeDelta(
     const DMContextPtr & dm_context,
     const SegmentPtr & segment,
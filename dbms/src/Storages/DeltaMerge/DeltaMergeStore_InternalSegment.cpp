@@ -381,6 +381,9 @@ SegmentPtr DeltaMergeStore::segmentMerge(
     case SegmentMergeReason::BackgroundGCThread:
         GET_METRIC(tiflash_storage_subtask_count, type_seg_merge_bg_gc).Increment();
         break;
+    case SegmentMergeReason::BackgroundEmptySegment:
+        GET_METRIC(tiflash_storage_subtask_count, type_seg_merge_bg_empty).Increment();
+        break;
     default:
         break;
     }
@@ -392,6 +395,10 @@ SegmentPtr DeltaMergeStore::segmentMerge(
             GET_METRIC(tiflash_storage_subtask_duration_seconds, type_seg_merge_bg_gc)
                 .Observe(watch_seg_merge.elapsedSeconds());
             break;
+        case SegmentMergeReason::BackgroundEmptySegment:
+            GET_METRIC(tiflash_storage_subtask_duration_seconds, type_seg_merge_bg_empty)
+                .Observe(watch_seg_merge.elapsedSeconds());
+            break;
         default:
             break;
         }
@@ -54,6 +54,17 @@ struct SegmentStats
 };
 using SegmentsStats = std::vector<SegmentStats>;
 
+struct BackgroundTaskStats
+{
+    String type;
+    bool is_heavy = false;
+    UInt64 segment_id = 0;
+    UInt64 segment_epoch = 0;
+    // Higher is more urgent, only used for ordering the heavy tasks
+    Float64 priority = 0;
+};
+using BackgroundTasksStats = std::vector<BackgroundTaskStats>;
+
 struct StoreStats
 {
     UInt64 column_count = 0;
@@ -23,4 +23,8 @@ class ColumnCacheLongTerm;
 
 using ColumnCacheLongTermPtr = std::shared_ptr<ColumnCacheLongTerm>;
 
+class ColumnPackCacheLongTerm;
+
+using ColumnPackCacheLongTermPtr = std::shared_ptr<ColumnPackCacheLongTerm>;
+
 } // namespace DB::DM
@@ -0,0 +1,363 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <Common/HashTable/Hash.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/File/ColumnCacheLongTerm_fwd.h>
+#include <Storages/KVStore/Types.h>
+#include <Storages/Page/PageDefinesBase.h>
+#include <boost/functional/hash.hpp>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace DB::DM
+{
+
+/**
+ * @brief ColumnPackCacheLongTerm caches the decompressed data of DMFile columns at
+ * pack granularity for the lifetime of the process. Unlike ColumnCacheLongTerm, it
+ * is not limited to the PK column, any fixed-width or string column can be cached.
+ *
+ * The cache is a LRU list with TinyLFU admission: the access frequency of packs
+ * are recorded in a count-min sketch, and a new pack is only admitted when it is
+ * accessed more frequently than the packs it would evict. So a single large scan
+ * can not flush the frequently accessed packs out of the cache.
+ *
+ * The cache is split into shards by the hash of the key, each shard has its own
+ * lock, LRU list and sketch, so that concurrent readers do not contend on one lock.
+ * The parent path of DMFile is interned as a `path_id` by `getPathId`, readers get
+ * it once and the keys do not need to copy or compare the path.
+ */
+class ColumnPackCacheLongTerm
+{
+private:
+    struct CacheKey
+    {
+        UInt64 path_id;
+        PageIdU64 dmfile_id;
+        ColumnID column_id;
+        size_t pack_id;
+
+        bool operator==(const CacheKey & other) const = default;
+    };
+
+    struct CacheKeyHasher
+    {
+        std::size_t operator()(const CacheKey & id) const
+        {
+            using boost::hash_combine;
+            using boost::hash_value;
+
+            std::size_t seed = 0;
+            hash_combine(seed, hash_value(id.path_id));
+            hash_combine(seed, hash_value(id.dmfile_id));
+            hash_combine(seed, hash_value(id.column_id));
+            hash_combine(seed, hash_value(id.pack_id));
+            return seed;
+        }
+    };
+
+    /// A count-min sketch with 4 rows of small counters (saturated at 15) for estimating the access
+    /// frequency. All counters are halved after `sample_size` increments so that the old history
+    /// is aged out.
+    class FrequencySketch
+    {
+    public:
+        explicit FrequencySketch(size_t expected_entries)
+        {
+            size_t width = 64;
+            while (width < expected_entries)
+                width <<= 1;
+            mask = width - 1;
+            table.assign(width * DEPTH, 0);
+            sample_size = width * 10;
+        }
+
+        void increment(size_t hash)
+        {
+            bool added = false;
+            for (size_t i = 0; i < DEPTH; ++i)
+            {
+                auto & counter = table[indexOf(hash, i)];
+                if (counter < MAX_COUNT)
+                {
+                    ++counter;
+                    added = true;
+                }
+            }
+            if (added && ++additions >= sample_size)
+                reset();
+        }
+
+        UInt8 frequency(size_t hash) const
+        {
+            UInt8 freq = MAX_COUNT;
+            for (size_t i = 0; i < DEPTH; ++i)
+                freq = std::min(freq, table[indexOf(hash, i)]);
+            return freq;
+        }
+
+    private:
+        static constexpr size_t DEPTH = 4;
+        static constexpr UInt8 MAX_COUNT = 15;
+
+        size_t indexOf(size_t hash, size_t i) const
+        {
+            return i * (mask + 1) + (intHash64(hash + i * 0x9E3779B97F4A7C15ULL) & mask);
+        }
+
+        void reset()
+        {
+            for (auto & counter : table)
+                counter >>= 1;
+            additions /= 2;
+        }
+
+        std::vector<UInt8> table;
+        size_t mask;
+        size_t sample_size;
+        size_t additions = 0;
+    };
+
+    using LRUQueue = std::list<CacheKey>;
+    struct Cell
+    {
+        IColumn::Ptr column;
+        // The time of reading and decompressing the pack from disk
+        UInt64 load_ns;
+        size_t weight;
+        LRUQueue::iterator queue_iter;
+    };
+
+    struct Shard
+    {
+        explicit Shard(size_t max_weight_)
+            : max_weight(max_weight_)
+            , sketch(std::max<size_t>(max_weight_ / AVG_PACK_BYTES_HINT, 1))
+        {}
+
+        // Find the victims from the LRU end, the candidate is admitted only when it is accessed more
+        // frequently than all of them. Returns false if the candidate is rejected.
+        bool findVictims(
+            const CacheKey & key,
+            size_t hash,
+            size_t weight,
+            LRUQueue::iterator & victim_end,
+            size_t & freed_weight)
+        {
+            if (weight > max_weight || cells.contains(key))
+                return false;
+
+            victim_end = queue.begin();
+            freed_weight = 0;
+            const auto candidate_freq = sketch.frequency(hash);
+            while (current_weight - freed_weight + weight > max_weight)
+            {
+                const auto & victim = cells.at(*victim_end);
+                if (sketch.frequency(CacheKeyHasher{}(*victim_end)) >= candidate_freq)
+                {
+                    ++rejected;
+                    return false;
+                }
+                freed_weight += victim.weight;
+                ++victim_end;
+            }
+            return true;
+        }
+
+        const size_t max_weight;
+
+        mutable std::mutex mutex;
+        FrequencySketch sketch;
+        LRUQueue queue;
+        std::unordered_map<CacheKey, Cell, CacheKeyHasher> cells;
+        size_t current_weight = 0;
+
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t rejected = 0;
+    };
+
+public:
+    static constexpr size_t DEFAULT_NUM_SHARDS = 16;
+
+    explicit ColumnPackCacheLongTerm(size_t max_weight_, size_t num_shards = DEFAULT_NUM_SHARDS)
+    {
+        num_shards = std::max<size_t>(num_shards, 1);
+        shards.reserve(num_shards);
+        for (size_t i = 0; i < num_shards; ++i)
+            shards.emplace_back(std::make_unique<Shard>(max_weight_ / num_shards));
+    }
+
+    /// Only the columns of fixed-width types and strings (and the nullable of them) are cached.
+    static bool isCacheableColumn(const DataTypePtr & type)
+    {
+        auto nested_type = removeNullable(type);
+        return nested_type->isValueUnambiguouslyRepresentedInFixedSizeContiguousMemoryRegion()
+            || nested_type->isDecimal() || nested_type->isStringOrFixedString();
+    }
+
+    /// Returns the id of the DMFile parent path used by `get`, `admit` and `set`. The ids are never
+    /// reused, the number of parent paths is bounded by the number of tables.
+    UInt64 getPathId(const String & dmf_parent_path)
+    {
+        std::lock_guard lock(paths_mutex);
+        auto [iter, inserted] = path_ids.try_emplace(dmf_parent_path, path_ids.size());
+        return iter->second;
+    }
+
+    /// Returns <column, load_ns> of the pack, column is nullptr if the pack is not cached.
+    std::pair<IColumn::Ptr, UInt64> get(UInt64 path_id, PageIdU64 dmf_id, ColumnID column_id, size_t pack_id)
+    {
+        const auto key = CacheKey{
+            .path_id = path_id,
+            .dmfile_id = dmf_id,
+            .column_id = column_id,
+            .pack_id = pack_id,
+        };
+        const auto hash = CacheKeyHasher{}(key);
+        auto & shard = shardOf(hash);
+        std::lock_guard lock(shard.mutex);
+        shard.sketch.increment(hash);
+        auto it = shard.cells.find(key);
+        if (it == shard.cells.end())
+        {
+            ++shard.misses;
+            return {nullptr, 0};
+        }
+        ++shard.hits;
+        shard.queue.splice(shard.queue.end(), shard.queue, it->second.queue_iter);
+        return {it->second.column, it->second.load_ns};
+    }
+
+    /// Check whether a pack of about `bytes` would be admitted by `set` now, so that the caller can
+    /// skip materializing a pack that will be rejected anyway. Nothing is evicted.
+    bool admit(UInt64 path_id, PageIdU64 dmf_id, ColumnID column_id, size_t pack_id, size_t bytes)
+    {
+        const auto key = CacheKey{
+            .path_id = path_id,
+            .dmfile_id = dmf_id,
+            .column_id = column_id,
+            .pack_id = pack_id,
+        };
+        const auto hash = CacheKeyHasher{}(key);
+        auto & shard = shardOf(hash);
+        std::lock_guard lock(shard.mutex);
+        LRUQueue::iterator victim_end;
+        size_t freed_weight = 0;
+        return shard.findVictims(key, hash, sizeof(CacheKey) + bytes, victim_end, freed_weight);
+    }
+
+    /// Try to put the pack into the cache. Returns false if the pack is not admitted.
+    bool set(
+        UInt64 path_id,
+        PageIdU64 dmf_id,
+        ColumnID column_id,
+        size_t pack_id,
+        const IColumn::Ptr & column,
+        UInt64 load_ns)
+    {
+        auto key = CacheKey{
+            .path_id = path_id,
+            .dmfile_id = dmf_id,
+            .column_id = column_id,
+            .pack_id = pack_id,
+        };
+        const size_t weight = sizeof(CacheKey) + column->byteSize();
+        const auto hash = CacheKeyHasher{}(key);
+        auto & shard = shardOf(hash);
+
+        std::lock_guard lock(shard.mutex);
+        LRUQueue::iterator victim_end;
+        size_t freed_weight = 0;
+        if (!shard.findVictims(key, hash, weight, victim_end, freed_weight))
+            return false;
+
+        for (auto victim = shard.queue.begin(); victim != victim_end;)
+        {
+            shard.cells.erase(*victim);
+            victim = shard.queue.erase(victim);
+        }
+        shard.current_weight -= freed_weight;
+
+        auto queue_iter = shard.queue.insert(shard.queue.end(), key);
+        shard.cells.emplace(
+            key,
+            Cell{
+                .column = column,
+                .load_ns = load_ns,
+                .weight = weight,
+                .queue_iter = queue_iter,
+            });
+        shard.current_weight += weight;
+        return true;
+    }
+
+    void clear()
+    {
+        for (auto & shard : shards)
+        {
+            std::lock_guard lock(shard->mutex);
+            shard->queue.clear();
+            shard->cells.clear();
+            shard->current_weight = 0;
+        }
+    }
+
+    void getStats(size_t & out_hits, size_t & out_misses, size_t & out_rejected) const
+    {
+        out_hits = 0;
+        out_misses = 0;
+        out_rejected = 0;
+        for (const auto & shard : shards)
+        {
+            std::lock_guard lock(shard->mutex);
+            out_hits += shard->hits;
+            out_misses += shard->misses;
+            out_rejected += shard->rejected;
+        }
+    }
+
+    size_t weight() const
+    {
+        size_t total = 0;
+        for (const auto & shard : shards)
+        {
+            std::lock_guard lock(shard->mutex);
+            total += shard->current_weight;
+        }
+        return total;
+    }
+
+private:
+    // Used to estimate the number of entries for the frequency sketch
+    static constexpr size_t AVG_PACK_BYTES_HINT = 16 * 1024;
+
+    Shard & shardOf(size_t hash) { return *shards[intHash64(hash) % shards.size()]; }
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::mutex paths_mutex;
+    std::unordered_map<String, UInt64> path_ids;
+};
+
+} // namespace DB::DM
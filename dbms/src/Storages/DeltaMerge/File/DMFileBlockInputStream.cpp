@@ -42,7 +42,8 @@ DMFileBlockInputStreamBuilder::DMFileBlockInputStreamBuilder(const Context & con
     setCaches(
         global_context.getMarkCache(),
         global_context.getMinMaxIndexCache(),
-        global_context.getColumnCacheLongTerm());
+        global_context.getColumnCacheLongTerm(),
+        global_context.getColumnPackCacheLongTerm());
     // init from settings
     setFromSettings(context.getSettingsRef());
 }
@@ -113,6 +114,10 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::buildNoLocalIndex(
         scan_context,
         read_tag);
 
+    // Background tasks like compaction read the DMFile only once, do not let them access the cache.
+    if (column_pack_cache_long_term && (read_tag == ReadTag::Query || read_tag == ReadTag::LMFilter))
+        reader.setColumnPackCacheLongTerm(column_pack_cache_long_term);
+
     return std::make_shared<DMFileBlockInputStream>(std::move(reader), max_sharing_column_bytes_for_all > 0);
 }
 
@@ -223,11 +223,13 @@ private:
     DMFileBlockInputStreamBuilder & setCaches(
         const MarkCachePtr & mark_cache_,
         const MinMaxIndexCachePtr & index_cache_,
-        const ColumnCacheLongTermPtr & column_cache_long_term_)
+        const ColumnCacheLongTermPtr & column_cache_long_term_,
+        const ColumnPackCacheLongTermPtr & column_pack_cache_long_term_)
     {
         mark_cache = mark_cache_;
         index_cache = index_cache_;
         column_cache_long_term = column_cache_long_term_;
+        column_pack_cache_long_term = column_pack_cache_long_term_;
         return *this;
     }
 
@@ -267,6 +269,8 @@ private:
     // Note: column_cache_long_term is currently only filled when performing Vector Search.
     ColumnCacheLongTermPtr column_cache_long_term = nullptr;
     ColumnID pk_col_id = 0;
+    // Only used by the reads of queries, see `buildNoLocalIndex`.
+    ColumnPackCacheLongTermPtr column_pack_cache_long_term = nullptr;
 };
 
 /**
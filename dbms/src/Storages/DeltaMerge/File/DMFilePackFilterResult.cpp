@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Stopwatch.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilterView.h>
 #include <Storages/DeltaMerge/File/DMFilePackFilter.h>
 #include <Storages/DeltaMerge/File/DMFilePackFilterResult.h>
 
@@ -46,16 +47,27 @@ std::tuple<UInt64, UInt64, UInt64, UInt64> DMFilePackFilterResult::countPackRes(
 
 size_t DMFilePackFilterResult::modify(const DMFilePtr & dmfile, const BitmapFilterPtr & bitmap_filter, size_t offset)
 {
+    if (bitmap_filter->isAllMatch())
+        return 0;
+
     size_t skipped_pack = 0;
     const auto & pack_stats = dmfile->getPackStats();
+    const size_t end_offset = std::min(bitmap_filter->size(), offset + dmfile->getRows());
+    const BitmapFilterView view(bitmap_filter, offset, end_offset - offset);
+    // The first set row in the view at or after the current pack, the packs before it are all not match.
+    UInt32 next_set = view.findNextSet(0);
+    UInt32 pack_start = 0;
     for (size_t pack_id = 0; pack_id < pack_stats.size(); ++pack_id)
     {
-        if (pack_res[pack_id].isUse() && bitmap_filter->isAllNotMatch(offset, pack_stats[pack_id].rows))
+        const UInt32 pack_end = pack_start + pack_stats[pack_id].rows;
+        if (next_set < pack_start)
+            next_set = view.findNextSet(std::min(pack_start, view.size()));
+        if (pack_res[pack_id].isUse() && next_set >= pack_end)
         {
             pack_res[pack_id] = RSResult::None;
             ++skipped_pack;
         }
-        offset += pack_stats[pack_id].rows;
+        pack_start = pack_end;
     }
     return skipped_pack;
 }
@@ -21,6 +21,7 @@
 #include <DataTypes/IDataType.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/File/ColumnCacheLongTerm.h>
+#include <Storages/DeltaMerge/File/ColumnPackCacheLongTerm.h>
 #include <Storages/DeltaMerge/File/DMFileReader.h>
 #include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/DeltaMerge/convertColumnTypeHelpers.h>
@@ -494,7 +495,9 @@ ColumnPtr DMFileReader::readColumn(const ColumnDefine & cd, size_t start_pack_id
     // Not cached
     if (!enable_column_cache || !isCacheableColumn(cd))
     {
-        auto column = readFromDiskOrSharingCache(cd, type_on_disk, start_pack_id, pack_count, read_rows);
+        auto column = column_pack_cache_long_term && ColumnPackCacheLongTerm::isCacheableColumn(type_on_disk)
+            ? readFromPackCacheOrDisk(cd, type_on_disk, start_pack_id, pack_count, read_rows)
+            : readFromDiskOrSharingCache(cd, type_on_disk, start_pack_id, pack_count, read_rows);
         // Cast column's data from DataType in disk to what we need now
         return convertColumnByColumnDefineIfNeed(type_on_disk, std::move(column), cd);
     }
@@ -624,6 +627,113 @@ ColumnPtr DMFileReader::readFromDiskOrSharingCache(
     return readFromDisk(cd, type_on_disk, start_pack_id, read_rows);
 }
 
+void DMFileReader::setColumnPackCacheLongTerm(ColumnPackCacheLongTermPtr column_pack_cache_long_term_)
+{
+    column_pack_cache_long_term = std::move(column_pack_cache_long_term_);
+    if (column_pack_cache_long_term)
+        pack_cache_path_id = column_pack_cache_long_term->getPathId(dmfile->parentPath());
+}
+
+ColumnPtr DMFileReader::readFromPackCacheOrDisk(
+    const ColumnDefine & cd,
+    const DataTypePtr & type_on_disk,
+    size_t start_pack_id,
+    size_t pack_count,
+    size_t read_rows)
+{
+    const auto & pack_stats = dmfile->getPackStats();
+    const auto file_id = dmfile->fileId();
+
+    std::vector<ColumnPtr> cached_packs(pack_count);
+    size_t hit_packs = 0;
+    UInt64 saved_ns = 0;
+    for (size_t i = 0; i < pack_count; ++i)
+    {
+        auto [column, load_ns]
+            = column_pack_cache_long_term->get(pack_cache_path_id, file_id, cd.id, start_pack_id + i);
+        if (column != nullptr)
+        {
+            cached_packs[i] = std::move(column);
+            ++hit_packs;
+            saved_ns += load_ns;
+        }
+    }
+    if (scan_context)
+    {
+        scan_context->pack_cache_hit_packs += hit_packs;
+        scan_context->pack_cache_miss_packs += pack_count - hit_packs;
+        scan_context->pack_cache_saved_ns += saved_ns;
+    }
+
+    // Read the packs in [run_begin, run_end) from disk, and try to put them into the cache.
+    auto read_and_fill_cache = [&](size_t run_begin, size_t run_end) -> ColumnPtr {
+        size_t run_rows = 0;
+        for (size_t i = run_begin; i < run_end; ++i)
+            run_rows += pack_stats[start_pack_id + i].rows;
+        Stopwatch watch;
+        auto column
+            = readFromDiskOrSharingCache(cd, type_on_disk, start_pack_id + run_begin, run_end - run_begin, run_rows);
+        const UInt64 load_ns_per_pack = watch.elapsed() / (run_end - run_begin);
+
+        // The cached packs are kept for the lifetime of the process, do not track them by the memory tracker
+        // of this query
+        MemoryTrackerSetter mem_tracker_guard(true, nullptr);
+        if (run_end - run_begin == 1)
+        {
+            column_pack_cache_long_term
+                ->set(pack_cache_path_id, file_id, cd.id, start_pack_id + run_begin, column, load_ns_per_pack);
+            return column;
+        }
+        // Check the admission before `cut`, so that the packs of a large scan which will be rejected
+        // by the cache are not copied.
+        const size_t column_bytes = column->byteSize();
+        size_t rows_offset = 0;
+        for (size_t i = run_begin; i < run_end; ++i)
+        {
+            const size_t pack_id = start_pack_id + i;
+            const size_t pack_rows = pack_stats[pack_id].rows;
+            const size_t estimated_bytes = run_rows == 0 ? 0 : column_bytes * pack_rows / run_rows;
+            if (column_pack_cache_long_term->admit(pack_cache_path_id, file_id, cd.id, pack_id, estimated_bytes))
+            {
+                column_pack_cache_long_term->set(
+                    pack_cache_path_id,
+                    file_id,
+                    cd.id,
+                    pack_id,
+                    column->cut(rows_offset, pack_rows),
+                    load_ns_per_pack);
+            }
+            rows_offset += pack_rows;
+        }
+        return column;
+    };
+
+    if (hit_packs == 0)
+        return read_and_fill_cache(0, pack_count);
+    if (hit_packs == 1 && pack_count == 1)
+        return cached_packs[0];
+
+    // Concat the cached packs and the packs read from disk
+    auto column = type_on_disk->createColumn();
+    column->reserve(read_rows);
+    for (size_t i = 0; i < pack_count; /**/)
+    {
+        if (cached_packs[i] != nullptr)
+        {
+            column->insertRangeFrom(*cached_packs[i], 0, cached_packs[i]->size());
+            ++i;
+            continue;
+        }
+        size_t run_end = i + 1;
+        while (run_end < pack_count && cached_packs[run_end] == nullptr)
+            ++run_end;
+        auto run_column = read_and_fill_cache(i, run_end);
+        column->insertRangeFrom(*run_column, 0, run_column->size());
+        i = run_end;
+    }
+    return column;
+}
+
 void DMFileReader::addColumnToCache(
     const ColumnCachePtr & data_cache,
     ColId col_id,
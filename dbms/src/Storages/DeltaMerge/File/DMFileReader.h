@@ -124,6 +124,12 @@ private:
         size_t start_pack_id,
         size_t pack_count,
         size_t read_rows);
+    ColumnPtr readFromPackCacheOrDisk(
+        const ColumnDefine & cd,
+        const DataTypePtr & type_on_disk,
+        size_t start_pack_id,
+        size_t pack_count,
+        size_t read_rows);
     ColumnPtr readColumn(const ColumnDefine & cd, size_t start_pack_id, size_t pack_count, size_t read_rows);
     ColumnPtr cleanRead(
         const ColumnDefine & cd,
@@ -204,9 +210,14 @@ public:
         pk_col_id = pk_col_id_;
     }
 
+    void setColumnPackCacheLongTerm(ColumnPackCacheLongTermPtr column_pack_cache_long_term_);
+
 private:
     ColumnCacheLongTermPtr column_cache_long_term = nullptr;
     ColumnID pk_col_id = 0;
+    ColumnPackCacheLongTermPtr column_pack_cache_long_term = nullptr;
+    // The id of `dmfile->parentPath()` in `column_pack_cache_long_term`
+    UInt64 pack_cache_path_id = 0;
 };
 
 } // namespace DB::DM
@@ -0,0 +1,131 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeFactory.h>
+#include <Storages/DeltaMerge/File/ColumnPackCacheLongTerm.h>
+#include <Storages/DeltaMerge/tests/DMTestEnv.h>
+#include <Storages/DeltaMerge/tests/gtest_segment_util.h>
+#include <gtest/gtest.h>
+
+namespace DB::DM::tests
+{
+
+namespace
+{
+IColumn::Ptr createPack(size_t rows)
+{
+    auto data = genSequence<Int64>(fmt::format("[0, {})", rows));
+    return ::DB::tests::createColumn<Int64>(data, "", 0).column;
+}
+} // namespace
+
+TEST(ColumnPackCacheLongTermTest, GetAndSet)
+try
+{
+    ColumnPackCacheLongTerm cache(1024 * 1024);
+    const auto root = cache.getPathId("/");
+    ASSERT_EQ(root, cache.getPathId("/"));
+    size_t hits = 0, misses = 0, rejected = 0;
+
+    auto [col, load_ns] = cache.get(root, 1, 2, 0);
+    ASSERT_EQ(col, nullptr);
+    ASSERT_TRUE(cache.set(root, 1, 2, 0, createPack(100), 1000));
+    // Already cached
+    ASSERT_FALSE(cache.set(root, 1, 2, 0, createPack(100), 1000));
+
+    std::tie(col, load_ns) = cache.get(root, 1, 2, 0);
+    ASSERT_NE(col, nullptr);
+    ASSERT_EQ(col->size(), 100);
+    ASSERT_EQ(load_ns, 1000);
+
+    // Different pack, column or dmfile
+    ASSERT_EQ(cache.get(root, 1, 2, 1).first, nullptr);
+    ASSERT_EQ(cache.get(root, 1, 3, 0).first, nullptr);
+    ASSERT_EQ(cache.get(root, 2, 2, 0).first, nullptr);
+    ASSERT_EQ(cache.get(cache.getPathId("/a"), 1, 2, 0).first, nullptr);
+
+    cache.getStats(hits, misses, rejected);
+    ASSERT_EQ(hits, 1);
+    ASSERT_EQ(misses, 5);
+    ASSERT_EQ(rejected, 0);
+
+    cache.clear();
+    ASSERT_EQ(cache.weight(), 0);
+    ASSERT_EQ(cache.get(root, 1, 2, 0).first, nullptr);
+}
+CATCH
+
+TEST(ColumnPackCacheLongTermTest, Admission)
+try
+{
+    // Each pack is about 800 bytes, the cache can hold 4 packs. Use one shard so that all packs compete
+    // for the same space.
+    const size_t pack_weight = createPack(100)->byteSize() + 100;
+    ColumnPackCacheLongTerm cache(pack_weight * 4, /*num_shards*/ 1);
+    const auto root = cache.getPathId("/");
+    size_t hits = 0, misses = 0, rejected = 0;
+
+    // The hot packs are accessed frequently
+    for (size_t round = 0; round < 5; ++round)
+    {
+        for (size_t pack_id = 0; pack_id < 4; ++pack_id)
+        {
+            if (cache.get(root, 1, 2, pack_id).first == nullptr)
+                cache.set(root, 1, 2, pack_id, createPack(100), 1000);
+        }
+    }
+    for (size_t pack_id = 0; pack_id < 4; ++pack_id)
+        ASSERT_NE(cache.get(root, 1, 2, pack_id).first, nullptr);
+
+    // A large scan that accesses each pack only once can not flush the hot packs
+    for (size_t pack_id = 100; pack_id < 200; ++pack_id)
+    {
+        ASSERT_EQ(cache.get(root, 1, 2, pack_id).first, nullptr);
+        ASSERT_FALSE(cache.set(root, 1, 2, pack_id, createPack(100), 1000));
+    }
+    // `admit` gives the same decision without evicting anything
+    ASSERT_FALSE(cache.admit(root, 1, 2, 100, createPack(100)->byteSize()));
+    for (size_t pack_id = 0; pack_id < 4; ++pack_id)
+        ASSERT_NE(cache.get(root, 1, 2, pack_id).first, nullptr);
+    cache.getStats(hits, misses, rejected);
+    ASSERT_EQ(rejected, 101);
+
+    // A pack that becomes hotter than the cached ones is admitted
+    for (size_t i = 0; i < 10; ++i)
+        ASSERT_EQ(cache.get(root, 1, 2, 1000).first, nullptr);
+    const auto weight_before_admit = cache.weight();
+    ASSERT_TRUE(cache.admit(root, 1, 2, 1000, createPack(100)->byteSize()));
+    ASSERT_EQ(cache.weight(), weight_before_admit);
+    ASSERT_TRUE(cache.set(root, 1, 2, 1000, createPack(100), 1000));
+    ASSERT_NE(cache.get(root, 1, 2, 1000).first, nullptr);
+    ASSERT_LE(cache.weight(), pack_weight * 4);
+
+    // A pack larger than the cache is never admitted
+    ASSERT_FALSE(cache.set(root, 1, 2, 2000, createPack(1000), 1000));
+}
+CATCH
+
+TEST(ColumnPackCacheLongTermTest, CacheableColumn)
+{
+    const auto & factory = DataTypeFactory::instance();
+    ASSERT_TRUE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("Int64")));
+    ASSERT_TRUE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("Nullable(Float64)")));
+    ASSERT_TRUE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("String")));
+    ASSERT_TRUE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("Nullable(String)")));
+    ASSERT_TRUE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("Decimal(20, 2)")));
+    ASSERT_TRUE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("MyDateTime(3)")));
+    ASSERT_FALSE(ColumnPackCacheLongTerm::isCacheableColumn(factory.get("Array(Float32)")));
+}
+
+} // namespace DB::DM::tests
@@ -21,6 +21,7 @@
 #include <Poco/DirectoryIterator.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/File/ColumnPackCacheLongTerm.h>
 #include <Storages/DeltaMerge/File/DMFileBlockInputStream.h>
 #include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
 #include <Storages/DeltaMerge/File/DMFileWriter.h>
@@ -40,6 +41,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 #include <vector>
 namespace DB
@@ -2038,6 +2040,90 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadWithColumnPackCache)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+
+    const Int64 num_rows_write = 1024;
+    const Int64 nparts = 4;
+    {
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        for (Int64 i = 0; i < nparts; ++i)
+        {
+            Block block = DMTestEnv::prepareSimpleWriteBlock(
+                i * num_rows_write / nparts,
+                (i + 1) * num_rows_write / nparts,
+                false);
+            stream->write(block, block_property);
+        }
+        stream->writeSuffix();
+    }
+
+    auto & global_context = dbContext().getGlobalContext();
+    global_context.dropColumnPackCacheLongTerm();
+    global_context.setColumnPackCacheLongTerm(64 * 1024 * 1024);
+    SCOPE_EXIT({ global_context.dropColumnPackCacheLongTerm(); });
+
+    auto read = [&](ReadTag read_tag,
+                    const IdSetPtr & read_packs,
+                    Int64 first_pk,
+                    Int64 last_pk,
+                    const ScanContextPtr & scan_context) {
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder.setReadTag(read_tag)
+                          .setReadPacks(read_packs)
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, scan_context);
+        ASSERT_INPUTSTREAM_COLS_UR(
+            stream,
+            Strings({DMTestEnv::pk_name}),
+            createColumns({
+                createColumn<Int64>(createNumbers<Int64>(first_pk, last_pk)),
+            }));
+    };
+    const size_t num_cols = cols->size();
+    const Int64 rows_per_pack = num_rows_write / nparts;
+
+    {
+        // Background reads do not access the cache
+        auto scan_context = std::make_shared<ScanContext>();
+        read(ReadTag::Internal, nullptr, 0, num_rows_write, scan_context);
+        ASSERT_EQ(scan_context->pack_cache_hit_packs.load(), 0);
+        ASSERT_EQ(scan_context->pack_cache_miss_packs.load(), 0);
+    }
+    auto middle_packs = std::make_shared<IdSet>(IdSet{1, 2});
+    {
+        // Read the packs 1 and 2, they are read from disk and filled into the cache
+        auto scan_context = std::make_shared<ScanContext>();
+        read(ReadTag::Query, middle_packs, rows_per_pack, 3 * rows_per_pack, scan_context);
+        ASSERT_EQ(scan_context->pack_cache_hit_packs.load(), 0);
+        ASSERT_EQ(scan_context->pack_cache_miss_packs.load(), 2 * num_cols);
+    }
+    {
+        // Read again, all packs are hit
+        auto scan_context = std::make_shared<ScanContext>();
+        read(ReadTag::Query, middle_packs, rows_per_pack, 3 * rows_per_pack, scan_context);
+        ASSERT_EQ(scan_context->pack_cache_hit_packs.load(), 2 * num_cols);
+        ASSERT_EQ(scan_context->pack_cache_miss_packs.load(), 0);
+    }
+    {
+        // Read all packs, the cached packs are concatenated with the packs read from disk
+        auto scan_context = std::make_shared<ScanContext>();
+        read(ReadTag::Query, nullptr, 0, num_rows_write, scan_context);
+        ASSERT_EQ(scan_context->pack_cache_hit_packs.load(), 2 * num_cols);
+        ASSERT_EQ(scan_context->pack_cache_miss_packs.load(), 2 * num_cols);
+    }
+
+    // The cache is only used by the reads of queries
+    size_t hits = 0, misses = 0, rejected = 0;
+    global_context.getColumnPackCacheLongTerm()->getStats(hits, misses, rejected);
+    ASSERT_EQ(hits, 4 * num_cols);
+    ASSERT_EQ(misses, 4 * num_cols);
+}
+CATCH
+
 /// Test reading different column types
 
 TEST_P(DMFileTest, NumberTypes)
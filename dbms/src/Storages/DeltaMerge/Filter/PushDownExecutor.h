@@ -68,6 +68,7 @@ public:
         , fts_query_info(fts_query_info_)
 #endif
         , column_range(column_range_)
+        , filter_digest(before_where ? std::hash<String>{}(before_where->dumpActions()) : 0)
     {}
 
     explicit PushDownExecutor(
@@ -144,6 +145,8 @@ public:
 #endif
     // The column_range contains the column values of the pushed down filters
     const ColumnRangePtr column_range;
+    // Identify the filter expression, used to match the selectivity observed by the former reads of a segment
+    const UInt64 filter_digest = 0;
 };
 
 } // namespace DB::DM
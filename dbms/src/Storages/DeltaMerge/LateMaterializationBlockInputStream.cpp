@@ -15,6 +15,7 @@
 #include <Columns/countBytesInFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/LateMaterializationBlockInputStream.h>
+#include <Storages/DeltaMerge/ScanContext.h>
 
 
 namespace DB::DM
@@ -52,15 +53,30 @@ LateMaterializationBlockInputStream::LateMaterializationBlockInputStream(
     BlockInputStreamPtr filter_column_stream_,
     SkippableBlockInputStreamPtr rest_column_stream_,
     const BitmapFilterPtr & bitmap_filter_,
+    const ScanContextPtr & scan_context_,
+    const FilterStatsReporter & filter_stats_reporter_,
     const String & req_id_)
     : header(toEmptyBlock(columns_to_read))
     , filter_column_name(filter_column_name_)
     , filter_column_stream(std::move(filter_column_stream_))
     , rest_column_stream(std::move(rest_column_stream_))
     , bitmap_filter(bitmap_filter_)
+    , scan_context(scan_context_)
+    , filter_stats_reporter(filter_stats_reporter_)
     , log(Logger::get(NAME, req_id_))
 {}
 
+void LateMaterializationBlockInputStream::reportFilterStats(size_t input_rows, size_t passed_rows)
+{
+    if (scan_context)
+    {
+        scan_context->lm_filter_input_rows += input_rows;
+        scan_context->lm_filter_passed_rows += passed_rows;
+    }
+    if (filter_stats_reporter)
+        filter_stats_reporter(input_rows, passed_rows);
+}
+
 Block LateMaterializationBlockInputStream::read()
 {
     Block filter_column_block;
@@ -79,6 +95,8 @@ Block LateMaterializationBlockInputStream::read()
         // If filter is nullptr, it means that these push down filters are always true.
         if (!filter)
         {
+            reportFilterStats(filter_column_block.rows(), filter_column_block.rows());
+
             IColumn::Filter col_filter;
             col_filter.resize(filter_column_block.rows());
             Block rest_column_block;
@@ -100,6 +118,8 @@ Block LateMaterializationBlockInputStream::read()
         }
 
         size_t rows = filter_column_block.rows();
+        // Count before applying the MVCC-bitmap, so that it is the selectivity of the pushed down filter only
+        reportFilterStats(rows, countBytesInFilter(*filter));
         // bitmap_filter[start_offset, start_offset + rows] & filter -> filter
         bitmap_filter->rangeAnd(*filter, filter_column_block.startOffset(), rows);
 
@@ -17,8 +17,11 @@
 #include <DataStreams/IBlockInputStream.h>
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/ScanContext_fwd.h>
 #include <Storages/DeltaMerge/SkippableBlockInputStream.h>
 
+#include <functional>
+
 namespace DB::DM
 {
 
@@ -33,12 +36,17 @@ class LateMaterializationBlockInputStream : public IBlockInputStream
     static constexpr auto NAME = "LateMaterializationBlockInputStream";
 
 public:
+    // Called with the input rows and passed rows of the pushed down filter for each block
+    using FilterStatsReporter = std::function<void(size_t input_rows, size_t passed_rows)>;
+
     LateMaterializationBlockInputStream(
         const ColumnDefines & columns_to_read,
         const String & filter_column_name_,
         BlockInputStreamPtr filter_column_stream_,
         SkippableBlockInputStreamPtr rest_column_stream_,
         const BitmapFilterPtr & bitmap_filter_,
+        const ScanContextPtr & scan_context_,
+        const FilterStatsReporter & filter_stats_reporter_,
         const String & req_id_);
 
     String getName() const override { return NAME; }
@@ -48,6 +56,8 @@ public:
     Block read() override;
 
 private:
+    void reportFilterStats(size_t input_rows, size_t passed_rows);
+
     Block header;
     // The name of the tmp filter column in filter_column_block which is added by the FilterBlockInputStream.
     // The column is used to filter the block, but it is not included in the returned block.
@@ -58,6 +68,10 @@ private:
     SkippableBlockInputStreamPtr rest_column_stream;
     // The MVCC-bitmap.
     BitmapFilterPtr bitmap_filter;
+    // Record the selectivity of the pushed down filter of the table scan, can be nullptr.
+    ScanContextPtr scan_context;
+    // Record the selectivity of the pushed down filter of the segment, can be empty.
+    FilterStatsReporter filter_stats_reporter;
 
     const LoggerPtr log;
 };
@@ -136,4 +136,18 @@ bool MergedTaskPool::has(UInt64 pool_id)
         return merged_task->containPool(pool_id);
     });
 }
+
+bool MergedTaskPool::tryAttach(const GlobalSegmentID & seg_id, const SegmentReadTaskPoolPtr & pool)
+{
+    std::lock_guard lock(mtx);
+    auto itr = std::find_if(merged_task_pool.begin(), merged_task_pool.end(), [&seg_id](const auto & merged_task) {
+        return std::equal_to<GlobalSegmentID>{}(merged_task->getSegmentId(), seg_id);
+    });
+    if (itr == merged_task_pool.end() || (*itr)->containPool(pool->pool_id))
+        return false;
+
+    // MergedTasks in `merged_task_pool` are not being read by read threads, it is safe to modify them.
+    (*itr)->addUnit(pool, pool->getTask(seg_id));
+    return true;
+}
 } // namespace DB::DM
\ No newline at end of file
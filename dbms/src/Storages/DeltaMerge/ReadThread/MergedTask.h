@@ -102,6 +102,17 @@ public:
         });
     }
 
+    // Attach a new unit to read the same segment together with existing units.
+    // The stream of the unit will be built by read threads, and the decoded data of DMFiles can be shared
+    // with the existing units via the data sharing cache.
+    // Must NOT be called when the MergedTask is being read by read threads.
+    void addUnit(const SegmentReadTaskPoolPtr & pool, const SegmentReadTaskPtr & task)
+    {
+        units.emplace_back(pool, task);
+        passive_merged_segments.fetch_add(1, std::memory_order_relaxed);
+        GET_METRIC(tiflash_storage_read_thread_gauge, type_merged_task_units).Increment();
+    }
+
     void setException(const DB::Exception & e);
 
     String toString() const
@@ -155,12 +166,17 @@ using MergedTaskPtr = std::shared_ptr<MergedTask>;
 // MergedTaskPool is a MergedTask list.
 // When SegmentReadTaskPool's block queue reaching limit, read thread will push MergedTask into it.
 // The scheduler thread will try to pop a MergedTask of a related pool_id before build a new MergedTask object.
+// A late arriving SegmentReadTaskPool can attach its segments to the MergedTasks in it, so that concurrent
+// scans of the same segments are read together.
 class MergedTaskPool
 {
 public:
     MergedTaskPtr pop(uint64_t pool_id);
     void push(const MergedTaskPtr & t);
     bool has(UInt64 pool_id);
+    // Try to attach the segment `seg_id` of `pool` to a MergedTask that is waiting in the pool.
+    // Return true if the segment is attached, and the task has been taken from `pool`.
+    bool tryAttach(const GlobalSegmentID & seg_id, const SegmentReadTaskPoolPtr & pool);
 
 private:
     std::mutex mtx;
@@ -64,9 +64,23 @@ void SegmentReadTaskScheduler::addPool(const SegmentReadTaskPoolPtr & pool)
     assert(pool != nullptr);
     read_pools.emplace(pool->pool_id, pool);
 
-    const auto & tasks = pool->getTasks();
-    for (const auto & [seg_id, task] : tasks)
+    std::vector<GlobalSegmentID> seg_ids;
     {
+        const auto & tasks = pool->getTasks();
+        seg_ids.reserve(tasks.size());
+        for (const auto & [seg_id, task] : tasks)
+            seg_ids.push_back(seg_id);
+    }
+
+    for (const auto & seg_id : seg_ids)
+    {
+        // If the segment is being read by other pools, attach to the scan instead of reading it alone later,
+        // so the decoded data of DMFiles can be shared by the data sharing cache.
+        if (enable_data_sharing && pool->getFreeActiveSegments() > 0 && merged_task_pool.tryAttach(seg_id, pool))
+        {
+            GET_METRIC(tiflash_storage_read_thread_counter, type_sche_attach_task).Increment();
+            continue;
+        }
         merging_segments[seg_id].push_back(pool->pool_id);
     }
 }
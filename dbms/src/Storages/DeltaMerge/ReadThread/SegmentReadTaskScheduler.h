@@ -34,6 +34,7 @@ class SegmentReadTasksPoolTest;
 // - `sched_thread` will scheduling read tasks.
 // - Call path: schedLoop -> schedule -> reapPendingPools -> scheduleOneRound
 // - reapPendingPools will swap the `pending_pools` and add these pools to `read_pools` and `merging_segments`.
+//   Segments that are being read by other pools are attached to the MergedTasks in `merged_task_pool` directly.
 // - scheduleOneRound will scan `read_pools` and choose segments to read.
 class SegmentReadTaskScheduler
 {
@@ -205,6 +205,56 @@ protected:
         }
     }
 
+    void schedulerAttach()
+    {
+        SegmentReadTaskScheduler scheduler{false};
+        scheduler.enable_data_sharing = true;
+
+        auto pool1 = createSegmentReadTaskPool(test_seg_ids);
+        pool1->increaseUnorderedInputStreamRefCount();
+        scheduler.add(pool1);
+        scheduler.reapPendingPools();
+
+        // The MergedTask is waiting in `merged_task_pool`, e.g. because of the block queue of pool1 is full.
+        auto merged_task = scheduler.scheduleMergedTask(pool1);
+        ASSERT_NE(merged_task, nullptr);
+        ASSERT_EQ(merged_task->units.size(), 1);
+        scheduler.pushMergedTask(merged_task);
+        const auto seg_id = merged_task->getSegmentId();
+
+        // The late arriving pool2 attaches to the MergedTask of the same segment.
+        auto pool2 = createSegmentReadTaskPool(test_seg_ids);
+        pool2->increaseUnorderedInputStreamRefCount();
+        scheduler.add(pool2);
+        scheduler.reapPendingPools();
+        ASSERT_EQ(scheduler.read_pools.size(), 2);
+        ASSERT_EQ(merged_task->units.size(), 2);
+        ASSERT_TRUE(merged_task->containPool(pool2->pool_id));
+        ASSERT_EQ(pool2->getPendingSegmentCount(), test_seg_ids.size() - 1);
+        ASSERT_EQ(scheduler.merging_segments.count(seg_id), 0);
+        ASSERT_EQ(scheduler.merging_segments.size(), test_seg_ids.size() - 1);
+        for (const auto & [id, pool_ids] : scheduler.merging_segments)
+            ASSERT_EQ(pool_ids.size(), 2);
+
+        // pool2 gets the attached MergedTask from `merged_task_pool`.
+        ASSERT_TRUE(scheduler.needScheduleToRead(pool2));
+        ASSERT_EQ(scheduler.scheduleMergedTask(pool2), merged_task);
+
+        // Do not attach if data sharing is disabled.
+        scheduler.pushMergedTask(merged_task);
+        scheduler.enable_data_sharing = false;
+        auto pool3 = createSegmentReadTaskPool(test_seg_ids);
+        pool3->increaseUnorderedInputStreamRefCount();
+        scheduler.add(pool3);
+        scheduler.reapPendingPools();
+        ASSERT_EQ(merged_task->units.size(), 2);
+        ASSERT_EQ(pool3->getPendingSegmentCount(), test_seg_ids.size());
+        ASSERT_EQ(scheduler.merging_segments[seg_id].size(), 1);
+
+        for (auto & pool : {pool1, pool2, pool3})
+            pool->decreaseUnorderedInputStreamRefCount();
+    }
+
     inline static const std::vector<PageIdU64> test_seg_ids{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
 };
 
@@ -276,4 +326,11 @@ try
 }
 CATCH
 
+TEST_F(SegmentReadTasksPoolTest, SchedulerAttach)
+try
+{
+    schedulerAttach();
+}
+CATCH
+
 } // namespace DB::DM::tests
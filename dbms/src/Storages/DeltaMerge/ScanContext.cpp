@@ -160,6 +160,20 @@ String ScanContext::toJson() const
     json->set("mvcc_input_bytes", mvcc_input_bytes.load());
     json->set("mvcc_skip_rows", mvcc_input_rows.load() - mvcc_output_rows.load());
 
+    if (lm_filter_input_rows.load() > 0 || lm_eager_read_segments.load() > 0)
+    {
+        json->set("lm_filter_input_rows", lm_filter_input_rows.load());
+        json->set("lm_filter_passed_rows", lm_filter_passed_rows.load());
+        json->set("lm_eager_read_segments", lm_eager_read_segments.load());
+    }
+
+    if (pack_cache_hit_packs.load() > 0 || pack_cache_miss_packs.load() > 0)
+    {
+        json->set("pack_cache_hit_packs", pack_cache_hit_packs.load());
+        json->set("pack_cache_miss_packs", pack_cache_miss_packs.load());
+        json->set("pack_cache_saved_time", fmt::format("{:.3f}ms", pack_cache_saved_ns.load() / NS_TO_MS_SCALE));
+    }
+
     json->set("learner_read_time", fmt::format("{:.3f}ms", learner_read_ns.load() / NS_TO_MS_SCALE));
     json->set("create_snapshot_time", fmt::format("{:.3f}ms", create_snapshot_time_ns.load() / NS_TO_MS_SCALE));
     json->set("build_stream_time", fmt::format("{:.3f}ms", build_inputstream_time_ns.load() / NS_TO_MS_SCALE));
@@ -101,6 +101,19 @@ public:
     std::atomic<uint64_t> mvcc_input_bytes{0};
     std::atomic<uint64_t> mvcc_output_rows{0};
 
+    // The input rows and passed rows of the pushed down filter in late materialization. Whether to read a
+    // segment eagerly is decided by the selectivity observed on the segment, see `Segment::shouldReadEagerly`
+    std::atomic<uint64_t> lm_filter_input_rows{0};
+    std::atomic<uint64_t> lm_filter_passed_rows{0};
+    // The number of segments that read all columns eagerly instead of late materialization
+    std::atomic<uint64_t> lm_eager_read_segments{0};
+
+    // ColumnPackCacheLongTerm
+    std::atomic<uint64_t> pack_cache_hit_packs{0};
+    std::atomic<uint64_t> pack_cache_miss_packs{0};
+    // The time of reading and decompressing the hit packs when they were filled into the cache
+    std::atomic<uint64_t> pack_cache_saved_ns{0};
+
     // Learner read
     std::atomic<uint64_t> learner_read_ns{0};
     // Create snapshot from PageStorage
@@ -389,6 +402,14 @@ public:
         mvcc_input_bytes += other.mvcc_input_bytes;
         mvcc_output_rows += other.mvcc_output_rows;
 
+        lm_filter_input_rows += other.lm_filter_input_rows;
+        lm_filter_passed_rows += other.lm_filter_passed_rows;
+        lm_eager_read_segments += other.lm_eager_read_segments;
+
+        pack_cache_hit_packs += other.pack_cache_hit_packs;
+        pack_cache_miss_packs += other.pack_cache_miss_packs;
+        pack_cache_saved_ns += other.pack_cache_saved_ns;
+
         learner_read_ns += other.learner_read_ns;
         create_snapshot_time_ns += other.create_snapshot_time_ns;
         build_inputstream_time_ns += other.build_inputstream_time_ns;
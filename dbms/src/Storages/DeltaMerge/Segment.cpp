@@ -75,6 +75,7 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <cmath>
 #include <ext/scope_guard.h>
 #include <memory>
 
@@ -166,6 +167,27 @@ String SegmentSnapshot::detailInfo() const
 
 const static size_t SEGMENT_BUFFER_SIZE = 128; // More than enough.
 
+namespace
+{
+// The expected rows of the stable packs written from the segment snapshot. When `stable_pack_bytes`
+// is set, segments with wide rows get smaller packs and segments with narrow rows get larger packs.
+// Rows with the same pk are still squashed into one pack by `PKSquashingBlockInputStream`.
+size_t getStablePackRows(const DMContext & dm_context, const SegmentSnapshotPtr & segment_snap)
+{
+    const size_t pack_rows = dm_context.stable_pack_rows;
+    const auto rows = segment_snap->getRows();
+    const auto bytes = segment_snap->getBytes();
+    if (dm_context.stable_pack_bytes == 0 || rows == 0 || bytes == 0)
+        return pack_rows;
+
+    const size_t avg_row_bytes = std::max<size_t>(bytes / rows, 1);
+    return std::clamp(
+        dm_context.stable_pack_bytes / avg_row_bytes,
+        std::max<size_t>(pack_rows / 4, 1),
+        pack_rows * 4);
+}
+} // namespace
+
 DMFilePtr writeIntoNewDMFile(
     DMContext & dm_context, //
     const ColumnDefinesPtr & schema_snap,
@@ -413,21 +435,29 @@ void readSegmentMetaInfo(ReadBuffer & buf, Segment::SegmentMetaInfo & segment_in
     }
 }
 
-std::vector<PageIdU64> Segment::getAllSegmentIds(const DMContext & context, PageIdU64 segment_id)
+Segment::SegmentMetaInfos Segment::readAllSegmentsMetaInfo(const DMContext & context, PageIdU64 segment_id)
 {
-    std::vector<PageIdU64> segment_ids = {};
+    SegmentMetaInfos segment_infos;
     PageIdU64 current_segment_id = segment_id;
     while (current_segment_id != 0)
     {
-        segment_ids.push_back(current_segment_id);
-        Page page = context.storage_pool->metaReader()->read(current_segment_id); // not limit restore
-
-        ReadBufferFromMemory buf(page.data.begin(), page.data.size());
         Segment::SegmentMetaInfo segment_info;
-        readSegmentMetaInfo(buf, segment_info);
+        try
+        {
+            Page page = context.storage_pool->metaReader()->read(current_segment_id); // not limit restore
+            ReadBufferFromMemory buf(page.data.begin(), page.data.size());
+            readSegmentMetaInfo(buf, segment_info);
+        }
+        catch (DB::Exception & e)
+        {
+            e.addMessage(fmt::format("while readAllSegmentsMetaInfo, segment_id={}", current_segment_id));
+            e.rethrow();
+        }
+        segment_info.segment_id = current_segment_id;
         current_segment_id = segment_info.next_segment_id;
+        segment_infos.emplace_back(std::move(segment_info));
     }
-    return segment_ids;
+    return segment_infos;
 }
 
 SegmentPtr Segment::restoreSegment( //
@@ -442,14 +472,30 @@ SegmentPtr Segment::restoreSegment( //
 
         ReadBufferFromMemory buf(page.data.begin(), page.data.size());
         readSegmentMetaInfo(buf, segment_info);
+    }
+    catch (DB::Exception & e)
+    {
+        e.addMessage(fmt::format("while restoreSegment, segment_id={} ident={}", segment_id, parent_log->identifier()));
+        e.rethrow();
+    }
+    segment_info.segment_id = segment_id;
+    return restoreSegment(parent_log, context, segment_info);
+}
 
+SegmentPtr Segment::restoreSegment( //
+    const LoggerPtr & parent_log,
+    DMContext & context,
+    const SegmentMetaInfo & segment_info)
+{
+    try
+    {
         auto delta = DeltaValueSpace::restore(context, segment_info.range, segment_info.delta_id);
         auto stable = StableValueSpace::restore(context, segment_info.stable_id);
         auto segment = std::make_shared<Segment>(
             parent_log,
             segment_info.epoch,
             segment_info.range,
-            segment_id,
+            segment_info.segment_id,
             segment_info.next_segment_id,
             delta,
             stable);
@@ -458,7 +504,10 @@ SegmentPtr Segment::restoreSegment( //
     }
     catch (DB::Exception & e)
     {
-        e.addMessage(fmt::format("while restoreSegment, segment_id={} ident={}", segment_id, parent_log->identifier()));
+        e.addMessage(fmt::format(
+            "while restoreSegment, segment_id={} ident={}",
+            segment_info.segment_id,
+            parent_log->identifier()));
         e.rethrow();
     }
     RUNTIME_CHECK_MSG(false, "unreachable");
@@ -1354,7 +1403,7 @@ StableValueSpacePtr Segment::prepareMergeDelta(
         *schema_snap,
         segment_snap,
         rowkey_range,
-        dm_context.stable_pack_rows,
+        getStablePackRows(dm_context, segment_snap),
         /*reorganize_block*/ true);
 
     auto new_stable = createNewStable(dm_context, schema_snap, data_stream, segment_snap->stable->getId(), wbs);
@@ -1534,6 +1583,9 @@ SegmentPtr Segment::replaceStableMetaVersion(
         next_segment_id,
         delta, // Delta is untouched. Shares the same delta instance.
         new_stable);
+    // Only the meta version of the stable is changed, the data of both delta and stable are untouched,
+    // so the version chain can be inherited instead of replaying all delta from scratch.
+    new_me->setVersionChain(version_chain);
     new_me->serialize(wbs.meta);
 
     wbs.writeAll();
@@ -2103,7 +2155,7 @@ std::optional<Segment::SplitInfo> Segment::prepareSplitPhysical( //
             my_delta_reader,
             read_info.index_begin,
             read_info.index_end,
-            dm_context.stable_pack_rows,
+            getStablePackRows(dm_context, segment_snap),
             ReadTag::Internal);
 
 
@@ -2134,7 +2186,7 @@ std::optional<Segment::SplitInfo> Segment::prepareSplitPhysical( //
             other_delta_reader,
             read_info.index_begin,
             read_info.index_end,
-            dm_context.stable_pack_rows,
+            getStablePackRows(dm_context, segment_snap),
             ReadTag::Internal);
 
         other_data = std::make_shared<DMRowKeyFilterBlockInputStream<true>>(other_data, other_ranges, 0);
@@ -2335,7 +2387,7 @@ StableValueSpacePtr Segment::prepareMerge(
             read_info.getDeltaReader(ReadTag::Internal),
             read_info.index_begin,
             read_info.index_end,
-            dm_context.stable_pack_rows,
+            getStablePackRows(dm_context, segment_snap),
             ReadTag::Internal);
 
         stream = std::make_shared<DMRowKeyFilterBlockInputStream<true>>(stream, rowkey_ranges, 0);
@@ -3591,25 +3643,38 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(
     size_t expected_block_size)
 {
     const auto & filter_columns = executor->filter_columns;
-    BlockInputStreamPtr filter_column_stream = getConcatSkippableBlockInputStream(
-        segment_snap,
-        dm_context,
-        *filter_columns,
-        data_ranges,
-        pack_filter_results,
-        start_ts,
-        expected_block_size,
-        ReadTag::LMFilter);
 
-    if (unlikely(filter_columns->size() == columns_to_read.size()))
+    // Late materialization brings extra overhead when the pushed down filter can hardly filter out any rows.
+    // If it is observed by the former reads of this segment with the same filter, read all columns eagerly and
+    // then filter them. The extra cast is only built for the filter columns, so eager read is not used with it.
+    const auto & scan_context = dm_context.scan_context;
+    const bool eager_read = dm_context.lm_eager_read_selectivity > 0 && !executor->extra_cast
+        && shouldReadEagerly(executor->filter_digest, dm_context.lm_eager_read_selectivity);
+
+    if (unlikely(filter_columns->size() == columns_to_read.size()) || eager_read)
     {
-        LOG_ERROR(
-            segment_snap->log,
-            "Late materialization filter columns size equal to read columns size, which is not expected, "
-            "filter_columns_size={}",
-            filter_columns->size());
-        BlockInputStreamPtr stream
-            = std::make_shared<BitmapFilterBlockInputStream>(*filter_columns, filter_column_stream, bitmap_filter);
+        if (eager_read)
+        {
+            scan_context->lm_eager_read_segments += 1;
+        }
+        else
+        {
+            LOG_ERROR(
+                segment_snap->log,
+                "Late materialization filter columns size equal to read columns size, which is not expected, "
+                "filter_columns_size={}",
+                filter_columns->size());
+        }
+        BlockInputStreamPtr stream = getConcatSkippableBlockInputStream(
+            segment_snap,
+            dm_context,
+            columns_to_read,
+            data_ranges,
+            pack_filter_results,
+            start_ts,
+            expected_block_size,
+            eager_read ? ReadTag::Query : ReadTag::LMFilter);
+        stream = std::make_shared<BitmapFilterBlockInputStream>(columns_to_read, stream, bitmap_filter);
         if (executor->extra_cast)
         {
             stream = std::make_shared<ExpressionBlockInputStream>(stream, executor->extra_cast, dm_context.tracing_id);
@@ -3629,6 +3694,16 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(
         return stream;
     }
 
+    BlockInputStreamPtr filter_column_stream = getConcatSkippableBlockInputStream(
+        segment_snap,
+        dm_context,
+        *filter_columns,
+        data_ranges,
+        pack_filter_results,
+        start_ts,
+        expected_block_size,
+        ReadTag::LMFilter);
+
     // construct extra cast stream if needed
     if (executor->extra_cast)
     {
@@ -3670,6 +3745,13 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(
         expected_block_size,
         ReadTag::Query);
 
+    auto report_filter_stats = [weak_segment = weak_from_this(), filter_digest = executor->filter_digest](
+                                   size_t input_rows,
+                                   size_t passed_rows) {
+        if (auto segment = weak_segment.lock(); segment)
+            segment->addLateMaterializationFilterStats(filter_digest, input_rows, passed_rows);
+    };
+
     // construct late materialization stream
     return std::make_shared<LateMaterializationBlockInputStream>(
         columns_to_read,
@@ -3677,6 +3759,8 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(
         filter_column_stream,
         rest_column_stream,
         bitmap_filter,
+        scan_context,
+        report_filter_stats,
         dm_context.tracing_id);
 }
 
@@ -3897,5 +3981,57 @@ size_t Segment::clipBlockRows(
     }
 }
 
+namespace
+{
+Float64 decayReadHeat(
+    Float64 read_heat,
+    std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to)
+{
+    if (read_heat == 0 || to <= from)
+        return read_heat;
+    const auto seconds = std::chrono::duration<Float64>(to - from).count();
+    return read_heat * std::exp2(-seconds / Segment::READ_HEAT_HALF_LIFE_SECONDS);
+}
+} // namespace
+
+Float64 Segment::getReadHeat(std::chrono::steady_clock::time_point now) const
+{
+    std::scoped_lock lock(read_heat_mutex);
+    return decayReadHeat(read_heat, read_heat_update_time, now);
+}
+
+void Segment::addReadHit(std::chrono::steady_clock::time_point now)
+{
+    std::scoped_lock lock(read_heat_mutex);
+    read_heat = decayReadHeat(read_heat, read_heat_update_time, now) + 1;
+    read_heat_update_time = std::max(read_heat_update_time, now);
+}
+
+void Segment::addLateMaterializationFilterStats(UInt64 filter_digest, size_t input_rows, size_t passed_rows)
+{
+    std::scoped_lock lock(lm_filter_stats_mutex);
+    if (lm_filter_stats.filter_digest != filter_digest)
+        lm_filter_stats = LateMaterializationFilterStats{.filter_digest = filter_digest};
+    lm_filter_stats.input_rows += input_rows;
+    lm_filter_stats.passed_rows += passed_rows;
+}
+
+bool Segment::shouldReadEagerly(UInt64 filter_digest, Float64 eager_read_selectivity)
+{
+    std::scoped_lock lock(lm_filter_stats_mutex);
+    // Make sure there are enough rows to estimate the selectivity
+    if (lm_filter_stats.filter_digest != filter_digest || lm_filter_stats.input_rows < DEFAULT_MERGE_BLOCK_SIZE
+        || lm_filter_stats.passed_rows < lm_filter_stats.input_rows * eager_read_selectivity)
+        return false;
+    if (++lm_filter_stats.eager_reads % LM_EAGER_READ_PROBE_INTERVAL == 0)
+    {
+        // The data may have been changed by the writes, observe the selectivity again by late materialization
+        lm_filter_stats = LateMaterializationFilterStats{.filter_digest = filter_digest};
+        return false;
+    }
+    return true;
+}
+
 } // namespace DM
 } // namespace DB
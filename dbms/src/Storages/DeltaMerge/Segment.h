@@ -159,7 +159,6 @@ public:
         PageIdU64 next_segment_id);
 
     static SegmentPtr restoreSegment(const LoggerPtr & parent_log, DMContext & context, PageIdU64 segment_id);
-    static std::vector<PageIdU64> getAllSegmentIds(const DMContext & context, PageIdU64 segment_id);
 
     struct SegmentMetaInfo
     {
@@ -186,6 +185,16 @@ public:
     };
 
     using SegmentMetaInfos = std::vector<SegmentMetaInfo>;
+
+    // Restore the segment from the meta info that has already been read, the meta page is not read again.
+    static SegmentPtr restoreSegment(
+        const LoggerPtr & parent_log,
+        DMContext & context,
+        const SegmentMetaInfo & segment_info);
+    // Walk the segment chain starting from `segment_id` and return the meta info of all segments in order.
+    // Each segment meta page is read exactly once.
+    static SegmentMetaInfos readAllSegmentsMetaInfo(const DMContext & context, PageIdU64 segment_id);
+
     static SegmentMetaInfos readAllSegmentsMetaInfoInRange( //
         DMContext & context,
         const std::shared_ptr<GeneralCancelHandle> & cancel_handle,
@@ -635,6 +644,21 @@ public:
         last_check_gc_safe_point.store(gc_safe_point, std::memory_order_relaxed);
     }
 
+    // The read heat is the number of reads of this segment, halved every `READ_HEAT_HALF_LIFE_SECONDS`
+    // so that only the recent reads matter. Used to prioritize background tasks.
+    static constexpr Float64 READ_HEAT_HALF_LIFE_SECONDS = 60.0;
+    Float64 getReadHeat(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+    void addReadHit(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    // Record the selectivity of the pushed down filter observed by late materialization on this segment.
+    // Only the stats of the latest filter, identified by `PushDownExecutor::filter_digest`, are kept.
+    void addLateMaterializationFilterStats(UInt64 filter_digest, size_t input_rows, size_t passed_rows);
+    // Whether to read this segment eagerly instead of late materialization, because the selectivity of the
+    // filter observed on this segment is not less than `eager_read_selectivity`. Every
+    // `LM_EAGER_READ_PROBE_INTERVAL` eager reads, it returns false to observe the selectivity again.
+    static constexpr size_t LM_EAGER_READ_PROBE_INTERVAL = 16;
+    bool shouldReadEagerly(UInt64 filter_digest, Float64 eager_read_selectivity);
+
     void setIndexBuildError(const std::vector<IndexID> & index_ids, const String & err_msg)
     {
         std::scoped_lock lock(mtx_local_index_message);
@@ -858,6 +882,19 @@ public:
     const PageIdU64 next_segment_id;
 
     std::atomic<DB::Timestamp> last_check_gc_safe_point = 0;
+    mutable std::mutex read_heat_mutex;
+    Float64 read_heat = 0;
+    std::chrono::steady_clock::time_point read_heat_update_time;
+
+    struct LateMaterializationFilterStats
+    {
+        UInt64 filter_digest = 0;
+        size_t input_rows = 0;
+        size_t passed_rows = 0;
+        size_t eager_reads = 0;
+    };
+    std::mutex lm_filter_stats_mutex;
+    LateMaterializationFilterStats lm_filter_stats;
 
     const DeltaValueSpacePtr delta;
     const StableValueSpacePtr stable;
@@ -14,6 +14,7 @@
 
 #include <Common/CurrentMetrics.h>
 #include <Common/TiFlashMetrics.h>
+#include <Flash/Mpp/ShmTransport.h>
 #include <IO/IOThreadPools.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
@@ -579,7 +580,20 @@ void SegmentReadTask::doFetchPages(const disaggregated::FetchDisaggPagesRequest
         extra_remote_info->store_address);
     grpc::ClientContext client_context;
     // set timeout for the streaming call to avoid inf wait before `Finish()`
-    rpc.setClientContext(client_context, dm_context->global_context.getSettingsRef().disagg_fetch_pages_timeout);
+    const auto & settings = dm_context->global_context.getSettingsRef();
+    rpc.setClientContext(client_context, settings.disagg_fetch_pages_timeout);
+    const bool nothing_to_fetch = request.page_ids_size() == 0 && !needFetchMemTableSet();
+    // Read from a shared memory ring buffer if the write node is on the same host.
+    ShmRingBufferPtr shm_ring;
+    if (settings.enable_shm_transport && !nothing_to_fetch
+        && ShmTransport::isSameHostPeer(extra_remote_info->store_address))
+    {
+        shm_ring = ShmTransport::tryRequest(client_context, read_snapshot->log);
+        // Same as the timeout of the gRPC call.
+        if (shm_ring != nullptr)
+            shm_ring->setDeadline(
+                std::chrono::steady_clock::now() + std::chrono::seconds(settings.disagg_fetch_pages_timeout));
+    }
     auto stream_resp = rpc.call(&client_context, request);
     RUNTIME_CHECK(stream_resp != nullptr);
     SCOPE_EXIT({
@@ -587,11 +601,14 @@ void SegmentReadTask::doFetchPages(const disaggregated::FetchDisaggPagesRequest
         // `Finish()` will be called here when exceptions thrown.
         if (unlikely(stream_resp != nullptr))
         {
+            // Stop the write node from writing into the ring buffer, otherwise `Finish()` may wait forever.
+            if (shm_ring != nullptr)
+                shm_ring->cancelRead();
             stream_resp->Finish();
         }
     });
 
-    if (request.page_ids_size() == 0 && !needFetchMemTableSet())
+    if (nothing_to_fetch)
     {
         // All delta data is cached in the compute node, just send a request to notify WN
         // to release the snapshot of current segment. The Compute node can safely ignore
@@ -600,9 +617,16 @@ void SegmentReadTask::doFetchPages(const disaggregated::FetchDisaggPagesRequest
         return;
     }
 
+    if (shm_ring != nullptr)
+    {
+        stream_resp->WaitForInitialMetadata();
+        if (!ShmTransport::isAccepted(client_context, *shm_ring))
+            shm_ring.reset();
+    }
+
     doFetchPagesImpl(
-        [&stream_resp, this](disaggregated::PagesPacket & packet) {
-            if (stream_resp->Read(&packet))
+        [&stream_resp, &shm_ring, this](disaggregated::PagesPacket & packet) {
+            if (shm_ring != nullptr ? ShmTransport::readMessage(*shm_ring, packet) : stream_resp->Read(&packet))
             {
                 return true;
             }
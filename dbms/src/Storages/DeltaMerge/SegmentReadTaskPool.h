@@ -147,6 +147,7 @@ public:
     Int64 getFreeBlockSlots() const;
     Int64 getFreeActiveSegments() const;
     Int64 getPendingSegmentCount() const;
+    Int64 getPendingBlockCount() const { return blk_stat.pendingCount(); }
     bool valid() const;
     void setException(const DB::Exception & e);
 
@@ -23,6 +23,27 @@
 
 namespace DB::DM
 {
+namespace
+{
+// Unset the rows marked as deleted in filter[start_row_id, start_row_id + deleteds.size()).
+// Only the rows not filtered out by the version and rowkey filters need to check the delete mark.
+UInt32 filterOutDeletedRows(const ColumnView<UInt8> & deleteds, UInt32 start_row_id, BitmapFilter & filter)
+{
+    UInt32 filtered_out_rows = 0;
+    filter.forEachSetRange(start_row_id, deleteds.size(), [&](size_t begin, size_t end) {
+        for (size_t row_id = begin; row_id < end; ++row_id)
+        {
+            if (deleteds[row_id - start_row_id])
+            {
+                filter[row_id] = 0;
+                ++filtered_out_rows;
+            }
+        }
+    });
+    return filtered_out_rows;
+}
+} // namespace
+
 UInt32 buildDeleteMarkFilterBlock(
     const DMContext & dm_context,
     const IColumnFileDataProviderPtr & data_provider,
@@ -46,16 +67,7 @@ UInt32 buildDeleteMarkFilterBlock(
         block.rows());
     addUserReadBytes(dm_context, block.bytes());
     const auto deleteds = ColumnView<UInt8>(*(block.begin()->column));
-    UInt32 filtered_out_rows = 0;
-    for (UInt32 i = 0; i < deleteds.size(); ++i)
-    {
-        if (filter[start_row_id + i] && deleteds[i])
-        {
-            filter[start_row_id + i] = 0;
-            ++filtered_out_rows;
-        }
-    }
-    return filtered_out_rows;
+    return filterOutDeletedRows(deleteds, start_row_id, filter);
 }
 
 UInt32 buildDeleteMarkFilterDMFile(
@@ -109,15 +121,7 @@ UInt32 buildDeleteMarkFilterDMFile(
         const auto deleteds = ColumnView<UInt8>(*(block.begin()->column));
         const auto itr = start_row_id_of_need_read_packs.find(pack_id);
         RUNTIME_CHECK(itr != start_row_id_of_need_read_packs.end(), start_row_id_of_need_read_packs, pack_id);
-        const UInt32 pack_start_row_id = itr->second;
-        for (UInt32 i = 0; i < deleteds.size(); ++i)
-        {
-            if (filter[pack_start_row_id + i] && deleteds[i])
-            {
-                filter[pack_start_row_id + i] = 0;
-                ++filtered_out_rows;
-            }
-        }
+        filtered_out_rows += filterOutDeletedRows(deleteds, itr->second, filter);
     }
     return filtered_out_rows;
 }
@@ -85,7 +85,10 @@ std::shared_ptr<const std::vector<RowID>> VersionChain<HandleType>::replaySnapsh
     }
 
     // base_versions may be shared for read, so copy for write here.
-    base_versions = std::make_shared<std::vector<RowID>>(*base_versions);
+    // If no reader holds it, the newly replayed records can be appended in place. It is safe to check
+    // `use_count` here because `base_versions` is only copied out under `mtx`.
+    if (base_versions.use_count() > 1)
+        base_versions = std::make_shared<std::vector<RowID>>(*base_versions);
     const auto cfs = delta.getColumnFiles();
     const auto & data_provider = delta.getDataProvider();
 
@@ -74,8 +74,16 @@ public:
     size_t getBytes() const;
 
 #ifdef DBMS_PUBLIC_GTEST
-    [[nodiscard]] auto getReplayedRows() const { return base_versions->size(); }
-    [[nodiscard]] auto deepCopy() const { return VersionChain(*this); }
+    [[nodiscard]] auto getReplayedRows() const
+    {
+        std::lock_guard lock(mtx);
+        return base_versions->size();
+    }
+    [[nodiscard]] auto deepCopy() const
+    {
+        std::lock_guard lock(mtx);
+        return VersionChain(*this);
+    }
 #endif
 
 private:
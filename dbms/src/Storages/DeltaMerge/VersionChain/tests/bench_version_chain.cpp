@@ -128,6 +128,7 @@ try
             RUNTIME_ASSERT(segment_snapshot->delta->getRows() == prepared_delta_rows + incremental_delta_rows);
             for (auto _ : state)
             {
+                // No reader holds the base versions of the copy, so the replayed versions are appended in place.
                 auto version_chain = base_version_chain.deepCopy();
                 RUNTIME_ASSERT(version_chain.getReplayedRows() == prepared_delta_rows);
                 buildVersionChain(*dm_context, *segment_snapshot, version_chain);
@@ -142,6 +143,44 @@ try
 }
 CATCH
 
+// Like `MVCCIncrementalBuild` with VersionChain, but a reader of the prepared snapshot holds the base versions,
+// so the replayed versions are appended to a copy instead of in place.
+template <typename... Args>
+void MVCCIncrementalBuildWithReader(benchmark::State & state, Args &&... args)
+try
+{
+    const auto [write_load, is_common_handle] = std::make_tuple(std::move(args)...);
+    const UInt32 prepared_delta_rows = state.range(0);
+    const UInt32 incremental_delta_rows = state.range(1);
+    auto [context, dm_context, cols, segment, prepared_snapshot, write_seq]
+        = initialize(write_load, is_common_handle, prepared_delta_rows);
+    SCOPE_EXIT({ context->shutdown(); });
+
+    auto bench_impl = [&](auto handle_type) {
+        VersionChain<decltype(handle_type)> base_version_chain;
+        buildVersionChain(*dm_context, *prepared_snapshot, base_version_chain);
+        RUNTIME_ASSERT(base_version_chain.getReplayedRows() == prepared_delta_rows);
+        writeDelta(*dm_context, is_common_handle, *segment, incremental_delta_rows, *write_seq);
+        auto segment_snapshot = segment->createSnapshot(*dm_context, false, CurrentMetrics::DT_SnapshotOfRead);
+        RUNTIME_ASSERT(segment_snapshot->delta->getRows() == prepared_delta_rows + incremental_delta_rows);
+        for (auto _ : state)
+        {
+            auto version_chain = base_version_chain.deepCopy();
+            // The prepared snapshot has been replayed, so it just returns the shared base versions.
+            auto reader_base_versions = buildVersionChain(*dm_context, *prepared_snapshot, version_chain);
+            RUNTIME_ASSERT(reader_base_versions->size() == prepared_delta_rows);
+            auto base_versions = buildVersionChain(*dm_context, *segment_snapshot, version_chain);
+            RUNTIME_ASSERT(base_versions != reader_base_versions);
+            RUNTIME_ASSERT(version_chain.getReplayedRows() == prepared_delta_rows + incremental_delta_rows);
+        }
+    };
+    if (is_common_handle)
+        bench_impl(String{});
+    else
+        bench_impl(Int64{});
+}
+CATCH
+
 template <typename... Args>
 void MVCCBuildBitmap(benchmark::State & state, Args &&... args)
 try
@@ -341,5 +380,11 @@ CATCH
 
 MVCC_BENCHMARK(MVCCFullBuild)
 MVCC_BENCHMARK2(MVCCIncrementalBuild)
+BENCHMARK_CAPTURE(MVCCIncrementalBuildWithReader, Chain / RandomUpdate, WriteLoad::RandomUpdate, NotCommonHandle)
+    ->ArgsProduct(
+        {benchmark::CreateDenseRange(10000, 50000, /*step*/ 10000), benchmark::CreateRange(1, 8 << 13, /*multi=*/8)});
+BENCHMARK_CAPTURE(MVCCIncrementalBuildWithReader, Chain / AppendOnly, WriteLoad::AppendOnly, NotCommonHandle)
+    ->ArgsProduct(
+        {benchmark::CreateDenseRange(10000, 50000, /*step*/ 10000), benchmark::CreateRange(1, 8 << 13, /*multi=*/8)});
 MVCC_BENCHMARK(MVCCBuildBitmap)
 } // namespace
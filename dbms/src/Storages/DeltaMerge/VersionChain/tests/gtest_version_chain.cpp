@@ -44,6 +44,14 @@ protected:
         ASSERT_EQ(opts.expected_base_versions, *actual_base_versions) << "caller_line=" << opts.caller_line;
     }
 
+    std::shared_ptr<const std::vector<RowID>> replayVersionChain()
+    {
+        auto [seg, snap] = getSegmentForRead(SEG_ID);
+        return std::visit(
+            [&](auto & version_chain) { return version_chain.replaySnapshot(*dm_context, *snap); },
+            *(seg->version_chain));
+    }
+
     void checkHandleIndex(size_t expected_new_handle_count, size_t expected_dmfile_or_delete_range_count)
     {
         auto [seg, snap] = getSegmentForRead(SEG_ID);
@@ -435,4 +443,46 @@ TEST_P(VersionChainTest, Big_NoIntersection_Tiny)
     });
     checkHandleIndex(20, 2); // 1 cf_big + 1 stable dmfile
 }
+TEST_P(VersionChainTest, AppendInPlace)
+try
+{
+    writeSegmentGeneric("d_mem:[0, 1000)");
+    const auto * base_versions_addr = replayVersionChain().get();
+
+    // No reader holds the base versions, so the new records are appended in place.
+    writeSegmentGeneric("d_mem:[100, 200)");
+    auto base_versions = replayVersionChain();
+    ASSERT_EQ(base_versions.get(), base_versions_addr);
+
+    std::vector<RowID> excepted_base_versions(1100);
+    std::fill(excepted_base_versions.begin(), excepted_base_versions.begin() + 1000, NotExistRowID); // d_mem:[0, 1000)
+    std::iota(excepted_base_versions.begin() + 1000, excepted_base_versions.end(), 100); // d_mem:[100, 200)
+    ASSERT_EQ(*base_versions, excepted_base_versions);
+}
+CATCH
+
+TEST_P(VersionChainTest, AppendWhenShared)
+try
+{
+    writeSegmentGeneric("d_mem:[0, 1000)");
+    // The reader of the older snapshot holds the base versions.
+    auto old_base_versions = replayVersionChain();
+    const std::vector<RowID> excepted_old_base_versions(1000, NotExistRowID);
+    ASSERT_EQ(*old_base_versions, excepted_old_base_versions);
+
+    // The new records are appended to a copy, the view of the reader is not changed.
+    writeSegmentGeneric("d_mem:[100, 200)");
+    auto base_versions = replayVersionChain();
+    ASSERT_NE(base_versions.get(), old_base_versions.get());
+    ASSERT_EQ(*old_base_versions, excepted_old_base_versions);
+
+    std::vector<RowID> excepted_base_versions(1100);
+    std::fill(excepted_base_versions.begin(), excepted_base_versions.begin() + 1000, NotExistRowID); // d_mem:[0, 1000)
+    std::iota(excepted_base_versions.begin() + 1000, excepted_base_versions.end(), 100); // d_mem:[100, 200)
+    ASSERT_EQ(*base_versions, excepted_base_versions);
+
+    // Replaying the snapshot that has been replayed returns the shared base versions.
+    ASSERT_EQ(replayVersionChain().get(), base_versions.get());
+}
+CATCH
 } // namespace DB::DM::tests
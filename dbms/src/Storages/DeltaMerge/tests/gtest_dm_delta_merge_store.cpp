@@ -939,6 +939,71 @@ try
 }
 CATCH
 
+TEST_P(DeltaMergeStoreRWTest, DataVersion)
+try
+{
+    // The data version is not maintained if the result cache is disabled when the store is created
+    ASSERT_FALSE(store->getDataVersion().tracked);
+    auto & global_context = db_context->getGlobalContext();
+    global_context.setMPPResultCache(1024 * 1024);
+    SCOPE_EXIT({ global_context.dropMPPResultCache(); });
+    store = reload();
+
+    // The rows restored from disk are of unknown versions until they are resolved.
+    auto last_version = store->getDataVersion();
+    ASSERT_TRUE(last_version.tracked);
+    ASSERT_NE(last_version.unresolved_seq, 0);
+    ASSERT_FALSE(last_version.changing);
+    store->resolveMaxWriteVersion(last_version.unresolved_seq, 1);
+    last_version = store->getDataVersion();
+    ASSERT_EQ(last_version.unresolved_seq, 0);
+    ASSERT_EQ(last_version.max_write_version, 1);
+
+    auto check_changed = [&](UInt64 expected_max_write_version, bool expected_unresolved) {
+        auto data_version = store->getDataVersion();
+        ASSERT_GT(data_version.version, last_version.version);
+        ASSERT_FALSE(data_version.changing);
+        ASSERT_EQ(data_version.max_write_version, expected_max_write_version);
+        ASSERT_EQ(data_version.unresolved_seq != 0, expected_unresolved);
+        last_version = data_version;
+    };
+
+    const UInt64 tso1 = 4;
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, 128, false, tso1);
+        store->write(*db_context, db_context->getSettingsRef(), block);
+        check_changed(tso1, false);
+    }
+
+    // Flush and merge delta do not change the rows
+    {
+        store->flushCache(*db_context, RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize()));
+        store->mergeDeltaAll(*db_context);
+        ASSERT_EQ(store->getDataVersion(), last_version);
+    }
+
+    {
+        store->deleteRange(*db_context, db_context->getSettingsRef(), RowKeyRange::fromHandleRange(HandleRange(0, 64)));
+        check_changed(tso1, false);
+    }
+
+    const UInt64 tso2 = 10;
+    {
+        auto dm_context = store->newDMContext(*db_context, db_context->getSettingsRef());
+        auto [range, file_ids] = genDMFile(*dm_context, DMTestEnv::prepareSimpleWriteBlock(64, 256, false, tso2));
+        store->ingestFiles(dm_context, range, file_ids, /*clear_data_in_range*/ true);
+        check_changed(tso1, true);
+
+        const UInt64 resolved_ts = 20;
+        store->resolveMaxWriteVersion(last_version.unresolved_seq, resolved_ts);
+        auto data_version = store->getDataVersion();
+        ASSERT_EQ(data_version.version, last_version.version);
+        ASSERT_EQ(data_version.unresolved_seq, 0);
+        ASSERT_EQ(data_version.max_write_version, resolved_ts);
+    }
+}
+CATCH
+
 TEST_P(DeltaMergeStoreRWTest, WriteMultipleBlock)
 try
 {
@@ -4480,4 +4545,126 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreTest, LMEagerReadBySelectivity)
+try
+{
+    auto table_column_defines = DMTestEnv::getDefaultColumns();
+    ColumnDefine cd_int(1, "col_int", std::make_shared<DataTypeInt64>());
+    ColumnDefine cd_other(2, "col_other", std::make_shared<DataTypeInt64>());
+    table_column_defines->push_back(cd_int);
+    table_column_defines->push_back(cd_other);
+
+    store = reload(table_column_defines);
+
+    // Keep the data in delta, so that the rough set filter returns Some and the pushed down filter is executed
+    FailPointHelper::enableFailPoint(FailPoints::pause_before_dt_background_delta_merge);
+    SCOPE_EXIT({ FailPointHelper::disableFailPoint(FailPoints::pause_before_dt_background_delta_merge); });
+
+    // Larger than the minimum rows to estimate the selectivity of a segment
+    constexpr size_t num_rows = DEFAULT_MERGE_BLOCK_SIZE * 2;
+    {
+        auto block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows, false, 1);
+        std::vector<Int64> data(num_rows);
+        std::iota(data.begin(), data.end(), 0);
+        block.insert(createColumn<Int64>(data, cd_int.name, cd_int.id));
+        std::vector<Int64> other_data(num_rows);
+        std::transform(data.begin(), data.end(), other_data.begin(), [](Int64 v) { return v * 10; });
+        block.insert(createColumn<Int64>(other_data, cd_other.name, cd_other.id));
+        block.checkNumberOfRows();
+        store->write(*db_context, db_context->getSettingsRef(), block);
+    }
+
+    const String table_info_json = R"json({
+    "cols":[
+        {"comment":"","default":null,"default_bit":null,"id":1,"name":{"L":"col_int","O":"col_int"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":1,"Flen":0,"Tp":8}},
+        {"comment":"","default":null,"default_bit":null,"id":2,"name":{"L":"col_other","O":"col_other"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":1,"Flen":0,"Tp":8}}
+    ],
+    "pk_is_handle":false,"index_info":[],"is_common_handle":false,
+    "name":{"L":"t_111","O":"t_111"},"partition":null,
+    "comment":"Mocked.","id":30,"schema_version":-1,"state":0,"tiflash_replica":{"Count":0},"update_timestamp":1636471547239654
+})json";
+
+    try
+    {
+        DB::registerFunctions();
+    }
+    catch (DB::Exception &)
+    {
+        // Maybe another test has already registered, ignore exception here.
+    }
+
+    auto create_filter = [&](size_t value) {
+        auto filter = generatePushDownExecutor(
+            *db_context,
+            table_info_json,
+            fmt::format("select * from default.t_111 where col_int >= {}", value));
+        RUNTIME_CHECK(filter->before_where != nullptr);
+        RUNTIME_CHECK(filter->extra_cast == nullptr);
+        return filter;
+    };
+
+    // Check the output is the rows of col_int >= `value`
+    auto read_and_check = [&](const PushDownExecutorPtr & executor, size_t value, const ScanContextPtr & scan_context) {
+        auto in = store->read(
+            *db_context,
+            db_context->getSettingsRef(),
+            store->getTableColumns(),
+            {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+            /* num_streams= */ 1,
+            /* start_ts= */ std::numeric_limits<UInt64>::max(),
+            executor,
+            std::vector<RuntimeFilterPtr>{},
+            0,
+            "",
+            DMReadOptions{},
+            /* expected_block_size= */ 1024,
+            /* read_segments */ {},
+            /* extra_table_id_index */ MutSup::invalid_col_id,
+            scan_context)[0];
+
+        std::vector<Int64> expected_data(num_rows - value);
+        std::iota(expected_data.begin(), expected_data.end(), static_cast<Int64>(value));
+        std::vector<Int64> expected_other_data(expected_data.size());
+        std::transform(expected_data.begin(), expected_data.end(), expected_other_data.begin(), [](Int64 v) {
+            return v * 10;
+        });
+        ASSERT_INPUTSTREAM_COLS_UR(
+            in,
+            Strings({cd_int.name, cd_other.name}),
+            createColumns({
+                createColumn<Int64>(expected_data),
+                createColumn<Int64>(expected_other_data),
+            }));
+    };
+
+    {
+        // All rows pass the filter. The first read uses late materialization and observes the selectivity of
+        // the segment, then the following read reads the segment eagerly with the same output.
+        auto filter_all = create_filter(0);
+        auto scan_context = std::make_shared<ScanContext>();
+        read_and_check(filter_all, 0, scan_context);
+        ASSERT_EQ(scan_context->lm_eager_read_segments.load(), 0);
+        ASSERT_EQ(scan_context->lm_filter_input_rows.load(), num_rows);
+        ASSERT_EQ(scan_context->lm_filter_passed_rows.load(), num_rows);
+
+        scan_context = std::make_shared<ScanContext>();
+        read_and_check(filter_all, 0, scan_context);
+        ASSERT_EQ(scan_context->lm_eager_read_segments.load(), 1);
+        ASSERT_EQ(scan_context->lm_filter_input_rows.load(), 0);
+    }
+    {
+        // Half of the rows pass another filter, it keeps using late materialization
+        auto filter_half = create_filter(num_rows / 2);
+        for (size_t i = 0; i < 2; ++i)
+        {
+            auto scan_context = std::make_shared<ScanContext>();
+            read_and_check(filter_half, num_rows / 2, scan_context);
+            ASSERT_EQ(scan_context->lm_eager_read_segments.load(), 0);
+            ASSERT_EQ(scan_context->lm_filter_input_rows.load(), num_rows);
+            ASSERT_EQ(scan_context->lm_filter_passed_rows.load(), num_rows / 2);
+        }
+    }
+}
+CATCH
+
 } // namespace DB::DM::tests
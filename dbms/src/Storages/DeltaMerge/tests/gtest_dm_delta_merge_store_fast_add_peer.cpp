@@ -376,6 +376,10 @@ try
     checkpoint_info->checkpoint_data_holder = buildParsedCheckpointData(*db_context, manifest_key, /*dir_seq*/ 100);
     checkpoint_info->temp_ps = checkpoint_info->checkpoint_data_holder->getUniversalPageStorage();
     resetStoreId(current_store_id);
+    // The data version is only maintained if the result cache is enabled when the store is created
+    auto & global_context = db_context->getGlobalContext();
+    global_context.setMPPResultCache(1024 * 1024);
+    SCOPE_EXIT({ global_context.dropMPPResultCache(); });
     {
         auto table_column_defines = DMTestEnv::getDefaultColumns();
 
@@ -390,6 +394,9 @@ try
         RowKeyRange::newAll(false, 1),
         checkpoint_info);
     RegionPtr dummy_region = RegionBench::makeRegionForTable(checkpoint_info->region_id, table_id, 0, 10, nullptr);
+    store->resolveMaxWriteVersion(store->getDataVersion().unresolved_seq, 1);
+    const auto version_before_ingest = store->getDataVersion();
+    ASSERT_EQ(version_before_ingest.unresolved_seq, 0);
     store->ingestSegmentsFromCheckpointInfo(
         *db_context,
         db_context->getSettingsRef(),
@@ -402,6 +409,13 @@ try
             dummy_region,
             std::move(segments),
             0));
+    // The ingested rows change the data version, and their versions are unknown
+    {
+        const auto version_after_ingest = store->getDataVersion();
+        ASSERT_GT(version_after_ingest.version, version_before_ingest.version);
+        ASSERT_FALSE(version_after_ingest.changing);
+        ASSERT_NE(version_after_ingest.unresolved_seq, 0);
+    }
 
     // check data file lock exists
     {
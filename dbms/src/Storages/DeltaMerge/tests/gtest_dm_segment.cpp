@@ -1979,6 +1979,33 @@ try
 }
 CATCH
 
+TEST_F(SegmentTest, StablePackRowsAdjustedByBytes)
+try
+{
+    const size_t num_rows_write = 300;
+    auto write_and_merge_delta = [&](size_t stable_pack_bytes) {
+        Settings settings = dmContext().global_context.getSettings();
+        settings.dt_segment_stable_pack_rows = 10;
+        settings.dt_segment_stable_pack_bytes = stable_pack_bytes;
+        segment = buildFirstSegment(DMTestEnv::getDefaultColumns(), std::move(settings));
+
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false);
+        segment->write(dmContext(), block);
+        segment = segment->mergeDelta(dmContext(), tableColumns());
+        const auto & stable = segment->getStable();
+        EXPECT_EQ(stable->getRows(), num_rows_write);
+        return stable->getDMFiles()[0]->getPacks();
+    };
+
+    // Disabled, the pack rows is `dt_segment_stable_pack_rows`
+    ASSERT_EQ(write_and_merge_delta(0), num_rows_write / 10);
+    // The rows are wide compared to the expected pack bytes, the pack rows is 1/4 of `dt_segment_stable_pack_rows`
+    ASSERT_EQ(write_and_merge_delta(1), num_rows_write / 2);
+    // The rows are narrow compared to the expected pack bytes, the pack rows is 4 times of `dt_segment_stable_pack_rows`
+    ASSERT_EQ(write_and_merge_delta(1024 * 1024), (num_rows_write + 39) / 40);
+}
+CATCH
+
 TEST_F(SegmentTest, CalculateDTFilePropertyWithPropertyFileDeleted)
 try
 {
@@ -155,6 +155,49 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreGCMergeTest, MergeWithPreviousSegments)
+try
+{
+    ensureSegmentBreakpoints({0, 10, 20, 30});
+    fill(20, 1000);
+    db_context->getGlobalContext().getSettingsRef().dt_segment_limit_rows = 100;
+
+    // The next segment is too large, merge with the previous empty segments
+    auto ctx = store->newDMContext(*db_context, db_context->getGlobalContext().getSettingsRef());
+    auto segments_to_merge = store->getMergeableSegments(ctx, getSegmentAt(20));
+    ASSERT_EQ(segments_to_merge.size(), 4);
+    ASSERT_EQ(segments_to_merge.front()->segmentId(), getSegmentAt(-100)->segmentId());
+    ASSERT_EQ(segments_to_merge.back()->segmentId(), getSegmentAt(20)->segmentId());
+
+    // The last segment can be merged with the previous segments
+    db_context->getGlobalContext().getSettingsRef().dt_segment_limit_rows = 10000;
+    ctx = store->newDMContext(*db_context, db_context->getGlobalContext().getSettingsRef());
+    segments_to_merge = store->getMergeableSegments(ctx, getSegmentAt(100));
+    ASSERT_EQ(segments_to_merge.size(), 5);
+
+    auto gc_n = store->onSyncGc(1, gc_options);
+    ASSERT_EQ(gc_n, 1);
+    ASSERT_EQ(std::vector<Int64>{}, getSegmentBreakpoints());
+    ASSERT_EQ(980, getRowsN());
+}
+CATCH
+
+TEST_F(DeltaMergeStoreGCMergeTest, MergeEmptySegment)
+try
+{
+    ensureSegmentBreakpoints({0, 10, 20});
+    fill(0, 10);
+
+    ASSERT_EQ(store->tryMergeEmptySegment(dm_context, getSegmentAt(0)), nullptr);
+    ASSERT_EQ(std::vector<Int64>({0, 10, 20}), getSegmentBreakpoints());
+
+    auto merged = store->tryMergeEmptySegment(dm_context, getSegmentAt(10));
+    ASSERT_NE(merged, nullptr);
+    ASSERT_EQ(std::vector<Int64>{}, getSegmentBreakpoints());
+    ASSERT_EQ(10, getRowsN());
+}
+CATCH
+
 TEST_F(DeltaMergeStoreGCMergeTest, S3ErrorReducesCapAndSuccessfulMergeRecoversIt)
 try
 {
@@ -529,6 +572,215 @@ try
 CATCH
 
 
+class DeltaMergeStoreBackgroundTaskTest : public DeltaMergeStoreGCTest
+{
+protected:
+    void addTask(
+        DeltaMergeStore::MergeDeltaTaskPool & pool,
+        DeltaMergeStore::TaskType type,
+        const SegmentPtr & segment)
+    {
+        auto [added, is_heavy] = pool.tryAddTask(
+            DeltaMergeStore::BackgroundTask{.type = type, .dm_context = dm_context, .segment = segment},
+            DeltaMergeStore::ThreadType::Write,
+            /*max_task_num*/ 100,
+            logger);
+        ASSERT_TRUE(added);
+        ASSERT_EQ(is_heavy, type == DeltaMergeStore::TaskType::MergeDelta || type == DeltaMergeStore::TaskType::Split);
+    }
+};
+
+TEST_F(DeltaMergeStoreBackgroundTaskTest, ReadHeatDecays)
+try
+{
+    auto segment = getSegmentAt(0);
+    const auto now = std::chrono::steady_clock::now();
+    const auto half_life = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<Float64>(Segment::READ_HEAT_HALF_LIFE_SECONDS));
+    ASSERT_DOUBLE_EQ(0, segment->getReadHeat(now));
+
+    for (size_t i = 0; i < 8; ++i)
+        segment->addReadHit(now);
+    ASSERT_DOUBLE_EQ(8, segment->getReadHeat(now));
+    ASSERT_DOUBLE_EQ(4, segment->getReadHeat(now + half_life));
+    ASSERT_DOUBLE_EQ(1, segment->getReadHeat(now + 3 * half_life));
+
+    // The new read is added on top of the decayed heat
+    segment->addReadHit(now + half_life);
+    ASSERT_DOUBLE_EQ(5, segment->getReadHeat(now + half_life));
+    ASSERT_DOUBLE_EQ(2.5, segment->getReadHeat(now + 2 * half_life));
+}
+CATCH
+
+TEST_F(DeltaMergeStoreBackgroundTaskTest, HeavyTasksByPriority)
+try
+{
+    ensureSegmentBreakpoints({0, 100, 200});
+    auto small_delta = getSegmentAt(0);
+    auto large_delta = getSegmentAt(100);
+    auto large_delta_and_read = getSegmentAt(200);
+    fill(0, 10);
+    fill(100, 150);
+    fill(200, 250);
+    for (size_t i = 0; i < 10; ++i)
+        large_delta_and_read->addReadHit();
+
+    DeltaMergeStore::MergeDeltaTaskPool pool;
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, small_delta);
+    addTask(pool, DeltaMergeStore::TaskType::Flush, small_delta);
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, large_delta);
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, large_delta_and_read);
+
+    // The stats shown by system.dt_background_tasks
+    {
+        auto stats = pool.getTasksStats();
+        ASSERT_EQ(stats.size(), 4);
+        // The light tasks come first
+        ASSERT_EQ(stats[0].type, "Flush");
+        ASSERT_FALSE(stats[0].is_heavy);
+        ASSERT_EQ(stats[0].segment_id, small_delta->segmentId());
+        for (size_t i = 1; i < stats.size(); ++i)
+        {
+            ASSERT_EQ(stats[i].type, "MergeDelta");
+            ASSERT_TRUE(stats[i].is_heavy);
+        }
+        ASSERT_EQ(stats[1].segment_id, small_delta->segmentId());
+        ASSERT_EQ(stats[3].segment_id, large_delta_and_read->segmentId());
+        ASSERT_LT(stats[1].priority, stats[2].priority);
+        ASSERT_LT(stats[2].priority, stats[3].priority);
+    }
+
+    ASSERT_EQ(pool.nextTask(true, logger).segment, large_delta_and_read);
+    // The priority is evaluated again when picking, so the segment written after its task is queued goes first.
+    // Clear the time of the last evaluation, otherwise it is evaluated at most once in a second.
+    fill(0, 100);
+    pool.heavy_tasks_rescore_time = {};
+    ASSERT_EQ(pool.nextTask(true, logger).segment, small_delta);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, large_delta);
+    ASSERT_FALSE(pool.nextTask(true, logger));
+
+    // The light tasks are FIFO
+    ASSERT_EQ(pool.nextTask(false, logger).segment, small_delta);
+    ASSERT_FALSE(pool.nextTask(false, logger));
+}
+CATCH
+
+TEST_F(DeltaMergeStoreBackgroundTaskTest, HeavyTasksRescoreInterval)
+try
+{
+    ensureSegmentBreakpoints({0, 100});
+    auto segment_1 = getSegmentAt(0);
+    auto segment_2 = getSegmentAt(100);
+    fill(0, 10);
+    fill(100, 150);
+
+    DeltaMergeStore::MergeDeltaTaskPool pool;
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, segment_1);
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, segment_2);
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, segment_2);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, segment_2);
+
+    // segment_1 becomes more urgent, but the priorities were just evaluated, so the old ones are used
+    fill(0, 100);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, segment_2);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, segment_1);
+}
+CATCH
+
+TEST_F(DeltaMergeStoreBackgroundTaskTest, HeavyTasksAging)
+try
+{
+    ensureSegmentBreakpoints({0, 100});
+    auto small_delta = getSegmentAt(0);
+    auto large_delta = getSegmentAt(100);
+    fill(0, 10);
+    fill(100, 150);
+
+    DeltaMergeStore::MergeDeltaTaskPool pool;
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, small_delta);
+    addTask(pool, DeltaMergeStore::TaskType::MergeDelta, large_delta);
+    ASSERT_EQ(pool.heavy_tasks.size(), 2);
+    const auto stats = pool.getTasksStats();
+    ASSERT_LT(stats[0].priority, stats[1].priority);
+
+    // The task of small_delta has been waiting for long enough to catch up with the priority gap
+    const auto gap = stats[1].priority - stats[0].priority;
+    pool.heavy_tasks.front().enqueue_time -= std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<Float64>((gap + 1) * 60));
+    auto aged_stats = pool.getTasksStats();
+    ASSERT_GT(aged_stats[0].priority, aged_stats[1].priority);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, small_delta);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, large_delta);
+}
+CATCH
+
+TEST_F(DeltaMergeStoreBackgroundTaskTest, SplitTaskPriority)
+try
+{
+    ensureSegmentBreakpoints({0, 100, 200});
+    fill(0, 100);
+    mergeDelta(0, 100);
+    fill(100, 110);
+    auto large_stable = getSegmentAt(0);
+    auto small_delta = getSegmentAt(100);
+
+    // The segment of large_stable is twice the segment size limit
+    auto settings = db_context->getSettings();
+    settings.dt_segment_limit_size = large_stable->getEstimatedBytes() / 2;
+    auto split_dm_context = store->newDMContext(*db_context, settings);
+
+    DeltaMergeStore::MergeDeltaTaskPool pool;
+    for (const auto & [type, segment] : {
+             std::make_pair(DeltaMergeStore::TaskType::MergeDelta, small_delta),
+             std::make_pair(DeltaMergeStore::TaskType::Split, large_stable),
+         })
+    {
+        auto [added, is_heavy] = pool.tryAddTask(
+            DeltaMergeStore::BackgroundTask{.type = type, .dm_context = split_dm_context, .segment = segment},
+            DeltaMergeStore::ThreadType::Write,
+            /*max_task_num*/ 100,
+            logger);
+        ASSERT_TRUE(added);
+        ASSERT_TRUE(is_heavy);
+    }
+
+    // A split is ranked by the size of the segment relative to the segment size limit. large_stable has no
+    // delta rows, which would rank it the lowest if it were ranked by the delta.
+    const auto stats = pool.getTasksStats();
+    ASSERT_EQ(stats.size(), 2);
+    ASSERT_EQ(stats[1].type, "Split");
+    ASSERT_NEAR(stats[1].priority, 2, 0.01);
+    // The read amplification of small_delta is 10, which is higher
+    ASSERT_EQ(pool.nextTask(true, logger).segment, small_delta);
+    ASSERT_EQ(pool.nextTask(true, logger).segment, large_stable);
+}
+CATCH
+
+TEST_F(DeltaMergeStoreBackgroundTaskTest, BackgroundTasksStats)
+try
+{
+    // Stop the background threads, so that the added tasks are kept in the pool
+    store->shutdown();
+
+    auto segment = getSegmentAt(0);
+    for (const auto type : {DeltaMergeStore::TaskType::Flush, DeltaMergeStore::TaskType::MergeDelta})
+        addTask(store->background_tasks, type, segment);
+
+    // The tasks shown by system.dt_background_tasks
+    const auto stats = store->getBackgroundTasksStats();
+    ASSERT_EQ(stats.size(), 2);
+    ASSERT_EQ(stats[0].type, "Flush");
+    ASSERT_FALSE(stats[0].is_heavy);
+    ASSERT_EQ(stats[0].segment_id, segment->segmentId());
+    ASSERT_EQ(stats[0].segment_epoch, segment->segmentEpoch());
+    ASSERT_DOUBLE_EQ(stats[0].priority, 0);
+    ASSERT_EQ(stats[1].type, "MergeDelta");
+    ASSERT_TRUE(stats[1].is_heavy);
+    ASSERT_EQ(stats[1].segment_id, segment->segmentId());
+}
+CATCH
+
+
 } // namespace tests
 } // namespace DM
 } // namespace DB
@@ -0,0 +1,133 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/UniThreadPool.h>
+#include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/StoragePool/StoragePool.h>
+#include <Storages/DeltaMerge/WriteBatchesImpl.h>
+#include <Storages/DeltaMerge/tests/gtest_dm_simple_pk_test_basic.h>
+
+namespace DB::DM::tests
+{
+class DeltaMergeStoreRestoreTest : public SimplePKTestBasic
+{
+protected:
+    // Restore the store from the data written by the former store, instead of dropping the data like `reload`.
+    void restore(ThreadPool * thread_pool)
+    {
+        dm_context.reset();
+        store.reset();
+
+        auto cols = DMTestEnv::getDefaultColumns(DMTestEnv::PkType::HiddenTiDBRowID);
+        store = DeltaMergeStore::create(
+            *db_context,
+            false,
+            "test",
+            DB::base::TiFlashStorageTestBasic::getCurrentFullTestName(),
+            NullspaceID,
+            101,
+            /*pk_col_id*/ 0,
+            true,
+            *cols,
+            (*cols)[0],
+            is_common_handle,
+            1,
+            nullptr,
+            DeltaMergeStore::Settings(),
+            thread_pool);
+        dm_context = store->newDMContext(
+            *db_context,
+            db_context->getSettingsRef(),
+            DB::base::TiFlashStorageTestBasic::getCurrentFullTestName());
+    }
+
+    std::vector<Int64> prepareSegments()
+    {
+        std::vector<Int64> breakpoints;
+        for (Int64 key = 0; key < 200; key += 10)
+            breakpoints.push_back(key);
+        fill(-100, 300);
+        flush();
+        ensureSegmentBreakpoints(breakpoints);
+        fill(50, 150);
+        return breakpoints;
+    }
+
+    void assertRestoreFailsAt(PageIdU64 segment_id)
+    {
+        try
+        {
+            restore(nullptr);
+            FAIL() << "restore should fail at segment_id=" << segment_id;
+        }
+        catch (DB::Exception & e)
+        {
+            ASSERT_NE(e.message().find(fmt::format("segment_id={}", segment_id)), std::string::npos) << e.message();
+        }
+    }
+};
+
+TEST_F(DeltaMergeStoreRestoreTest, ManySegments)
+try
+{
+    const auto breakpoints = prepareSegments();
+    ASSERT_EQ(breakpoints, getSegmentBreakpoints());
+    const auto rows = getRowsN();
+    ASSERT_EQ(rows, 400);
+
+    restore(nullptr);
+    ASSERT_EQ(breakpoints, getSegmentBreakpoints());
+    ASSERT_EQ(rows, getRowsN());
+    ASSERT_EQ(100, getRowsN(50, 150));
+
+    ThreadPool thread_pool(4);
+    restore(&thread_pool);
+    ASSERT_EQ(breakpoints, getSegmentBreakpoints());
+    ASSERT_EQ(rows, getRowsN());
+    ASSERT_EQ(100, getRowsN(50, 150));
+}
+CATCH
+
+TEST_F(DeltaMergeStoreRestoreTest, MissingSegmentMeta)
+try
+{
+    prepareSegments();
+    const auto segment_id = getSegmentAt(100)->segmentId();
+    {
+        WriteBatches wbs(*dm_context->storage_pool);
+        wbs.removed_meta.delPage(segment_id);
+        wbs.writeRemoves();
+    }
+
+    assertRestoreFailsAt(segment_id);
+}
+CATCH
+
+TEST_F(DeltaMergeStoreRestoreTest, CorruptSegmentMeta)
+try
+{
+    prepareSegments();
+    const auto segment_id = getSegmentAt(100)->segmentId();
+    {
+        WriteBatches wbs(*dm_context->storage_pool);
+        wbs.meta.putPage(segment_id, 0, std::string_view("corrupted"));
+        wbs.writeMeta();
+    }
+
+    assertRestoreFailsAt(segment_id);
+}
+CATCH
+
+} // namespace DB::DM::tests
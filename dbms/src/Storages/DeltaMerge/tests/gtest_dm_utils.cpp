@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/RowKeyFilter.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/tests/DMTestEnv.h>
@@ -94,4 +95,74 @@ TEST(RowKeyFilterTest, FilterUnsortedBlockCommonHandle)
     ASSERT_EQ(filtered_block.rows(), 70);
 }
 
+namespace
+{
+// Each block is a run, return the vstacked block and the end rows of the runs
+std::pair<Block, std::vector<size_t>> prepareRuns(
+    const std::vector<std::tuple<size_t, size_t, bool, UInt64>> & runs,
+    bool is_common_handle)
+{
+    Blocks blocks;
+    std::vector<size_t> run_ends;
+    size_t rows = 0;
+    for (const auto & [beg, end, reversed, tso] : runs)
+    {
+        blocks.push_back(DMTestEnv::prepareSimpleWriteBlock(
+            beg,
+            end,
+            reversed,
+            is_common_handle ? DMTestEnv::PkType::CommonHandle : DMTestEnv::PkType::HiddenTiDBRowID,
+            tso));
+        rows += blocks.back().rows();
+        run_ends.push_back(rows);
+    }
+    return {vstackBlocks(std::move(blocks)), std::move(run_ends)};
+}
+} // namespace
+
+TEST(SortBlockByPkTest, MergeSortedRuns)
+{
+    for (bool is_common_handle : {false, true})
+    {
+        // The runs are overlapped with each other and have duplicated <handle, version>
+        auto [block, run_ends] = prepareRuns(
+            {{0, 50, false, 2}, {20, 80, false, 3}, {10, 30, false, 2}, {90, 100, false, 2}},
+            is_common_handle);
+
+        const auto & handle = getExtraHandleColumnDefine(is_common_handle);
+        Block sorted_block = block;
+        IColumn::Permutation sorted_perm;
+        ASSERT_TRUE(sortBlockByPk(handle, sorted_block, sorted_perm));
+        Block merged_block = block;
+        IColumn::Permutation merged_perm;
+        ASSERT_TRUE(sortBlockByPk(handle, merged_block, run_ends, merged_perm));
+        ASSERT_EQ(sorted_perm, merged_perm);
+
+        // A single run or runs which are already in order do not need to be sorted
+        ASSERT_FALSE(sortBlockByPk(handle, sorted_block, {sorted_block.rows()}, merged_perm));
+        ASSERT_FALSE(sortBlockByPk(handle, sorted_block, {100, sorted_block.rows()}, merged_perm));
+    }
+}
+
+TEST(SortBlockByPkTest, UnsortedRuns)
+{
+    for (bool is_common_handle : {false, true})
+    {
+        // The second run is not sorted, fallback to sort the whole block
+        auto [block, run_ends] = prepareRuns(
+            {{0, 50, false, 2}, {20, 80, /*reversed*/ true, 3}, {10, 30, false, 2}},
+            is_common_handle);
+
+        const auto & handle = getExtraHandleColumnDefine(is_common_handle);
+        Block sorted_block = block;
+        IColumn::Permutation sorted_perm;
+        ASSERT_TRUE(sortBlockByPk(handle, sorted_block, sorted_perm));
+        Block merged_block = block;
+        IColumn::Permutation merged_perm;
+        ASSERT_TRUE(sortBlockByPk(handle, merged_block, run_ends, merged_perm));
+        ASSERT_EQ(sorted_perm, merged_perm);
+        ASSERT_TRUE(isAlreadySorted(merged_block, getPkSort(handle)));
+    }
+}
+
 } // namespace DB::DM::tests
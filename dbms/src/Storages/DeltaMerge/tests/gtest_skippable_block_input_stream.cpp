@@ -16,6 +16,7 @@
 #include <Common/Logger.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/LateMaterializationBlockInputStream.h>
+#include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/DeltaMerge/tests/gtest_segment_test_basic.h>
 #include <Storages/DeltaMerge/tests/gtest_segment_util.h>
 #include <TestUtils/FunctionTestUtils.h>
@@ -224,12 +225,15 @@ protected:
             size_t limit = e() % (total_rows - start);
             bitmap_filter->set(start, limit, false);
         }
+        auto scan_context = std::make_shared<ScanContext>();
         auto late_materialization_stream = std::make_shared<LateMaterializationBlockInputStream>(
             columns_to_read,
             default_filter_column_name,
             filter_cloumn_stream,
             rest_column_stream,
             bitmap_filter,
+            scan_context,
+            /*filter_stats_reporter*/ {},
             "test");
         late_materialization_stream->readPrefix();
         auto normal_stream = getInputStream(segment, snapshot, columns_to_read, read_ranges);
@@ -264,6 +268,11 @@ protected:
         }
         late_materialization_stream->readSuffix();
         normal_stream->readSuffix();
+
+        // The selectivity of the pushed down filter is recorded without the MVCC-bitmap
+        const auto & total_filter = filter_stream->total_filter;
+        ASSERT_EQ(scan_context->lm_filter_input_rows.load(), total_filter.size());
+        ASSERT_EQ(scan_context->lm_filter_passed_rows.load(), countBytesInFilter(total_filter));
     }
 
     void writeSegment(const SegDataUnit & unit)
@@ -154,7 +154,9 @@ TMTContext::TMTContext(
     , mpp_task_manager(std::make_shared<MPPTaskManager>(std::make_unique<MinTSOScheduler>(
           context.getSettingsRef().task_scheduler_thread_soft_limit,
           context.getSettingsRef().task_scheduler_thread_hard_limit,
-          context.getSettingsRef().task_scheduler_active_set_soft_limit)))
+          context.getSettingsRef().task_scheduler_active_set_soft_limit,
+          context.getSettingsRef().task_scheduler_memory_limit,
+          context.getSettingsRef().task_scheduler_memory_per_operator)))
     , cte_manager(std::make_unique<CTEManager>())
     , raftproxy_config(raft_config)
 {
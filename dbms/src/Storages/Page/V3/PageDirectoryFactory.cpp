@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/FailPoint.h>
+#include <Common/MPMCQueue.h>
+#include <Common/ThreadFactory.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory.h>
 #include <Storages/Page/V3/PageDirectoryFactory.h>
@@ -25,6 +28,7 @@
 
 #include <memory>
 #include <optional>
+#include <thread>
 
 namespace DB
 {
@@ -32,6 +36,11 @@ namespace ErrorCodes
 {
 extern const int PS_DIR_APPLY_INVALID_STATUS;
 } // namespace ErrorCodes
+namespace FailPoints
+{
+extern const char exception_when_decode_wal_edit[];
+extern const char exception_when_apply_wal_edit[];
+} // namespace FailPoints
 namespace PS::V3
 {
 template <typename Trait>
@@ -380,43 +389,88 @@ void PageDirectoryFactory<Trait>::updateMaxIdByRecord(
 template <typename Trait>
 void PageDirectoryFactory<Trait>::loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader)
 {
-    DataFileIdSet data_file_ids;
     auto checkpoint_snap_seq = reader->getSnapSeqForCheckpoint();
     // make sure the max sequence is larger or equal than the checkpoint sequence
     if (max_applied_ver.sequence < checkpoint_snap_seq)
         max_applied_ver = PageVersion(checkpoint_snap_seq, 0);
 
-    while (reader->remained())
+    // Reading and deserializing the records is the major cost of restoring, while applying the edits
+    // must be done in order. So a decode thread reads the log files and deserializes the records into
+    // edits, and the current thread applies the decoded edits in the same order as they are in the log files.
+    struct DecodedEdit
     {
-        auto [from_checkpoint, record] = reader->next();
-        if (!record)
+        bool from_checkpoint = false;
+        PageEntriesEdit edit;
+    };
+    MPMCQueue<DecodedEdit> decoded_edits(CapacityLimits(static_cast<Int64>(max_pending_decoded_edits)));
+    std::exception_ptr decode_exception;
+    // Propagate the memory tracker of the caller, so that the pending decoded edits are tracked.
+    auto decode_thread = ThreadFactory::newThread(true, "WALDecoder", [&] {
+        // Keep the same data file id set for all records, so the same data file id is shared by all entries.
+        DataFileIdSet data_file_ids;
+        try
         {
-            // TODO: Handle error, some error could be ignored.
-            // If the file happened to some error,
-            // should truncate it to throw away incomplete data.
-            reader->throwIfError();
-            // else it just run to the end of file.
-            break;
+            while (reader->remained())
+            {
+                auto [from_checkpoint, record] = reader->next();
+                if (!record)
+                {
+                    // TODO: Handle error, some error could be ignored.
+                    // If the file happened to some error,
+                    // should truncate it to throw away incomplete data.
+                    reader->throwIfError();
+                    // else it just run to the end of file.
+                    break;
+                }
+
+                FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_when_decode_wal_edit);
+                DecodedEdit decoded{.from_checkpoint = from_checkpoint};
+                if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
+                {
+                    decoded.edit = Trait::Serializer::deserializeFrom(record.value(), nullptr);
+                }
+                else if constexpr (std::is_same_v<Trait, universal::FactoryTrait>)
+                {
+                    decoded.edit = Trait::Serializer::deserializeFrom(record.value(), &data_file_ids);
+                }
+                else
+                {
+                    RUNTIME_CHECK(false);
+                }
+                // The queue is cancelled when applying fails, stop decoding
+                if (decoded_edits.push(std::move(decoded)) != MPMCQueueResult::OK)
+                    break;
+            }
+        }
+        catch (...)
+        {
+            decode_exception = std::current_exception();
         }
+        decoded_edits.finish();
+    });
 
+    try
+    {
         // The edits in later log files may have some overlap with the first checkpoint file.
         // But we want to just apply each edit exactly once.
         // So we will skip edits in later log files if they are already applied.
-        if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
+        DecodedEdit decoded;
+        while (decoded_edits.pop(decoded) == MPMCQueueResult::OK)
         {
-            auto edit = Trait::Serializer::deserializeFrom(record.value(), nullptr);
-            loadEdit(dir, edit, from_checkpoint, checkpoint_snap_seq);
-        }
-        else if constexpr (std::is_same_v<Trait, universal::FactoryTrait>)
-        {
-            auto edit = Trait::Serializer::deserializeFrom(record.value(), &data_file_ids);
-            loadEdit(dir, edit, from_checkpoint, checkpoint_snap_seq);
-        }
-        else
-        {
-            RUNTIME_CHECK(false);
+            FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_when_apply_wal_edit);
+            loadEdit(dir, decoded.edit, decoded.from_checkpoint, checkpoint_snap_seq);
         }
     }
+    catch (...)
+    {
+        decoded_edits.cancel();
+        decode_thread.join();
+        throw;
+    }
+    decode_thread.join();
+    // The edits decoded before the error have been applied, same as reading the log files one by one
+    if (decode_exception)
+        std::rethrow_exception(decode_exception);
 }
 
 template class PageDirectoryFactory<u128::FactoryTrait>;
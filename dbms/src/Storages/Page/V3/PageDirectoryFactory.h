@@ -77,6 +77,13 @@ public:
         return *this;
     }
 
+    // The max number of decoded edits that are waiting to be applied while restoring from disk
+    PageDirectoryFactory<Trait> & setMaxPendingDecodedEdits(size_t max_pending_decoded_edits_)
+    {
+        max_pending_decoded_edits = max_pending_decoded_edits_;
+        return *this;
+    }
+
 private:
     void loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader);
     void loadEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit, bool force_apply, UInt64 filter_seq = 0);
@@ -90,6 +97,8 @@ private:
 
     BlobStats * blob_stats = nullptr;
 
+    size_t max_pending_decoded_edits = 64;
+
     // For debug tool
     template <typename T>
     friend class PageStorageControlV3;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/FailPoint.h>
 #include <Common/FmtUtils.h>
 #include <Common/SyncPoint/Ctl.h>
 #include <Debug/TiFlashTestEnv.h>
@@ -47,6 +48,12 @@
 #include <unordered_map>
 #include <unordered_set>
 
+namespace DB::FailPoints
+{
+extern const char exception_when_decode_wal_edit[];
+extern const char exception_when_apply_wal_edit[];
+} // namespace DB::FailPoints
+
 namespace DB::PS::V3::tests
 {
 using u128::PageEntriesEdit;
@@ -1401,6 +1408,52 @@ try
 }
 CATCH
 
+TEST_F(PageDirectoryTest, RestoreWithDecodeOrApplyError)
+try
+{
+    constexpr PageIdU64 num_pages = 10;
+    for (PageIdU64 page_id = 1; page_id <= num_pages; ++page_id)
+    {
+        PageEntriesEdit edit;
+        edit.put(
+            buildV3Id(TEST_NAMESPACE_ID, page_id),
+            PageEntryV3{.file_id = 1, .size = 1024, .offset = page_id * 1024});
+        dir->apply(std::move(edit));
+    }
+    dir.reset();
+
+    auto restore = [] {
+        auto provider = DB::tests::TiFlashTestEnv::getDefaultFileProvider();
+        PSDiskDelegatorPtr delegator = std::make_shared<DB::tests::MockDiskDelegatorSingle>(getTemporaryPath());
+        PageDirectoryFactory<u128::FactoryTrait> factory;
+        // The decode thread is blocked on the full queue most of the time, so the error paths must wake it up
+        return factory.setMaxPendingDecodedEdits(1).create("PageDirectoryTest", provider, delegator, WALConfig());
+    };
+
+    for (const char * fail_point :
+         {FailPoints::exception_when_decode_wal_edit, FailPoints::exception_when_apply_wal_edit})
+    {
+        FailPointHelper::enableFailPoint(fail_point);
+        try
+        {
+            restore();
+            FAIL() << "restore should fail by " << fail_point;
+        }
+        catch (DB::Exception & e)
+        {
+            ASSERT_NE(e.message().find(fail_point), std::string::npos) << e.message();
+        }
+        FailPointHelper::disableFailPoint(fail_point);
+    }
+
+    // The failed restores do not break the WAL
+    dir = restore();
+    auto snap = dir->createSnapshot();
+    for (PageIdU64 page_id = 1; page_id <= num_pages; ++page_id)
+        ASSERT_EQ(getEntry(dir, page_id, snap).offset, page_id * 1024);
+}
+CATCH
+
 class PageDirectoryGCTest : public PageDirectoryTest
 {
 };
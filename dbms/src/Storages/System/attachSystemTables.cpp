@@ -18,6 +18,7 @@
 #include <Storages/System/StorageSystemAsynchronousMetrics.h>
 #include <Storages/System/StorageSystemBuildOptions.h>
 #include <Storages/System/StorageSystemColumns.h>
+#include <Storages/System/StorageSystemDTBackgroundTasks.h>
 #include <Storages/System/StorageSystemDTLocalIndexes.h>
 #include <Storages/System/StorageSystemDTSegments.h>
 #include <Storages/System/StorageSystemDTTables.h>
@@ -44,6 +45,9 @@ void attachSystemTablesLocal(IDatabase & system_database)
     system_database.attachTable("dt_tables", StorageSystemDTTables::create("dt_tables"));
     system_database.attachTable("dt_segments", StorageSystemDTSegments::create("dt_segments"));
     system_database.attachTable("dt_local_indexes", StorageSystemDTLocalIndexes::create("dt_local_indexes"));
+    system_database.attachTable(
+        "dt_background_tasks",
+        StorageSystemDTBackgroundTasks::create("dt_background_tasks"));
     system_database.attachTable("tables", StorageSystemTables::create("tables"));
     system_database.attachTable("columns", StorageSystemColumns::create("columns"));
     system_database.attachTable("functions", StorageSystemFunctions::create("functions"));
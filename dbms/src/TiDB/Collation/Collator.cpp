@@ -457,6 +457,21 @@ StringRef GeneralCICollator::convertImpl(
         lens->resize(0);
     }
 
+    // Fast path for pure ASCII strings, every byte is a char and there is no need to decode utf8.
+    if constexpr (!need_len)
+    {
+        if (DB::UTF8::isASCII(reinterpret_cast<const UInt8 *>(s), v_length))
+        {
+            for (; offset < v_length; ++offset)
+            {
+                auto sk = weight(static_cast<UInt8>(s[offset]));
+                container[total_size++] = static_cast<char>(sk >> 8);
+                container[total_size++] = static_cast<char>(sk);
+            }
+            return StringRef(container.data(), total_size);
+        }
+    }
+
     while (offset < v_length)
     {
         auto c = decodeChar(s, offset);